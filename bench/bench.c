@@ -0,0 +1,637 @@
+// SPDX-License-Identifier: MIT
+/*
+ * Semy - a Semantic Versioning 2.0.0 processor.
+ * See https://semver.org/.
+ *
+ * Copyright (c) 2025-2026 Henry G. Stratmann III
+ * Copyright (c) 2025-2026 Semy Contributors
+ *
+ * This file is part of Semy, distributed under the MIT License.
+ * For full terms see the included LICENSE file.
+ */
+
+// The command-line interface is included, as it is by its unit tests, so its
+// commands are timed in-process without the cost of starting a process.
+#define UNIT_TESTING
+#define BENCHMARKING
+#if defined(__linux__)
+#define _GNU_SOURCE // For syscall().
+#endif
+#include "../semy-cli.c"
+#include "bench_utils.h"
+#include <assert.h>
+#include <time.h>
+
+#if defined(__linux__)
+#define HAVE_PERF_EVENTS
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#endif
+
+#if !defined(HAVE_POSIX_IO)
+#error "The benchmarks require POSIX I/O."
+#endif
+
+#define DEFAULT_COUNT 100000
+#define DEFAULT_SECONDS 0.25
+#define MAX_GENERATED_LENGTH 199 // One less than the longest version 'semy_t' accepts.
+#define MAX_PARSED 65536         // The most versions kept parsed for comparing, bounding memory for large inputs.
+
+struct dataset
+{
+    char *text;      // Storage for the versions.
+    char **versions; // The versions, null terminated, as given to the library.
+    size_t count;
+    size_t bytes;    // The length of all versions excluding terminators.
+    char path[64];   // The file holding 'text'.
+};
+
+struct workload
+{
+    const char *name;
+    size_t (*generate)(uint64_t *state, char *version);
+};
+
+struct operation
+{
+    const char *name;
+    size_t (*run)(const struct dataset *dataset, const semy_t *parsed); // Returns the number of operations run.
+    size_t versions_per_op; // The number of versions read by each operation.
+};
+
+// Hardware events counted in user space while an operation runs.
+struct counter
+{
+    const char *name;
+    uint32_t type;
+    uint64_t config;
+    int fd; // Negative if the event couldn't be opened.
+    uint64_t value;
+};
+
+static volatile int32_t sink;
+static int null_fd = -1;
+static size_t parsed_count; // The number of versions in 'parsed'.
+
+#if defined(HAVE_PERF_EVENTS)
+#define CACHE_READ_MISS(cache) ((cache) | (PERF_COUNT_HW_CACHE_OP_READ << 8) | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16))
+
+static struct counter counters[] = {
+    {"cycles", PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES, -1, 0},
+    {"instructions", PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS, -1, 0},
+    {"branch_misses", PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES, -1, 0},
+    {"l1d_misses", PERF_TYPE_HW_CACHE, CACHE_READ_MISS(PERF_COUNT_HW_CACHE_L1D), -1, 0},
+    {"llc_misses", PERF_TYPE_HW_CACHE, CACHE_READ_MISS(PERF_COUNT_HW_CACHE_LL), -1, 0},
+};
+
+// Opens each counter on its own, rather than as a group, so one the processor or container
+// doesn't permit doesn't prevent the others. Returns false if none could be opened.
+static bool counters_open(void)
+{
+    bool opened = false;
+    for (size_t i = 0; i < COUNT_OF(counters); i++)
+    {
+        struct perf_event_attr attr;
+        memset(&attr, 0, sizeof(attr));
+        attr.size = sizeof(attr);
+        attr.type = counters[i].type;
+        attr.config = counters[i].config;
+        attr.disabled = 1;
+        attr.exclude_kernel = 1;
+        attr.exclude_hv = 1;
+        attr.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+        counters[i].fd = (int)syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0);
+        opened = opened || (counters[i].fd >= 0);
+    }
+    return opened;
+}
+
+static void counters_start(void)
+{
+    for (size_t i = 0; i < COUNT_OF(counters); i++)
+    {
+        if (counters[i].fd >= 0)
+        {
+            ioctl(counters[i].fd, PERF_EVENT_IOC_RESET, 0);
+            ioctl(counters[i].fd, PERF_EVENT_IOC_ENABLE, 0);
+        }
+    }
+}
+
+static void counters_stop(void)
+{
+    for (size_t i = 0; i < COUNT_OF(counters); i++)
+    {
+        if (counters[i].fd >= 0)
+        {
+            ioctl(counters[i].fd, PERF_EVENT_IOC_DISABLE, 0);
+
+            // Scale the count up if the kernel multiplexed the counter with others.
+            uint64_t data[3] = {0}; // The value, time enabled, and time running.
+            counters[i].value = 0;
+            if (read(counters[i].fd, data, sizeof(data)) == (ssize_t)sizeof(data) && data[2] > 0)
+            {
+                counters[i].value = (uint64_t)((double)data[0] * ((double)data[1] / (double)data[2]));
+            }
+        }
+    }
+}
+#else
+static struct counter counters[] = {
+    {"cycles", 0, 0, -1, 0},
+    {"instructions", 0, 0, -1, 0},
+    {"branch_misses", 0, 0, -1, 0},
+    {"l1d_misses", 0, 0, -1, 0},
+    {"llc_misses", 0, 0, -1, 0},
+};
+
+static bool counters_open(void)
+{
+    return false;
+}
+
+static void counters_start(void)
+{
+}
+
+static void counters_stop(void)
+{
+}
+#endif
+
+static bool counters_enabled;
+
+static size_t generate_core(uint64_t *state, char *version)
+{
+    return (size_t)sprintf(version, "%u.%u.%u", uniform(state, 20), uniform(state, 100), uniform(state, 1000));
+}
+
+static size_t generate_identifier(uint64_t *state, char *version, size_t length)
+{
+    static const char *const words[] = {"alpha", "beta", "rc", "dev", "snapshot", "preview", "nightly", "x-y-z"};
+    if (uniform(state, 3) == 0)
+    {
+        return length + (size_t)sprintf(&version[length], "%u", uniform(state, 1000));
+    }
+    return length + (size_t)sprintf(&version[length], "%s", words[uniform(state, COUNT_OF(words))]);
+}
+
+static size_t generate_pre_release(uint64_t *state, char *version)
+{
+    size_t length = generate_core(state, version);
+    const uint32_t count = 1 + uniform(state, 6);
+    for (uint32_t i = 0; i < count; i++)
+    {
+        version[length++] = (i == 0) ? '-' : '.';
+        length = generate_identifier(state, version, length);
+    }
+    return length;
+}
+
+static size_t generate_build(uint64_t *state, char *version)
+{
+    size_t length = generate_core(state, version);
+    if (uniform(state, 4) == 0)
+    {
+        length += (size_t)sprintf(&version[length], "-rc.%u", uniform(state, 10));
+    }
+
+    length += (size_t)sprintf(&version[length], "+exp.sha.");
+    for (int i = 0; i < 40; i++)
+    {
+        version[length++] = "0123456789abcdef"[uniform(state, 16)];
+    }
+    length += (size_t)sprintf(&version[length], ".%u%010u.ci-%u", 2020 + uniform(state, 7), uniform(state, 1000000000), uniform(state, 100000));
+    return length;
+}
+
+// Generates versions within a few characters and identifiers of the limits of 'semy_t'.
+static size_t generate_near_limit(uint64_t *state, char *version)
+{
+    size_t length = generate_core(state, version);
+    const size_t target = MAX_GENERATED_LENGTH - uniform(state, 8);
+    for (int i = 0; i < 24 && length < target - 20; i++)
+    {
+        version[length++] = (i == 0) ? '-' : '.';
+        length = generate_identifier(state, version, length);
+    }
+
+    // Pad with build metadata up to the target length.
+    version[length++] = '+';
+    while (length < target)
+    {
+        version[length++] = "0123456789abcdefghijklmnopqrstuvwxyz"[uniform(state, 36)];
+    }
+    version[length] = '\0';
+    return length;
+}
+
+static const struct workload workloads[] = {
+    {"core", generate_core},
+    {"pre-release", generate_pre_release},
+    {"build-metadata", generate_build},
+    {"near-limit", generate_near_limit},
+};
+
+static void dataset_free(struct dataset *dataset)
+{
+    if (dataset->path[0] != '\0')
+    {
+        remove(dataset->path);
+    }
+    free(dataset->text);
+    free(dataset->versions);
+}
+
+// Writes the versions one per line to a temporary file for the command-line interface to read.
+static bool dataset_write(struct dataset *dataset)
+{
+    const char *directory = getenv("TMPDIR");
+    snprintf(dataset->path, sizeof(dataset->path), "%s/semy-bench-XXXXXX", (directory != NULL) ? directory : "/tmp");
+    const int fd = mkstemp(dataset->path);
+    if (fd < 0)
+    {
+        dataset->path[0] = '\0';
+        dataset_free(dataset);
+        return false;
+    }
+
+    FILE *file = fdopen(fd, "wb");
+    bool written = (file != NULL);
+    for (size_t i = 0; written && i < dataset->count; i++)
+    {
+        written = fprintf(file, "%s\n", dataset->versions[i]) > 0;
+    }
+
+    if (file == NULL || fclose(file) != 0 || !written)
+    {
+        dataset_free(dataset);
+        return false;
+    }
+    return true;
+}
+
+// Generates 'count' versions of a workload, always the same ones for the same workload.
+static bool dataset_init(struct dataset *dataset, const struct workload *workload, size_t count)
+{
+    memset(dataset, 0, sizeof(dataset[0]));
+    dataset->text = malloc(count * (MAX_GENERATED_LENGTH + 1));
+    dataset->versions = malloc(count * sizeof(dataset->versions[0]));
+    if (dataset->text == NULL || dataset->versions == NULL)
+    {
+        dataset_free(dataset);
+        return false;
+    }
+
+    uint64_t state = UINT64_C(0x9E3779B97F4A7C15) ^ (uint64_t)(workload - workloads);
+    char *cursor = dataset->text;
+    for (size_t i = 0; i < count; i++)
+    {
+        const size_t length = workload->generate(&state, cursor);
+        assert(length <= MAX_GENERATED_LENGTH);
+        dataset->versions[i] = cursor;
+        dataset->bytes += length;
+        cursor += length + 1;
+    }
+    dataset->count = count;
+    return dataset_write(dataset);
+}
+
+// Reads the versions of a file, one per line, such as those written by 'semy_generate'.
+// Lines that aren't valid versions are skipped so invalid inputs can be mixed in freely.
+static bool dataset_load(struct dataset *dataset, const char *path, size_t *skipped)
+{
+    memset(dataset, 0, sizeof(dataset[0]));
+    FILE *file = fopen(path, "rb");
+    if (file == NULL)
+    {
+        return false;
+    }
+
+    size_t capacity = 0;
+    size_t length = 0;
+    size_t lines = 0;
+    for (;;)
+    {
+        if (length == capacity)
+        {
+            capacity = (capacity == 0) ? 65536 : capacity * 2;
+            char *text = realloc(dataset->text, capacity + 1);
+            if (text == NULL)
+            {
+                fclose(file);
+                dataset_free(dataset);
+                return false;
+            }
+            dataset->text = text;
+        }
+
+        const size_t read = fread(&dataset->text[length], 1, capacity - length, file);
+        if (read == 0)
+        {
+            break;
+        }
+
+        for (size_t i = length; i < length + read; i++)
+        {
+            lines += (dataset->text[i] == '\n');
+        }
+        length += read;
+    }
+
+    const bool failed = (ferror(file) != 0);
+    fclose(file);
+    dataset->versions = malloc((lines + 1) * sizeof(dataset->versions[0]));
+    if (failed || dataset->versions == NULL)
+    {
+        dataset_free(dataset);
+        return false;
+    }
+
+    // Terminate each line in place and keep those that parse.
+    dataset->text[length] = '\n';
+    *skipped = 0;
+    for (char *line = dataset->text; line < &dataset->text[length]; )
+    {
+        char *end = memchr(line, '\n', (size_t)(&dataset->text[length] - line) + 1);
+        *end = '\0';
+
+        semy_t semver;
+        if (semy_parse(&semver, sizeof(semver), line) == SEMY_NO_ERROR)
+        {
+            dataset->versions[dataset->count++] = line;
+            dataset->bytes += (size_t)(end - line);
+        }
+        else
+        {
+            *skipped += 1;
+        }
+        line = end + 1;
+    }
+    return dataset_write(dataset);
+}
+
+static size_t run_parse(const struct dataset *dataset, const semy_t *parsed)
+{
+    (void)parsed;
+    for (size_t i = 0; i < dataset->count; i++)
+    {
+        semy_t semver;
+        semy_parse(&semver, sizeof(semver), dataset->versions[i]);
+        sink += semy_get_patch(&semver);
+    }
+    return dataset->count;
+}
+
+// Compares neighboring versions among the first 'MAX_PARSED' of the dataset.
+static size_t run_compare(const struct dataset *dataset, const semy_t *parsed)
+{
+    (void)dataset;
+    for (size_t i = 0; i < parsed_count; i++)
+    {
+        int32_t result = 0;
+        semy_compare(&parsed[i], &parsed[(i + 1) % parsed_count], &result);
+        sink += result;
+    }
+    return parsed_count;
+}
+
+// Runs a command of the command-line interface with its output discarded.
+static void run_command_discarded(const struct dataset *dataset, const char *option)
+{
+    char *argv[] = {"semy", (char *)option, "-f", (char *)dataset->path, NULL};
+    output.fd = null_fd;
+    output.length = 0;
+    output.failed = false;
+    if (run_command(COUNT_OF(argv) - 1, argv) != EXIT_SUCCESS || !output_flush())
+    {
+        fprintf(stderr, "error: 'semy %s' failed\n", option);
+        exit(EXIT_FAILURE);
+    }
+}
+
+static size_t run_validate(const struct dataset *dataset, const semy_t *parsed)
+{
+    (void)parsed;
+    run_command_discarded(dataset, "-v");
+    return dataset->count;
+}
+
+static size_t run_sort(const struct dataset *dataset, const semy_t *parsed)
+{
+    (void)parsed;
+    run_command_discarded(dataset, "-s");
+    return dataset->count;
+}
+
+static const struct operation operations[] = {
+    {"parse", run_parse, 1},
+    {"validate", run_validate, 1},
+    {"compare", run_compare, 2},
+    {"sort", run_sort, 1},
+};
+
+static double now(void)
+{
+    struct timespec ts;
+    timespec_get(&ts, TIME_UTC);
+    return (double)ts.tv_sec + ((double)ts.tv_nsec * 1e-9);
+}
+
+// Runs the operation over the dataset until at least 'seconds' have elapsed and
+// reports its throughput per version.
+static void measure(const char *workload, const struct operation *operation,
+                    const struct dataset *dataset, const semy_t *parsed, double seconds, bool first)
+{
+    double operations_run = 0.0;
+    double elapsed = 0.0;
+    operation->run(dataset, parsed); // Warm up.
+
+    if (counters_enabled)
+    {
+        counters_start();
+    }
+
+    const double start = now();
+    do
+    {
+        operations_run += (double)operation->run(dataset, parsed);
+        elapsed = now() - start;
+    } while (elapsed < seconds);
+
+    if (counters_enabled)
+    {
+        counters_stop();
+    }
+
+    // Bytes are estimated from the average version length since comparisons don't visit every version.
+    const double bytes = ((double)dataset->bytes / (double)dataset->count) * operations_run * (double)operation->versions_per_op;
+    printf("%s\n    {\"workload\": \"%s\", \"operation\": \"%s\", \"operations\": %.0f, \"ns_per_op\": %.2f, \"mb_per_s\": %.2f",
+           first ? "" : ",", workload, operation->name, operations_run,
+           (elapsed * 1e9) / operations_run, (bytes / (1024.0 * 1024.0)) / elapsed);
+
+    // Counters are reported per operation; those that couldn't be opened are null.
+    if (counters_enabled)
+    {
+        printf(", \"counters\": {");
+        for (size_t i = 0; i < COUNT_OF(counters); i++)
+        {
+            printf("%s\"%s\": ", (i == 0) ? "" : ", ", counters[i].name);
+            if (counters[i].fd >= 0)
+            {
+                printf("%.2f", (double)counters[i].value / operations_run);
+            }
+            else
+            {
+                printf("null");
+            }
+        }
+        printf("}");
+    }
+    printf("}");
+}
+
+static void print_bench_usage(void)
+{
+    fprintf(stderr, "usage: semy_bench [--count <versions>] [--seconds <minimum>] [--counters] [--input <file>]\n");
+}
+
+// Parses up to 'MAX_PARSED' versions of the dataset for the operations that take parsed versions.
+static bool parse_dataset(const struct dataset *dataset, semy_t *parsed)
+{
+    parsed_count = (dataset->count < MAX_PARSED) ? dataset->count : MAX_PARSED;
+    for (size_t i = 0; i < parsed_count; i++)
+    {
+        if (semy_parse(&parsed[i], sizeof(parsed[i]), dataset->versions[i]) != SEMY_NO_ERROR)
+        {
+            fprintf(stderr, "error: generated an invalid version '%s'\n", dataset->versions[i]);
+            return false;
+        }
+    }
+    return true;
+}
+
+static void run_operations(const char *workload, const struct dataset *dataset, const semy_t *parsed, double seconds, bool *first)
+{
+    for (size_t o = 0; o < COUNT_OF(operations); o++)
+    {
+        measure(workload, &operations[o], dataset, parsed, seconds, *first);
+        *first = false;
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    size_t count = DEFAULT_COUNT;
+    double seconds = DEFAULT_SECONDS;
+    const char *input = NULL;
+    for (int i = 1; i < argc; i++)
+    {
+        if (strcmp(argv[i], "--count") == 0 && i + 1 < argc)
+        {
+            count = strtoul(argv[++i], NULL, 10);
+        }
+        else if (strcmp(argv[i], "--seconds") == 0 && i + 1 < argc)
+        {
+            seconds = strtod(argv[++i], NULL);
+        }
+        else if (strcmp(argv[i], "--counters") == 0)
+        {
+            counters_enabled = true;
+        }
+        else if (strcmp(argv[i], "--input") == 0 && i + 1 < argc)
+        {
+            input = argv[++i];
+        }
+        else
+        {
+            print_bench_usage();
+            return EXIT_INVALID_OPTION;
+        }
+    }
+
+    if (count == 0)
+    {
+        print_bench_usage();
+        return EXIT_INVALID_OPTION;
+    }
+
+    // Containers commonly forbid hardware counters, so their absence isn't an error.
+    if (counters_enabled && !counters_open())
+    {
+        fprintf(stderr, "warning: hardware performance counters are unavailable\n");
+    }
+
+    // An input file replaces the built-in workloads.
+    struct dataset dataset;
+    if (input != NULL)
+    {
+        size_t skipped = 0;
+        if (!dataset_load(&dataset, input, &skipped))
+        {
+            fprintf(stderr, "error: failed to read '%s'\n", input);
+            return EXIT_GENERAL_ERROR;
+        }
+
+        if (dataset.count == 0)
+        {
+            fprintf(stderr, "error: '%s' has no valid versions\n", input);
+            return EXIT_GENERAL_ERROR;
+        }
+
+        if (skipped > 0)
+        {
+            fprintf(stderr, "warning: skipped %zu invalid versions\n", skipped);
+        }
+        count = dataset.count;
+    }
+
+    null_fd = open("/dev/null", O_WRONLY);
+    semy_t *parsed = malloc(((count < MAX_PARSED) ? count : MAX_PARSED) * sizeof(parsed[0]));
+    if (null_fd < 0 || parsed == NULL)
+    {
+        fprintf(stderr, "error: failed to allocate the benchmark\n");
+        return EXIT_GENERAL_ERROR;
+    }
+
+    printf("{\n  \"version\": \"%s\",\n  \"count\": %zu,\n  \"results\": [", SEMY_VERSION, count);
+    bool first = true;
+    if (input != NULL)
+    {
+        if (!parse_dataset(&dataset, parsed))
+        {
+            return EXIT_GENERAL_ERROR;
+        }
+        run_operations("input", &dataset, parsed, seconds, &first);
+        dataset_free(&dataset);
+    }
+
+    for (size_t w = 0; input == NULL && w < COUNT_OF(workloads); w++)
+    {
+        if (!dataset_init(&dataset, &workloads[w], count))
+        {
+            fprintf(stderr, "error: failed to generate the '%s' workload\n", workloads[w].name);
+            return EXIT_GENERAL_ERROR;
+        }
+
+        if (!parse_dataset(&dataset, parsed))
+        {
+            return EXIT_GENERAL_ERROR;
+        }
+        run_operations(workloads[w].name, &dataset, parsed, seconds, &first);
+        dataset_free(&dataset);
+    }
+    printf("\n  ]\n}\n");
+
+    free(parsed);
+    close(null_fd);
+    for (size_t i = 0; i < COUNT_OF(counters); i++)
+    {
+        if (counters[i].fd >= 0)
+        {
+            close(counters[i].fd);
+        }
+    }
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,53 @@
+// SPDX-License-Identifier: MIT
+/*
+ * Semy - a Semantic Versioning 2.0.0 processor.
+ * See https://semver.org/.
+ *
+ * Copyright (c) 2025-2026 Henry G. Stratmann III
+ * Copyright (c) 2025-2026 Semy Contributors
+ *
+ * This file is part of Semy, distributed under the MIT License.
+ * For full terms see the included LICENSE file.
+ */
+
+#ifndef BENCH_UTILS_H
+#define BENCH_UTILS_H
+
+#include <stdint.h>
+
+#define COUNT_OF(ARRAY) (sizeof(ARRAY)/sizeof((ARRAY)[0]))
+
+// Workloads are generated with xorshift64* so the same seed yields the same versions
+// on every platform.
+static inline uint64_t next_random(uint64_t *state)
+{
+    *state ^= *state >> 12;
+    *state ^= *state << 25;
+    *state ^= *state >> 27;
+    return *state * UINT64_C(2685821657736338717);
+}
+
+// Derives a starting state from a seed with splitmix64. xorshift is stuck at zero, so the
+// one seed that mixes to zero is given another state.
+static inline uint64_t seed_random(uint64_t seed)
+{
+    uint64_t z = seed + UINT64_C(0x9E3779B97F4A7C15);
+    z = (z ^ (z >> 30)) * UINT64_C(0xBF58476D1CE4E5B9);
+    z = (z ^ (z >> 27)) * UINT64_C(0x94D049BB133111EB);
+    z ^= z >> 31;
+    return (z == 0) ? UINT64_C(0x9E3779B97F4A7C15) : z;
+}
+
+// Returns a number in [0, bound).
+static inline uint32_t uniform(uint64_t *state, uint32_t bound)
+{
+    return (uint32_t)(next_random(state) % bound);
+}
+
+// Returns a number in [0, 1).
+static inline double uniform_real(uint64_t *state)
+{
+    return (double)(next_random(state) >> 11) * (1.0 / 9007199254740992.0);
+}
+
+#endif
@@ -0,0 +1,351 @@
+// SPDX-License-Identifier: MIT
+/*
+ * Semy - a Semantic Versioning 2.0.0 processor.
+ * See https://semver.org/.
+ *
+ * Copyright (c) 2025-2026 Henry G. Stratmann III
+ * Copyright (c) 2025-2026 Semy Contributors
+ *
+ * This file is part of Semy, distributed under the MIT License.
+ * For full terms see the included LICENSE file.
+ */
+
+// Writes a reproducible dataset of versions, one per line, to stdout. Version numbers
+// are skewed toward small values, as they are in release histories, and duplicates are
+// drawn from recently written versions, as they are in dependency lock files.
+
+#include "bench_utils.h"
+#include <math.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define MAX_VERSION_LENGTH 200 // The longest version 'semy_t' accepts.
+#define MAX_IDENTIFIERS 25
+#define HISTORY_SIZE 4096      // The number of recent versions duplicates are drawn from.
+
+struct options
+{
+    uint64_t seed;
+    uint64_t count;
+    double pre_release;   // The fraction of versions with pre-release identifiers.
+    double build;         // The fraction of versions with build metadata.
+    double identifiers;   // The mean number of pre-release identifiers.
+    double numeric;       // The fraction of pre-release identifiers that are numeric.
+    double duplicates;    // The fraction of versions repeating a recent version.
+    double invalid;       // The fraction of versions that are malformed.
+    uint32_t max_major;
+    uint32_t max_minor;
+    uint32_t max_patch;
+    uint32_t max_length;  // The longest alphanumeric identifier.
+};
+
+static const char *const words[] = {
+    "alpha", "beta", "rc", "pre", "dev", "snapshot", "preview", "nightly", "canary", "next", "M", "RC", "x-y-z",
+};
+
+// Returns a number in [0, maximum] where small numbers are far more likely than large ones.
+static uint32_t skewed(uint64_t *state, uint32_t maximum)
+{
+    const double u = uniform_real(state);
+    return (uint32_t)(u * u * u * ((double)maximum + 1.0));
+}
+
+// Returns a count at least one whose mean is 'mean', following a geometric distribution.
+static uint32_t geometric(uint64_t *state, double mean)
+{
+    if (mean <= 1.0)
+    {
+        return 1;
+    }
+
+    const double p = 1.0 / mean;
+    const double u = uniform_real(state);
+    return 1 + (uint32_t)(log(1.0 - u) / log(1.0 - p));
+}
+
+static size_t append(char *version, size_t length, const char *s)
+{
+    const size_t slen = strlen(s);
+    memcpy(&version[length], s, slen);
+    return length + slen;
+}
+
+static size_t append_number(char *version, size_t length, uint32_t value)
+{
+    return length + (size_t)sprintf(&version[length], "%u", value);
+}
+
+static size_t append_alphanumeric(uint64_t *state, const struct options *options, char *version, size_t length)
+{
+    static const char characters[] = "0123456789abcdefghijklmnopqrstuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZ-";
+    if (uniform(state, 4) != 0)
+    {
+        return append(version, length, words[uniform(state, COUNT_OF(words))]);
+    }
+
+    // A random identifier begins with a non-digit so it's never mistaken for a number.
+    const uint32_t identifier_length = 1 + uniform(state, options->max_length);
+    version[length++] = characters[10 + uniform(state, sizeof(characters) - 11)];
+    for (uint32_t i = 1; i < identifier_length; i++)
+    {
+        version[length++] = characters[uniform(state, sizeof(characters) - 1)];
+    }
+    return length;
+}
+
+static size_t generate(uint64_t *state, const struct options *options, char *version)
+{
+    size_t length = 0;
+    length = append_number(version, length, skewed(state, options->max_major));
+    version[length++] = '.';
+    length = append_number(version, length, skewed(state, options->max_minor));
+    version[length++] = '.';
+    length = append_number(version, length, skewed(state, options->max_patch));
+
+    // Identifiers are added while the version stays within the limits of 'semy_t'.
+    const size_t limit = MAX_VERSION_LENGTH - options->max_length - 12;
+    if (uniform_real(state) < options->pre_release)
+    {
+        uint32_t count = geometric(state, options->identifiers);
+        for (uint32_t i = 0; i < count && i < MAX_IDENTIFIERS && length < limit; i++)
+        {
+            version[length++] = (i == 0) ? '-' : '.';
+            if (uniform_real(state) < options->numeric)
+            {
+                length = append_number(version, length, skewed(state, 99));
+            }
+            else
+            {
+                length = append_alphanumeric(state, options, version, length);
+            }
+        }
+    }
+
+    if (uniform_real(state) < options->build && length < limit)
+    {
+        length += (size_t)sprintf(&version[length], "+build.%u", uniform(state, 100000));
+        if (uniform(state, 2) == 0 && length + 8 < limit)
+        {
+            length += (size_t)sprintf(&version[length], ".%07x", uniform(state, 0x10000000));
+        }
+    }
+    version[length] = '\0';
+    return length;
+}
+
+// Corrupts a valid version in one of the ways versions are commonly malformed.
+static size_t corrupt(uint64_t *state, char *version, size_t length)
+{
+    switch (uniform(state, 6))
+    {
+    case 0: // A leading 'v'.
+        memmove(&version[1], version, length + 1);
+        version[0] = 'v';
+        return length + 1;
+
+    case 1: // A missing patch version.
+        length = (size_t)(strchr(strchr(version, '.') + 1, '.') - version);
+        break;
+
+    case 2: // A leading zero.
+        memmove(&version[1], version, length + 1);
+        version[0] = '0';
+        return length + 1;
+
+    case 3: // An empty pre-release identifier, placed before any build metadata since
+            // build identifiers may contain hyphens.
+    {
+        const char *plus = strchr(version, '+');
+        const size_t end = (plus == NULL) ? length : (size_t)(plus - version);
+        memmove(&version[end + 1], &version[end], length - end + 1);
+        version[end] = (memchr(version, '-', end) == NULL) ? '-' : '.';
+        return length + 1;
+    }
+
+    case 4: // An invalid character.
+        length = append(version, length, (strchr(version, '-') == NULL) ? "-beta_1" : "_1");
+        break;
+
+    default: // Trailing whitespace.
+        version[length++] = ' ';
+        break;
+    }
+    version[length] = '\0';
+    return length;
+}
+
+static bool parse_fraction(const char *s, double *value)
+{
+    char *end = NULL;
+    *value = strtod(s, &end);
+    return *end == '\0' && *value >= 0.0 && *value <= 1.0;
+}
+
+static bool parse_number(const char *s, uint64_t maximum, uint64_t *value)
+{
+    char *end = NULL;
+    const unsigned long long result = strtoull(s, &end, 10);
+    *value = (uint64_t)result;
+    return *end == '\0' && end != s && result <= maximum;
+}
+
+static void print_usage(FILE *stream)
+{
+    fprintf(stream,
+        "usage: semy_generate [options]\n"
+        "  -h, --help          print this help\n"
+        "  --seed <n>          seed of the generator (1)\n"
+        "  --count <n>         number of versions (1000000)\n"
+        "  --pre-release <f>   fraction with pre-release identifiers (0.3)\n"
+        "  --identifiers <n>   mean number of pre-release identifiers (2)\n"
+        "  --numeric <f>       fraction of pre-release identifiers that are numeric (0.4)\n"
+        "  --build <f>         fraction with build metadata (0.1)\n"
+        "  --duplicates <f>    fraction repeating a recent version (0.2)\n"
+        "  --invalid <f>       fraction that are malformed (0)\n"
+        "  --max-major <n>     largest major version (30)\n"
+        "  --max-minor <n>     largest minor version (100)\n"
+        "  --max-patch <n>     largest patch version (500)\n"
+        "  --max-length <n>    longest alphanumeric identifier (12)\n");
+}
+
+int main(int argc, char *argv[])
+{
+    struct options options = {
+        .seed = 1,
+        .count = 1000000,
+        .pre_release = 0.3,
+        .build = 0.1,
+        .identifiers = 2.0,
+        .numeric = 0.4,
+        .duplicates = 0.2,
+        .invalid = 0.0,
+        .max_major = 30,
+        .max_minor = 100,
+        .max_patch = 500,
+        .max_length = 12,
+    };
+
+    for (int i = 1; i < argc; i++)
+    {
+        const char *arg = argv[i];
+        if (strcmp(arg, "-h") == 0 || strcmp(arg, "--help") == 0)
+        {
+            print_usage(stdout);
+            return 0;
+        }
+
+        if (i + 1 == argc)
+        {
+            fprintf(stderr, "error: missing value for '%s'\n", arg);
+            print_usage(stderr);
+            return 2;
+        }
+
+        const char *value = argv[++i];
+        uint64_t number = 0;
+        bool valid = true;
+        if (strcmp(arg, "--seed") == 0)
+        {
+            valid = parse_number(value, UINT64_MAX, &options.seed);
+        }
+        else if (strcmp(arg, "--count") == 0)
+        {
+            valid = parse_number(value, UINT64_MAX, &options.count);
+        }
+        else if (strcmp(arg, "--pre-release") == 0)
+        {
+            valid = parse_fraction(value, &options.pre_release);
+        }
+        else if (strcmp(arg, "--identifiers") == 0)
+        {
+            valid = parse_number(value, MAX_IDENTIFIERS, &number) && number > 0;
+            options.identifiers = (double)number;
+        }
+        else if (strcmp(arg, "--numeric") == 0)
+        {
+            valid = parse_fraction(value, &options.numeric);
+        }
+        else if (strcmp(arg, "--build") == 0)
+        {
+            valid = parse_fraction(value, &options.build);
+        }
+        else if (strcmp(arg, "--duplicates") == 0)
+        {
+            valid = parse_fraction(value, &options.duplicates);
+        }
+        else if (strcmp(arg, "--invalid") == 0)
+        {
+            valid = parse_fraction(value, &options.invalid);
+        }
+        else if (strcmp(arg, "--max-major") == 0)
+        {
+            valid = parse_number(value, INT32_MAX, &number);
+            options.max_major = (uint32_t)number;
+        }
+        else if (strcmp(arg, "--max-minor") == 0)
+        {
+            valid = parse_number(value, INT32_MAX, &number);
+            options.max_minor = (uint32_t)number;
+        }
+        else if (strcmp(arg, "--max-patch") == 0)
+        {
+            valid = parse_number(value, INT32_MAX, &number);
+            options.max_patch = (uint32_t)number;
+        }
+        else if (strcmp(arg, "--max-length") == 0)
+        {
+            valid = parse_number(value, 64, &number) && number > 0;
+            options.max_length = (uint32_t)number;
+        }
+        else
+        {
+            valid = false;
+        }
+
+        if (!valid)
+        {
+            fprintf(stderr, "error: invalid argument '%s %s'\n", arg, value);
+            print_usage(stderr);
+            return 2;
+        }
+    }
+
+    uint64_t state = seed_random(options.seed);
+    static char history[HISTORY_SIZE][MAX_VERSION_LENGTH + 8];
+    static size_t history_lengths[HISTORY_SIZE];
+    static char output[1 << 16];
+    setvbuf(stdout, output, _IOFBF, sizeof(output));
+
+    uint64_t written = 0;
+    for (uint64_t i = 0; i < options.count; i++)
+    {
+        // Duplicates favor the most recent versions.
+        if (written > 0 && uniform_real(&state) < options.duplicates)
+        {
+            const uint64_t available = (written < HISTORY_SIZE) ? written : HISTORY_SIZE;
+            const uint64_t back = skewed(&state, (uint32_t)(available - 1));
+            const size_t slot = (size_t)((written - 1 - back) % HISTORY_SIZE);
+            fwrite(history[slot], 1, history_lengths[slot], stdout);
+            putchar('\n');
+            continue;
+        }
+
+        char version[MAX_VERSION_LENGTH + 8];
+        size_t length = generate(&state, &options, version);
+        if (uniform_real(&state) < options.invalid)
+        {
+            length = corrupt(&state, version, length);
+        }
+
+        const size_t slot = (size_t)(written % HISTORY_SIZE);
+        memcpy(history[slot], version, length);
+        history_lengths[slot] = length;
+        written += 1;
+
+        fwrite(version, 1, length, stdout);
+        putchar('\n');
+    }
+    return (fflush(stdout) == 0) ? 0 : 3;
+}
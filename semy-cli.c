@@ -10,340 +10,3805 @@
  * For full terms see the included LICENSE file.
  */
 
+#if !defined(_WIN32)
+#define _POSIX_C_SOURCE 200809L
+#endif
+
 #include "semy.h"
 #include <stdio.h>
 #include <stdlib.h>
 #include <stdbool.h>
 #include <string.h>
 #include <stdarg.h>
+#include <time.h>
+
+#if defined(__unix__) || defined(__APPLE__)
+#define HAVE_POSIX_IO
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/resource.h>
+#include <sys/stat.h>
+#include <sys/uio.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <pthread.h>
+#include <signal.h>
+#include <errno.h>
+#include <sched.h>
+#include <stdatomic.h>
+#else
+struct iovec
+{
+    void *iov_base;
+    size_t iov_len;
+};
+#endif
+
+#define EXIT_BAD_SYNTAX 1
+#define EXIT_INVALID_OPTION 2
+#define EXIT_GENERAL_ERROR 3
+#define EXIT_OUT_OF_MEMORY 4
+
+// Versions read from stdin or a file are buffered in blocks of this size.
+#define READ_BLOCK_SIZE (64 * 1024)
+
+// Versions are copied here to be null terminated before parsing.
+// Anything longer exceeds the limits of the library.
+#define SCRATCH_SIZE 1024
+
+// Number of buffers gathered into a single write.
+#define GATHER_COUNT 1024
+
+// Output to stdout is accumulated in a buffer of this size.
+#define OUTPUT_BUFFER_SIZE (64 * 1024)
+
+// Streamed input is validated by --report in batches of this size.
+#define REPORT_BATCH_SIZE (4 * 1024 * 1024)
+
+// A batch is only split among threads into chunks at least this large.
+#define REPORT_CHUNK_SIZE (4 * 1024)
+
+// Number of malformed versions a chunk records before they must be printed.
+#define REPORT_FAILURE_CAPACITY 1024
+
+// Upper bound on the thread count accepted by -j.
+#define MAX_THREADS 256
+
+// Pipelined input is passed between threads in batches of complete lines of about this size.
+#define PIPELINE_BATCH_SIZE (256 * 1024)
+
+// Number of batches in flight for each parsing thread of a pipeline.
+#define PIPELINE_BATCHES_PER_THREAD 2
+
+// Number of times a thread of a pipeline yields waiting for a batch before it sleeps.
+#define PIPELINE_SPIN_COUNT 64
+
+// References a record in its source (an argument, read block, or mapped file)
+// along with the core version numbers and location of the pre-release of its version.
+struct sort_key
+{
+    const char *string;
+    uint32_t length;
+    int32_t core[3];
+    uint32_t pre_release;        // Offset of the pre-release identifiers in 'string'.
+    uint16_t pre_release_length; // Zero if there are no pre-release identifiers.
+};
+
+// Selects the version from a delimited field of each record rather than the whole record.
+struct key_field
+{
+    size_t number; // One-based field number or zero for the whole record.
+    char delimiter;
+};
+
+// Buffers output to stdout so it's written with few system calls.
+// It's flushed when full, before gathered writes, and when the program ends.
+// Each thread has its own so the parsing threads of a pipeline can write to batches.
+struct output
+{
+    int fd; // Descriptor written to: stdout or a client of --serve.
+    struct column *sink; // If non-null, output is appended here rather than written to 'fd'.
+    size_t length;
+    bool failed;
+    char buffer[OUTPUT_BUFFER_SIZE];
+};
+
+// Measurements printed by --stats. Phases are timed per block of input or output
+// rather than per version so timing them doesn't slow them down.
+struct run_stats
+{
+    bool enabled;
+    uint64_t items; // Versions parsed.
+    uint64_t bytes; // Bytes of input read, including versions given as arguments.
+    double read;    // Seconds spent reading or mapping input.
+    double parse;   // Seconds spent parsing and processing versions, summed over threads.
+    double sort;    // Seconds spent sorting.
+    double output;  // Seconds spent writing output.
+    bool parsing;      // A block of versions is being timed.
+    double parse_from; // When timing of the block started.
+    double excluded;   // Sort and output time when timing of the block started.
+};
+
+// A growable array of little-endian encoded values for the columnar format.
+struct column
+{
+    uint8_t *data;
+    size_t length;
+    size_t capacity;
+};
+
+// A file mapped into memory.
+struct mapping
+{
+    struct mapping *next;
+    void *data;
+    size_t size;
+};
+
+// A malformed version found by --report.
+struct failure
+{
+    const char *version;
+    size_t length;
+    uint64_t line;   // Line number relative to the start of its chunk.
+    uint64_t offset; // Byte offset relative to the start of its source.
+    size_t position; // Byte offset of the error relative to the start of the line.
+    semy_error_t error;
+};
+
+// A range of complete lines validated by a single thread. A chunk stops early once
+// its failures fill up and resumes after they're printed so output stays in order.
+struct chunk
+{
+    const struct key_field *key;
+    const char *cursor;
+    const char *end;
+    uint64_t offset; // Byte offset of 'cursor' in the source.
+    uint64_t lines;  // Number of lines scanned so far.
+    uint64_t versions; // Number of versions, i.e. non-empty lines, scanned so far.
+    double parse;      // Seconds spent scanning so far.
+    struct failure *failures;
+    size_t failure_count;
+    const char *printed;     // The first line whose status hasn't been printed.
+    uint64_t printed_lines;  // Number of lines whose status has been printed.
+    uint64_t printed_offset; // Byte offset of 'printed' in the source.
+};
+
+// State of a validation report.
+struct report
+{
+    const char *source; // Name printed alongside each line.
+    uint64_t line;      // Number of lines of the source validated by previous batches.
+    size_t thread_count;
+    struct chunk *chunks;
+    struct key_field key;
+    bool malformed_only; // Print only the malformed versions rather than every version.
+    bool invalid;
+};
+
+struct block
+{
+    struct block *next;
+    char data[];
+};
+
+// Splits a stream into lines in place: each line is null terminated
+// within the read buffer rather than copied out of it.
+struct reader
+{
+    FILE *stream;
+    bool owns_stream;
+    bool eof;
+    bool interactive;       // Read whatever is available rather than waiting for a full block.
+    struct block *current;  // The block being read into.
+    struct block **retired; // If non-null, blocks holding returned lines are kept here instead of reused.
+    size_t capacity;       // Usable size of the current block.
+    size_t begin;          // Offset of the first unconsumed byte.
+    size_t end;            // Offset one past the last byte read.
+};
+
+// Yields versions from the command-line, where the argument '-' denotes
+// stdin and the argument pair '-f <file>' denotes a file.
+struct input
+{
+    int argc;
+    char **argv;
+    int index;
+    bool reading;
+    struct reader reader;
+    struct block *retired;     // Blocks holding lines returned by a retaining input.
+    struct mapping *mappings;  // Files mapped by the input; unmapped by input_close.
+    const char *cursor;        // The unscanned portion of the most recently mapped file.
+    const char *cursor_end;
+    bool retain;
+    struct key_field key;
+    const char *record;    // The record holding the most recently returned version.
+    size_t record_length;
+};
+
+// LCOV_EXCL_START
+static void cli_fprintf(FILE *stream, const char *format, ...)
+{
+    va_list args;
+    va_start(args, format);
+    vfprintf(stream, format, args);
+    va_end(args);
+}
+// LCOV_EXCL_STOP
+
+// LCOV_EXCL_START
+static FILE *cli_fopen(const char *path)
+{
+    return fopen(path, "rb");
+}
+
+static size_t cli_fread(void *buffer, size_t size, FILE *stream)
+{
+    return fread(buffer, 1, size, stream);
+}
+
+// Reads at least one byte, but no more than are available without waiting, so a
+// request is answered as soon as it arrives. Returns zero at the end of the stream.
+static size_t cli_fread_available(void *buffer, size_t size, FILE *stream)
+{
+#if defined(HAVE_POSIX_IO)
+    ssize_t count;
+    do
+    {
+        count = read(fileno(stream), buffer, size);
+    } while (count < 0 && errno == EINTR);
+    return (count < 0) ? 0 : (size_t)count;
+#else
+    char *data = buffer;
+    size_t count = 0;
+    while (count < size)
+    {
+        const int c = getc(stream);
+        if (c == EOF)
+        {
+            break;
+        }
+        data[count++] = (char)c;
+        if (c == '\n')
+        {
+            break;
+        }
+    }
+    return count;
+#endif
+}
+
+// Creates (or truncates) the file and writes 'data' to it.
+static bool cli_write_file(const char *path, const void *data, size_t size)
+{
+    FILE *file = fopen(path, "wb");
+    if (file == NULL)
+    {
+        return false;
+    }
+    const bool written = fwrite(data, 1, size, file) == size;
+    return (fclose(file) == 0) && written;
+}
+
+// Returns the time in seconds since an unspecified point.
+static double cli_clock(void)
+{
+    struct timespec ts;
+    timespec_get(&ts, TIME_UTC);
+    return (double)ts.tv_sec + ((double)ts.tv_nsec * 1e-9);
+}
+
+// Returns the peak resident memory of the process in KiB or zero if it's unknown.
+static uint64_t cli_peak_memory(void)
+{
+#if defined(HAVE_POSIX_IO)
+    struct rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) == 0)
+    {
+#if defined(__APPLE__)
+        return (uint64_t)usage.ru_maxrss / 1024; // Reported in bytes rather than KiB.
+#else
+        return (uint64_t)usage.ru_maxrss;
+#endif
+    }
+#endif
+    return 0;
+}
+
+// Writes every buffer in 'iov' to the file descriptor, retrying short writes.
+static bool cli_writev(int fd, struct iovec *iov, int count)
+{
+#if defined(HAVE_POSIX_IO)
+    while (count > 0)
+    {
+        ssize_t written = writev(fd, iov, count);
+        if (written < 0)
+        {
+            return false;
+        }
+
+        while (count > 0 && (size_t)written >= iov->iov_len)
+        {
+            written -= (ssize_t)iov->iov_len;
+            iov += 1;
+            count -= 1;
+        }
+
+        if (count > 0)
+        {
+            iov->iov_base = (char *)iov->iov_base + written;
+            iov->iov_len -= (size_t)written;
+        }
+    }
+    return true;
+#else
+    FILE *stream = (fd == 2) ? stderr : stdout;
+    for (int i = 0; i < count; i++)
+    {
+        if (fwrite(iov[i].iov_base, 1, iov[i].iov_len, stream) != iov[i].iov_len)
+        {
+            return false;
+        }
+    }
+    return fflush(stream) == 0;
+#endif
+}
+// LCOV_EXCL_STOP
+
+static _Thread_local struct output output;
+static struct run_stats run_stats;
+
+// Returns the time for measuring a phase or zero if phases aren't measured.
+static double stats_clock(void)
+{
+    return run_stats.enabled ? cli_clock() : 0.0;
+}
+
+// Starts timing the parsing of a block of versions unless one is being timed already.
+static void stats_parse_begin(void)
+{
+    if (run_stats.enabled && !run_stats.parsing)
+    {
+        run_stats.parsing = true;
+        run_stats.parse_from = cli_clock();
+        run_stats.excluded = run_stats.sort + run_stats.output;
+    }
+}
+
+// Stops timing the parsing of a block of versions. Time spent sorting or writing output
+// meanwhile is already counted by those phases, so it's left out.
+static void stats_parse_end(void)
+{
+    if (run_stats.parsing)
+    {
+        run_stats.parsing = false;
+        const double excluded = run_stats.sort + run_stats.output - run_stats.excluded;
+        run_stats.parse += cli_clock() - run_stats.parse_from - excluded;
+    }
+}
+
+static bool column_append(struct column *column, const void *data, size_t length);
+
+static bool output_flush(void)
+{
+    if (output.length > 0 && output.sink != NULL)
+    {
+        if (!column_append(output.sink, output.buffer, output.length))
+        {
+            output.failed = true;
+        }
+        output.length = 0;
+    }
+    else if (output.length > 0)
+    {
+        const double start = stats_clock();
+        struct iovec iov = {output.buffer, output.length};
+        output.length = 0;
+        if (!cli_writev(output.fd, &iov, 1))
+        {
+            output.failed = true; // LCOV_EXCL_LINE
+        }
+        if (run_stats.enabled)
+        {
+            run_stats.output += stats_clock() - start;
+        }
+    }
+    return !output.failed;
+}
+
+static void output_write(const char *s, size_t length)
+{
+    while (length > 0)
+    {
+        if (output.length == sizeof(output.buffer))
+        {
+            output_flush();
+        }
+
+        size_t count = sizeof(output.buffer) - output.length;
+        if (count > length)
+        {
+            count = length;
+        }
+
+        memcpy(&output.buffer[output.length], s, count);
+        output.length += count;
+        s += count;
+        length -= count;
+    }
+}
+
+static void output_char(char c)
+{
+    if (output.length == sizeof(output.buffer))
+    {
+        output_flush();
+    }
+    output.buffer[output.length++] = c;
+}
+
+static void output_string(const char *s)
+{
+    output_write(s, strlen(s));
+}
+
+static void output_line(const char *s)
+{
+    output_string(s);
+    output_char('\n');
+}
+
+static void output_uint(uint64_t value)
+{
+    char digits[24];
+    size_t count = 0;
+
+    do
+    {
+        digits[sizeof(digits) - ++count] = (char)('0' + (value % 10U));
+        value /= 10U;
+    } while (value > 0U);
+
+    output_write(&digits[sizeof(digits) - count], count);
+}
+
+static void output_int(int32_t value)
+{
+    if (value < 0)
+    {
+        output_char('-');
+        output_uint(0U - (uint32_t)value);
+    }
+    else
+    {
+        output_uint((uint32_t)value);
+    }
+}
+
+static void *cli_calloc(size_t count, size_t size)
+{
+    return calloc(count, size);
+}
+
+static struct block *alloc_block(size_t capacity)
+{
+    // The extra byte lets the final line be null terminated even if it
+    // completely fills the block and lacks a trailing newline.
+    return cli_calloc(1, sizeof(struct block) + capacity + 1);
+}
+
+static void free_blocks(struct block *block)
+{
+    while (block != NULL)
+    {
+        struct block *next = block->next;
+        free(block);
+        block = next;
+    }
+}
+
+static void reader_close(struct reader *reader)
+{
+    if (reader->owns_stream)
+    {
+        fclose(reader->stream);
+    }
+
+    if (reader->retired != NULL && reader->current != NULL)
+    {
+        reader->current->next = *reader->retired;
+        *reader->retired = reader->current;
+    }
+    else
+    {
+        free(reader->current);
+    }
+
+    reader->current = NULL;
+    reader->stream = NULL;
+}
+
+// Makes room for more input by moving the incomplete line at the end of the
+// current block to the front of a block. The block is reused when streaming,
+// but replaced when retaining so previously returned lines stay valid.
+static int reader_refill(struct reader *reader)
+{
+    const size_t partial = reader->end - reader->begin;
+    struct block *block = reader->current;
+    size_t capacity = reader->capacity;
+
+    // Grow the block if a single line fills it entirely.
+    if (partial == capacity)
+    {
+        capacity *= 2;
+    }
+
+    const bool retire = reader->retired != NULL && reader->begin > 0;
+    if (capacity != reader->capacity || retire)
+    {
+        block = alloc_block(capacity);
+        if (block == NULL)
+        {
+            cli_fprintf(stderr, "error: memory allocation failed\n");
+            return EXIT_OUT_OF_MEMORY;
+        }
+        memcpy(block->data, &reader->current->data[reader->begin], partial);
+
+        if (retire)
+        {
+            reader->current->next = *reader->retired;
+            *reader->retired = reader->current;
+        }
+        else
+        {
+            free(reader->current);
+        }
+        reader->current = block;
+        reader->capacity = capacity;
+    }
+    else
+    {
+        memmove(block->data, &block->data[reader->begin], partial);
+    }
+
+    reader->begin = 0;
+    reader->end = partial;
+
+    stats_parse_end();
+    const double start = stats_clock();
+    const size_t count = reader->interactive
+        ? cli_fread_available(&block->data[partial], capacity - partial, reader->stream)
+        : cli_fread(&block->data[partial], capacity - partial, reader->stream);
+
+    // Sessions of the socket server read concurrently, so they only count while measuring,
+    // which the server doesn't do.
+    if (run_stats.enabled)
+    {
+        run_stats.bytes += count;
+        run_stats.read += stats_clock() - start;
+    }
+    stats_parse_begin();
+    if (count == 0)
+    {
+        // LCOV_EXCL_START
+        if (ferror(reader->stream))
+        {
+            cli_fprintf(stderr, "error: failed to read input\n");
+            return EXIT_GENERAL_ERROR;
+        }
+        // LCOV_EXCL_STOP
+        reader->eof = true;
+    }
+    reader->end += count;
+    return EXIT_SUCCESS;
+}
+
+// Returns the length of the line spanning [start, stop) without its
+// trailing carriage return (if any) to tolerate Windows-style line endings.
+static size_t line_length(const char *start, const char *stop)
+{
+    size_t length = (size_t)(stop - start);
+    if (length > 0 && start[length - 1] == '\r')
+    {
+        length -= 1;
+    }
+    return length;
+}
+
+// Returns the next non-empty line, or null in 'line' at the end of the stream.
+static int reader_next(struct reader *reader, const char **line, size_t *length)
+{
+    size_t offset = reader->begin;
+
+    for (;;)
+    {
+        char *data = reader->current->data;
+        char *newline = memchr(&data[offset], '\n', reader->end - offset);
+        if (newline == NULL && reader->eof)
+        {
+            newline = &data[reader->end];
+        }
+
+        if (newline != NULL)
+        {
+            char *start = &data[reader->begin];
+            const size_t count = line_length(start, newline);
+            reader->begin = (size_t)(newline - data);
+            if (reader->begin < reader->end)
+            {
+                reader->begin += 1;
+            }
+            start[count] = '\0';
+
+            if (count > 0)
+            {
+                *line = start;
+                *length = count;
+                return EXIT_SUCCESS;
+            }
+
+            if (reader->eof && reader->begin == reader->end)
+            {
+                *line = NULL;
+                *length = 0;
+                return EXIT_SUCCESS;
+            }
+
+            offset = reader->begin;
+            continue;
+        }
+
+        offset = reader->end - reader->begin;
+        const int r = reader_refill(reader);
+        if (r != EXIT_SUCCESS)
+        {
+            return r;
+        }
+        offset += reader->begin;
+    }
+}
+
+static int reader_open(struct reader *reader, const char *path, struct block **retired)
+{
+    memset(reader, 0, sizeof(reader[0]));
+    reader->retired = retired;
+    reader->capacity = READ_BLOCK_SIZE;
+
+    reader->current = alloc_block(reader->capacity);
+    if (reader->current == NULL)
+    {
+        cli_fprintf(stderr, "error: memory allocation failed\n");
+        return EXIT_OUT_OF_MEMORY;
+    }
+
+    if (path == NULL)
+    {
+        reader->stream = stdin;
+        return EXIT_SUCCESS;
+    }
+
+    // On POSIX systems a file that cannot be opened is reported by map_file() first.
+    reader->stream = cli_fopen(path);
+    // LCOV_EXCL_START
+    if (reader->stream == NULL)
+    {
+        cli_fprintf(stderr, "error: cannot open file '%s'\n", path);
+        free(reader->current);
+        reader->current = NULL;
+        return EXIT_GENERAL_ERROR;
+    }
+    // LCOV_EXCL_STOP
+    reader->owns_stream = true;
+    return EXIT_SUCCESS;
+}
+
+#if defined(HAVE_POSIX_IO)
+// Maps a regular file into memory. If the file cannot be mapped, e.g. because it's
+// empty or not a regular file, then 'mapping' is null and it should be read as a stream.
+static int map_file(const char *path, bool sequential, struct mapping **mapping)
+{
+    *mapping = NULL;
+
+    const int fd = open(path, O_RDONLY);
+    if (fd < 0)
+    {
+        cli_fprintf(stderr, "error: cannot open file '%s'\n", path);
+        return EXIT_GENERAL_ERROR;
+    }
+
+    struct stat info;
+    if (fstat(fd, &info) != 0 || !S_ISREG(info.st_mode) || info.st_size <= 0)
+    {
+        close(fd);
+        return EXIT_SUCCESS;
+    }
+
+    struct mapping *m = cli_calloc(1, sizeof(m[0]));
+    if (m == NULL)
+    {
+        close(fd);
+        cli_fprintf(stderr, "error: memory allocation failed\n");
+        return EXIT_OUT_OF_MEMORY;
+    }
+
+    m->size = (size_t)info.st_size;
+    run_stats.bytes += m->size;
+    m->data = mmap(NULL, m->size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+
+    // LCOV_EXCL_START
+    if (m->data == MAP_FAILED)
+    {
+        free(m);
+        return EXIT_SUCCESS;
+    }
+    // LCOV_EXCL_STOP
+
+    if (sequential)
+    {
+        posix_madvise(m->data, m->size, POSIX_MADV_SEQUENTIAL);
+    }
+
+    *mapping = m;
+    return EXIT_SUCCESS;
+}
+
+static void unmap_file(struct mapping *mapping)
+{
+    munmap(mapping->data, mapping->size);
+    free(mapping);
+}
+#endif
+
+static void input_init(struct input *input, int argc, char *argv[], const struct key_field *key, bool retain)
+{
+    memset(input, 0, sizeof(input[0]));
+    input->argc = argc;
+    input->argv = argv;
+    input->key = *key;
+    input->retain = retain;
+
+    // Versions are timed as they're parsed in blocks between reads.
+    stats_parse_begin();
+}
+
+// Releases the input. Lines returned by a retaining input remain valid until this is called.
+static void input_close(struct input *input)
+{
+    stats_parse_end();
+    if (input->reading)
+    {
+        reader_close(&input->reader);
+        input->reading = false;
+    }
+    free_blocks(input->retired);
+    input->retired = NULL;
+
+#if defined(HAVE_POSIX_IO)
+    while (input->mappings != NULL)
+    {
+        struct mapping *next = input->mappings->next;
+        unmap_file(input->mappings);
+        input->mappings = next;
+    }
+#endif
+}
+
+// Returns the next non-empty line of the most recently mapped file.
+static bool scan_mapping(struct input *input, const char **line, size_t *length)
+{
+    while (input->cursor < input->cursor_end)
+    {
+        const char *start = input->cursor;
+        const char *stop = memchr(start, '\n', (size_t)(input->cursor_end - start));
+        if (stop == NULL)
+        {
+            stop = input->cursor_end;
+            input->cursor = stop;
+        }
+        else
+        {
+            input->cursor = stop + 1;
+        }
+
+        const size_t count = line_length(start, stop);
+        if (count > 0)
+        {
+            *line = start;
+            *length = count;
+            return true;
+        }
+    }
+    return false;
+}
+
+// Opens the file (or stdin if 'path' is null) for reading. Files are
+// memory mapped when possible and streamed otherwise.
+static int input_open(struct input *input, const char *path)
+{
+#if defined(HAVE_POSIX_IO)
+    if (path != NULL)
+    {
+        // A mapped file is read as it's scanned, so only mapping it counts as reading.
+        struct mapping *mapping = NULL;
+        stats_parse_end();
+        const double start = stats_clock();
+        const int r = map_file(path, !input->retain, &mapping);
+        run_stats.read += stats_clock() - start;
+        stats_parse_begin();
+        if (r != EXIT_SUCCESS)
+        {
+            return r;
+        }
+
+        if (mapping != NULL)
+        {
+            mapping->next = input->mappings;
+            input->mappings = mapping;
+            input->cursor = mapping->data;
+            input->cursor_end = input->cursor + mapping->size;
+            return EXIT_SUCCESS;
+        }
+    }
+#endif
+
+    const int r = reader_open(&input->reader, path, input->retain ? &input->retired : NULL);
+    if (r == EXIT_SUCCESS)
+    {
+        input->reading = true;
+    }
+    return r;
+}
+
+// Returns the next record, or null in 'record' once all input is consumed.
+static int input_next_record(struct input *input, const char **record, size_t *length)
+{
+    for (;;)
+    {
+        if (input->cursor != NULL)
+        {
+            if (scan_mapping(input, record, length))
+            {
+                return EXIT_SUCCESS;
+            }
+
+            input->cursor = NULL;
+            input->cursor_end = NULL;
+
+#if defined(HAVE_POSIX_IO)
+            // Streaming inputs are done with the file once it's scanned.
+            if (!input->retain)
+            {
+                struct mapping *next = input->mappings->next;
+                unmap_file(input->mappings);
+                input->mappings = next;
+            }
+#endif
+        }
+
+        if (input->reading)
+        {
+            const int r = reader_next(&input->reader, record, length);
+            if (r != EXIT_SUCCESS || *record != NULL)
+            {
+                return r;
+            }
+            reader_close(&input->reader);
+            input->reading = false;
+        }
+
+        if (input->index >= input->argc)
+        {
+            stats_parse_end();
+            *record = NULL;
+            *length = 0;
+            return EXIT_SUCCESS;
+        }
+
+        const char *arg = input->argv[input->index++];
+        const char *path = NULL;
+
+        if (strcmp(arg, "-f") == 0)
+        {
+            if (input->index >= input->argc)
+            {
+                cli_fprintf(stderr, "error: expected a file name after '-f'\n");
+                return EXIT_INVALID_OPTION;
+            }
+            path = input->argv[input->index++];
+        }
+        else if (strcmp(arg, "-") != 0)
+        {
+            *record = arg;
+            *length = strlen(arg);
+            run_stats.bytes += *length;
+            return EXIT_SUCCESS;
+        }
+
+        const int r = input_open(input, path);
+        if (r != EXIT_SUCCESS)
+        {
+            return r;
+        }
+    }
+}
+
+// Locates the version in the record. A missing field yields an empty version.
+static void select_field(const struct key_field *key, const char *record, size_t length, const char **version, size_t *version_length)
+{
+    const char *end = record + length;
+    const char *start = record;
+    const char *stop = end;
+
+    if (key->number > 0)
+    {
+        for (size_t i = 1; i < key->number; i++)
+        {
+            start = memchr(start, key->delimiter, (size_t)(end - start));
+            if (start == NULL)
+            {
+                *version = end;
+                *version_length = 0;
+                return;
+            }
+            start += 1;
+        }
+
+        stop = memchr(start, key->delimiter, (size_t)(end - start));
+        if (stop == NULL)
+        {
+            stop = end;
+        }
+    }
+
+    *version = start;
+    *version_length = (size_t)(stop - start);
+}
+
+// Returns the next version, or null in 'version' once all input is consumed. The version
+// isn't null terminated. Its record is available in 'input->record' until the next call.
+static int input_next(struct input *input, const char **version, size_t *length)
+{
+    const int r = input_next_record(input, &input->record, &input->record_length);
+    if (r != EXIT_SUCCESS || input->record == NULL)
+    {
+        *version = NULL;
+        *length = 0;
+        return r;
+    }
+
+    select_field(&input->key, input->record, input->record_length, version, length);
+    return EXIT_SUCCESS;
+}
+
+// Parses the '-k <field>' or '-t <delimiter>' option at 'argv[*index]' and advances past it.
+// Returns -1 if the argument is neither option.
+static int parse_key_option(int argc, char *argv[], int *index, struct key_field *key)
+{
+    if (*index >= argc)
+    {
+        return -1;
+    }
+
+    const char *option = argv[*index];
+    const char *value = (*index + 1 < argc) ? argv[*index + 1] : NULL;
+
+    if (strcmp(option, "-k") == 0)
+    {
+        char *end = NULL;
+        const long number = (value != NULL) ? strtol(value, &end, 10) : 0;
+        if (value == NULL || *end != '\0' || number < 1)
+        {
+            cli_fprintf(stderr, "error: expected a field number after '-k'\n");
+            return EXIT_INVALID_OPTION;
+        }
+        key->number = (size_t)number;
+    }
+    else if (strcmp(option, "-t") == 0)
+    {
+        if (value == NULL || strlen(value) != 1 || value[0] == '\n')
+        {
+            cli_fprintf(stderr, "error: expected a single character delimiter after '-t'\n");
+            return EXIT_INVALID_OPTION;
+        }
+        key->delimiter = value[0];
+    }
+    else
+    {
+        return -1;
+    }
+
+    *index += 2;
+    return EXIT_SUCCESS;
+}
+
+// Parses the '-j <threads>' option at 'argv[*index]' and advances past it.
+// Returns -1 if the argument isn't the option.
+static int parse_thread_option(int argc, char *argv[], int *index, size_t *thread_count)
+{
+    if (*index >= argc || strcmp(argv[*index], "-j") != 0)
+    {
+        return -1;
+    }
+
+    const char *value = (*index + 1 < argc) ? argv[*index + 1] : NULL;
+    char *end = NULL;
+    const long count = (value != NULL) ? strtol(value, &end, 10) : 0;
+    if (value == NULL || *end != '\0' || count < 1 || count > MAX_THREADS)
+    {
+        cli_fprintf(stderr, "error: expected a thread count between 1 and %d after '-j'\n", MAX_THREADS);
+        return EXIT_INVALID_OPTION;
+    }
+
+    *thread_count = (size_t)count;
+    *index += 2;
+    return EXIT_SUCCESS;
+}
+
+// Consumes the leading key field options and, if 'thread_count' is non-null, the thread
+// option from the arguments. The thread count is zero unless the thread option is given.
+static int parse_stream_options(int *argc, char **argv[], struct key_field *key, size_t *thread_count)
+{
+    int index = 0;
+    int r = EXIT_SUCCESS;
+
+    key->number = 0;
+    key->delimiter = '\t';
+
+    if (thread_count != NULL)
+    {
+        *thread_count = 0;
+    }
+
+    while (r == EXIT_SUCCESS)
+    {
+        r = parse_key_option(*argc, *argv, &index, key);
+        if (r == -1 && thread_count != NULL)
+        {
+            r = parse_thread_option(*argc, *argv, &index, thread_count);
+        }
+    }
+
+    *argc -= index;
+    *argv += index;
+    return (r == -1) ? EXIT_SUCCESS : r;
+}
+
+// Consumes the leading key field options from the arguments.
+static int parse_key_options(int *argc, char **argv[], struct key_field *key)
+{
+    return parse_stream_options(argc, argv, key, NULL);
+}
+
+// Copies the version, which must be shorter than SCRATCH_SIZE, into 'scratch' and null
+// terminates it. Returns false if the version contains an embedded null character.
+static bool terminate(const char *string, size_t length, char scratch[SCRATCH_SIZE])
+{
+    memcpy(scratch, string, length);
+    scratch[length] = '\0';
+    return memchr(scratch, '\0', length) == NULL;
+}
+
+// Compares the dot-separated pre-release identifiers of two validated versions.
+static int compare_pre_release(const char *a, size_t a_length, const char *b, size_t b_length)
+{
+    const char *a_end = a + a_length;
+    const char *b_end = b + b_length;
+
+    for (;;)
+    {
+        const char *x = a;
+        const char *y = b;
+        bool x_is_numeric = true;
+        bool y_is_numeric = true;
+
+        for (; a < a_end && *a != '.'; a++)
+        {
+            x_is_numeric = x_is_numeric && (*a >= '0' && *a <= '9');
+        }
+
+        for (; b < b_end && *b != '.'; b++)
+        {
+            y_is_numeric = y_is_numeric && (*b >= '0' && *b <= '9');
+        }
+
+        const size_t x_length = (size_t)(a - x);
+        const size_t y_length = (size_t)(b - y);
+        int result = 0;
+
+        if (x_is_numeric && y_is_numeric)
+        {
+            // Numeric identifiers lack leading zeros so the longer one is larger.
+            if (x_length != y_length)
+            {
+                result = (x_length < y_length) ? -1 : 1;
+            }
+            else
+            {
+                result = memcmp(x, y, x_length);
+            }
+        }
+        else if (x_is_numeric || y_is_numeric)
+        {
+            // Alphanumeric identifiers have greater precedence than numeric identifiers.
+            result = x_is_numeric ? -1 : 1;
+        }
+        else
+        {
+            result = memcmp(x, y, (x_length < y_length) ? x_length : y_length);
+            if (result == 0 && x_length != y_length)
+            {
+                result = (x_length < y_length) ? -1 : 1;
+            }
+        }
+
+        if (result != 0)
+        {
+            return (result < 0) ? -1 : 1;
+        }
+
+        // A larger set of pre-release identifiers has a higher precedence.
+        if (a == a_end || b == b_end)
+        {
+            return (int)(b == b_end) - (int)(a == a_end);
+        }
+
+        a += 1;
+        b += 1;
+    }
+}
+
+static int compare_sort_keys(const void *a, const void *b)
+{
+    const struct sort_key *x = (const struct sort_key *)a;
+    const struct sort_key *y = (const struct sort_key *)b;
+
+    for (int i = 0; i < 3; i++)
+    {
+        if (x->core[i] != y->core[i])
+        {
+            return (x->core[i] < y->core[i]) ? -1 : 1;
+        }
+    }
+
+    // A pre-release version has lower precedence than a normal version.
+    if (x->pre_release_length == 0 || y->pre_release_length == 0)
+    {
+        return (int)(x->pre_release_length == 0) - (int)(y->pre_release_length == 0);
+    }
+
+    return compare_pre_release(&x->string[x->pre_release], x->pre_release_length,
+                               &y->string[y->pre_release], y->pre_release_length);
+}
+
+// Parses a version that isn't necessarily null terminated.
+static semy_error_t parse_version(const char *string, size_t length, semy_t *semvar)
+{
+    char scratch[SCRATCH_SIZE];
+
+    if (length >= SCRATCH_SIZE)
+    {
+        return SEMY_LIMITS_EXCEEDED;
+    }
+    else if (!terminate(string, length, scratch))
+    {
+        return SEMY_BAD_SYNTAX;
+    }
+    return semy_parse(semvar, sizeof(semvar[0]), scratch);
+}
+
+// Parses like parse_version() and also populates 'position' with the byte offset in 'string'
+// where parsing stopped: where the error was found or, if the version is valid, its length.
+static semy_error_t diagnose_version(const char *string, size_t length, semy_t *semvar, size_t *position)
+{
+    char scratch[SCRATCH_SIZE];
+    semy_production_t production;
+
+    // A version too long for the scratch buffer is diagnosed by a prefix, which is still
+    // too long for the library, so the error is found at the same position.
+    const size_t prefix = (length < SCRATCH_SIZE) ? length : SCRATCH_SIZE - 1;
+    const bool terminated = terminate(string, prefix, scratch);
+
+    // An embedded null character ends the version early. If what precedes it is valid,
+    // then the null character itself is the error.
+    const semy_error_t error = semy_parse_diagnose(semvar, sizeof(semvar[0]), scratch, position, &production);
+    if (error == SEMY_NO_ERROR && !terminated)
+    {
+        return SEMY_BAD_SYNTAX;
+    }
+    return error;
+}
+
+// Returns the exit status for a parse error along with the message describing it.
+static int parse_status(semy_error_t err, const char **message)
+{
+    *message = NULL;
+
+    if (err == SEMY_BAD_SYNTAX)
+    {
+        *message = "invalid semantic version";
+        return EXIT_BAD_SYNTAX;
+    }
+    else if (err == SEMY_LIMITS_EXCEEDED)
+    {
+        *message = "semantic version is too complex for this implementation";
+        return EXIT_GENERAL_ERROR;
+    }
+    // LCOV_EXCL_START
+    else if (err != SEMY_NO_ERROR)
+    {
+        *message = "internal malfunction";
+        return EXIT_GENERAL_ERROR;
+    }
+    // LCOV_EXCL_STOP
+    return EXIT_SUCCESS;
+}
+
+static int parse(const char *string, size_t length, semy_t *semvar)
+{
+    const char *message;
+    run_stats.items += 1;
+    const int r = parse_status(parse_version(string, length, semvar), &message);
+    if (r != EXIT_SUCCESS)
+    {
+        cli_fprintf(stderr, "error: %s\n", message);
+    }
+    return r;
+}
+
+#if defined(HAVE_POSIX_IO)
+// A batch of input passed through a pipeline. The reader fills it, a parsing thread parses
+// it and writes its output, and the writer writes that output and returns it to the reader.
+struct batch
+{
+    char *data;         // Lines or, if 'separator' is null, versions given as arguments.
+    size_t length;
+    size_t capacity;    // Usable size of 'data', which has a spare byte to end its last line.
+    char separator;
+    uint64_t items;     // Versions parsed, including the malformed one that ended the batch.
+    double parse;       // Seconds spent parsing the batch.
+    struct column text; // Output of the batch.
+    int status;         // Exit status of the error that ended the batch, if any.
+    const char *error;  // Format of the error message, with at most one '%s' for 'detail'.
+    const char *detail;
+};
+
+// A bounded single-producer, single-consumer queue of batches. Only the consumer advances
+// 'head' and only the producer advances 'tail' so neither takes a lock. A consumer that
+// keeps finding the queue empty sleeps on 'wake' rather than spinning, and the producer
+// only takes the lock to wake it when 'sleeping' is set.
+struct batch_queue
+{
+    struct batch **slots;
+    size_t mask; // One less than the number of slots, which is a power of two.
+    _Atomic size_t head;
+    char padding[64]; // Keeps the consumer and producer from sharing a cache line.
+    _Atomic size_t tail;
+    _Atomic bool sleeping;
+    pthread_mutex_t lock;
+    pthread_cond_t wake;
+};
+
+// The queues between a parsing thread and the reader and writer.
+struct stage
+{
+    struct pipeline *pipeline;
+    struct batch_queue input;
+    struct batch_queue output;
+};
+
+// Overlaps reading, parsing, and writing. A reader thread splits the input into batches and
+// deals them to the parsing threads in turn; the writer receives them in the same order so
+// the output is in input order.
+struct pipeline
+{
+    int argc;
+    char **argv;
+    struct key_field key;
+    void (*decompose)(const char *, size_t, const semy_t *); // Null if only validating.
+    struct stage *stages;
+    size_t stage_count;
+    size_t next; // Stage the reader sends the next batch to.
+    struct batch *batches;
+    size_t batch_count;
+    struct batch **slots;        // Storage for the slots of every queue.
+    struct batch_queue recycled; // Batches written by the writer and returned to the reader.
+    _Atomic bool stopped;        // Set by the writer when the remaining input isn't needed.
+};
+
+static bool queue_init(struct batch_queue *queue, struct batch **slots, size_t mask)
+{
+    atomic_init(&queue->head, 0);
+    atomic_init(&queue->tail, 0);
+    atomic_init(&queue->sleeping, false);
+    if (pthread_mutex_init(&queue->lock, NULL) != 0)
+    {
+        return false; // LCOV_EXCL_LINE
+    }
+    if (pthread_cond_init(&queue->wake, NULL) != 0)
+    {
+        // LCOV_EXCL_START
+        pthread_mutex_destroy(&queue->lock);
+        return false;
+        // LCOV_EXCL_STOP
+    }
+    queue->slots = slots;
+    queue->mask = mask;
+    return true;
+}
+
+static void queue_destroy(struct batch_queue *queue)
+{
+    if (queue->slots != NULL)
+    {
+        pthread_mutex_destroy(&queue->lock);
+        pthread_cond_destroy(&queue->wake);
+    }
+}
+
+// Queues have room for every batch, so pushing never waits.
+static void queue_push(struct batch_queue *queue, struct batch *batch)
+{
+    const size_t tail = atomic_load_explicit(&queue->tail, memory_order_relaxed);
+    queue->slots[tail & queue->mask] = batch;
+
+    // Sequentially consistent with the consumer checking 'tail' after setting 'sleeping',
+    // so either it sees the batch or this sees it sleeping and wakes it.
+    atomic_store(&queue->tail, tail + 1);
+    if (atomic_load(&queue->sleeping))
+    {
+        pthread_mutex_lock(&queue->lock);
+        pthread_cond_signal(&queue->wake);
+        pthread_mutex_unlock(&queue->lock);
+    }
+}
+
+static struct batch *queue_pop(struct batch_queue *queue)
+{
+    const size_t head = atomic_load_explicit(&queue->head, memory_order_relaxed);
+
+    // Batches arrive often while the pipeline is busy, so spin briefly before sleeping.
+    for (int i = 0; atomic_load_explicit(&queue->tail, memory_order_acquire) == head; i++)
+    {
+        if (i < PIPELINE_SPIN_COUNT)
+        {
+            sched_yield();
+            continue;
+        }
+
+        pthread_mutex_lock(&queue->lock);
+        atomic_store(&queue->sleeping, true);
+        while (atomic_load(&queue->tail) == head)
+        {
+            pthread_cond_wait(&queue->wake, &queue->lock);
+        }
+        atomic_store_explicit(&queue->sleeping, false, memory_order_relaxed);
+        pthread_mutex_unlock(&queue->lock);
+    }
+
+    struct batch *batch = queue->slots[head & queue->mask];
+    atomic_store_explicit(&queue->head, head + 1, memory_order_release);
+    return batch;
+}
+
+// Sends the batch, or null to end the input, to the next stage.
+static void pipeline_send(struct pipeline *pipeline, struct batch *batch)
+{
+    queue_push(&pipeline->stages[pipeline->next].input, batch);
+    pipeline->next = (pipeline->next + 1) % pipeline->stage_count;
+}
+
+// Waits for the writer to return a batch and empties it.
+static struct batch *pipeline_take(struct pipeline *pipeline, char separator)
+{
+    struct batch *batch = queue_pop(&pipeline->recycled);
+    batch->length = 0;
+    batch->separator = separator;
+    batch->items = 0;
+    batch->parse = 0.0;
+    batch->text.length = 0;
+    batch->status = EXIT_SUCCESS;
+    return batch;
+}
+
+// Replaces the data of the batch with a larger allocation.
+static bool batch_grow(struct batch *batch, size_t capacity)
+{
+    char *data = cli_calloc(1, capacity + 1);
+    if (data == NULL)
+    {
+        return false;
+    }
+    memcpy(data, batch->data, batch->length);
+    free(batch->data);
+    batch->data = data;
+    batch->capacity = capacity;
+    return true;
+}
+
+// Ends the input with the batch. Its error is printed once the output before it is written.
+static void pipeline_fail(struct pipeline *pipeline, struct batch *batch, int status, const char *error, const char *detail)
+{
+    batch->status = status;
+    batch->error = error;
+    batch->detail = detail;
+    pipeline_send(pipeline, batch);
+}
+
+// Reads the stream into batches of complete lines. When a batch fills, the incomplete
+// line at its end is moved to the next batch. Returns the batch being filled, which holds
+// the end of the stream, or null if the input ended with an error.
+static struct batch *pipeline_read_stream(struct pipeline *pipeline, struct batch *batch, FILE *stream)
+{
+    if (batch->length > 0 && batch->separator != '\n')
+    {
+        pipeline_send(pipeline, batch);
+        batch = pipeline_take(pipeline, '\n');
+    }
+    batch->separator = '\n';
+
+    for (;;)
+    {
+        if (batch->length >= batch->capacity)
+        {
+            size_t size = batch->length;
+            while (size > 0 && batch->data[size - 1] != '\n')
+            {
+                size -= 1;
+            }
+
+            // Grow the batch if a single line fills it entirely.
+            if (size == 0)
+            {
+                if (!batch_grow(batch, batch->capacity * 2))
+                {
+                    pipeline_fail(pipeline, batch, EXIT_OUT_OF_MEMORY, "error: memory allocation failed\n", NULL); // LCOV_EXCL_LINE
+                    return NULL; // LCOV_EXCL_LINE
+                }
+            }
+            else
+            {
+                struct batch *next = pipeline_take(pipeline, '\n');
+                memcpy(next->data, &batch->data[size], batch->length - size);
+                next->length = batch->length - size;
+                batch->length = size;
+                pipeline_send(pipeline, batch);
+                batch = next;
+            }
+        }
+
+        if (atomic_load(&pipeline->stopped))
+        {
+            return batch; // LCOV_EXCL_LINE
+        }
+
+        const double start = stats_clock();
+        const size_t count = cli_fread(&batch->data[batch->length], batch->capacity - batch->length, stream);
+        run_stats.read += stats_clock() - start;
+        run_stats.bytes += count;
+        if (count == 0)
+        {
+            // LCOV_EXCL_START
+            if (ferror(stream))
+            {
+                pipeline_fail(pipeline, batch, EXIT_GENERAL_ERROR, "error: failed to read input\n", NULL);
+                return NULL;
+            }
+            // LCOV_EXCL_STOP
+            break;
+        }
+        batch->length += count;
+    }
+
+    // End the last line so it isn't joined with the first line of the next input.
+    // The spare byte of the batch guarantees there's room.
+    if (batch->length > 0 && batch->data[batch->length - 1] != '\n')
+    {
+        batch->data[batch->length++] = '\n';
+    }
+    return batch;
+}
+
+// Appends a version given as an argument, null terminated, to the batch.
+static struct batch *pipeline_read_argument(struct pipeline *pipeline, struct batch *batch, const char *arg)
+{
+    const size_t length = strlen(arg) + 1;
+    run_stats.bytes += length - 1;
+
+    if (batch->length > 0 && (batch->separator != '\0' || batch->length + length > batch->capacity))
+    {
+        pipeline_send(pipeline, batch);
+        batch = pipeline_take(pipeline, '\0');
+    }
+    batch->separator = '\0';
+
+    if (length > batch->capacity && !batch_grow(batch, length))
+    {
+        // LCOV_EXCL_START
+        pipeline_fail(pipeline, batch, EXIT_OUT_OF_MEMORY, "error: memory allocation failed\n", NULL);
+        return NULL;
+        // LCOV_EXCL_STOP
+    }
+
+    memcpy(&batch->data[batch->length], arg, length);
+    batch->length += length;
+    return batch;
+}
+
+// Reads the versions given as arguments, stdin, and files into batches.
+static void *pipeline_read(void *context)
+{
+    struct pipeline *pipeline = context;
+    struct batch *batch = pipeline_take(pipeline, '\n');
+
+    for (int i = 0; i < pipeline->argc && batch != NULL && !atomic_load(&pipeline->stopped); i++)
+    {
+        const char *arg = pipeline->argv[i];
+        if (strcmp(arg, "-") == 0)
+        {
+            batch = pipeline_read_stream(pipeline, batch, stdin);
+        }
+        else if (strcmp(arg, "-f") != 0)
+        {
+            batch = pipeline_read_argument(pipeline, batch, arg);
+        }
+        else if (i + 1 >= pipeline->argc)
+        {
+            pipeline_fail(pipeline, batch, EXIT_INVALID_OPTION, "error: expected a file name after '-f'\n", NULL);
+            batch = NULL;
+        }
+        else
+        {
+            const char *path = pipeline->argv[++i];
+            FILE *stream = cli_fopen(path);
+            if (stream == NULL)
+            {
+                pipeline_fail(pipeline, batch, EXIT_GENERAL_ERROR, "error: cannot open file '%s'\n", path);
+                batch = NULL;
+            }
+            else
+            {
+                batch = pipeline_read_stream(pipeline, batch, stream);
+                fclose(stream);
+            }
+        }
+    }
+
+    if (batch != NULL)
+    {
+        pipeline_send(pipeline, batch);
+    }
+
+    // End the input of every stage, starting with the stage the writer receives from next.
+    for (size_t i = 0; i < pipeline->stage_count; i++)
+    {
+        pipeline_send(pipeline, NULL);
+    }
+    return NULL;
+}
+
+// Parses the versions of a batch, and decomposes them into the output of the batch,
+// until it ends or a version is malformed.
+static void pipeline_parse(struct pipeline *pipeline, struct batch *batch)
+{
+    const char *cursor = batch->data;
+    const char *end = cursor + batch->length;
+    const double start = stats_clock();
+
+    output.sink = &batch->text;
+    output.failed = false;
+
+    while (cursor < end)
+    {
+        const char *start = cursor;
+        const char *stop = memchr(start, batch->separator, (size_t)(end - start));
+        if (stop == NULL)
+        {
+            stop = end;
+        }
+        cursor = (stop < end) ? stop + 1 : end;
+
+        // Lines are skipped if they're empty, but versions given as arguments never are.
+        size_t length = (size_t)(stop - start);
+        if (batch->separator == '\n')
+        {
+            length = line_length(start, stop);
+            if (length == 0)
+            {
+                continue;
+            }
+        }
+
+        const char *version = NULL;
+        size_t version_length = 0;
+        select_field(&pipeline->key, start, length, &version, &version_length);
+
+        semy_t semver;
+        const semy_error_t error = parse_version(version, version_length, &semver);
+        batch->items += 1;
+        if (error != SEMY_NO_ERROR)
+        {
+            batch->status = parse_status(error, &batch->detail);
+            batch->error = "error: %s\n";
+            break;
+        }
+
+        if (pipeline->decompose != NULL)
+        {
+            pipeline->decompose(version, version_length, &semver);
+        }
+    }
+
+    if (!output_flush())
+    {
+        // LCOV_EXCL_START
+        batch->status = EXIT_OUT_OF_MEMORY;
+        batch->error = "error: memory allocation failed\n";
+        // LCOV_EXCL_STOP
+    }
+    output.sink = NULL;
+    batch->parse = stats_clock() - start;
+}
+
+// Parses the batches of a stage until its input ends.
+static void *pipeline_work(void *context)
+{
+    struct stage *stage = context;
+    for (;;)
+    {
+        struct batch *batch = queue_pop(&stage->input);
+        if (batch != NULL && !atomic_load(&stage->pipeline->stopped))
+        {
+            pipeline_parse(stage->pipeline, batch);
+        }
+
+        queue_push(&stage->output, batch);
+        if (batch == NULL)
+        {
+            return NULL;
+        }
+    }
+}
+
+// Writes the output of the batches in input order, stopping at the first error.
+static int pipeline_write(struct pipeline *pipeline)
+{
+    int r = EXIT_SUCCESS;
+
+    for (size_t i = 0;; i = (i + 1) % pipeline->stage_count)
+    {
+        struct batch *batch = queue_pop(&pipeline->stages[i].output);
+        if (batch == NULL)
+        {
+            // The remaining stages end in turn.
+            for (size_t j = 1; j < pipeline->stage_count; j++)
+            {
+                queue_pop(&pipeline->stages[(i + j) % pipeline->stage_count].output);
+            }
+            return r;
+        }
+
+        if (r == EXIT_SUCCESS)
+        {
+            run_stats.items += batch->items;
+            run_stats.parse += batch->parse;
+            if (batch->text.length > 0 && output_flush())
+            {
+                const double start = stats_clock();
+                struct iovec iov = {batch->text.data, batch->text.length};
+                if (!cli_writev(output.fd, &iov, 1))
+                {
+                    output.failed = true; // LCOV_EXCL_LINE
+                }
+                run_stats.output += stats_clock() - start;
+            }
+
+            if (batch->status != EXIT_SUCCESS)
+            {
+                cli_fprintf(stderr, batch->error, batch->detail);
+                atomic_store(&pipeline->stopped, true);
+                r = batch->status;
+            }
+        }
+        queue_push(&pipeline->recycled, batch);
+    }
+}
+
+static void pipeline_free(struct pipeline *pipeline)
+{
+    if (pipeline->batches != NULL)
+    {
+        for (size_t i = 0; i < pipeline->batch_count; i++)
+        {
+            free(pipeline->batches[i].data);
+            free(pipeline->batches[i].text.data);
+        }
+    }
+    free(pipeline->batches);
+
+    queue_destroy(&pipeline->recycled);
+    if (pipeline->stages != NULL)
+    {
+        for (size_t i = 0; i < pipeline->stage_count; i++)
+        {
+            queue_destroy(&pipeline->stages[i].input);
+            queue_destroy(&pipeline->stages[i].output);
+        }
+    }
+    free(pipeline->stages);
+    free(pipeline->slots);
+}
+
+static int pipeline_init(struct pipeline *pipeline, size_t stage_count)
+{
+    pipeline->stage_count = stage_count;
+    pipeline->batch_count = stage_count * PIPELINE_BATCHES_PER_THREAD + 2;
+
+    // Every queue has room for every batch and the end of the input so sending never waits.
+    size_t slots = 1;
+    while (slots < pipeline->batch_count + 1)
+    {
+        slots *= 2;
+    }
+
+    pipeline->stages = cli_calloc(stage_count, sizeof(pipeline->stages[0]));
+    pipeline->batches = cli_calloc(pipeline->batch_count, sizeof(pipeline->batches[0]));
+    pipeline->slots = cli_calloc(slots * (stage_count * 2 + 1), sizeof(pipeline->slots[0]));
+    if (pipeline->stages == NULL || pipeline->batches == NULL || pipeline->slots == NULL)
+    {
+        return EXIT_OUT_OF_MEMORY;
+    }
+
+    atomic_init(&pipeline->stopped, false);
+    if (!queue_init(&pipeline->recycled, pipeline->slots, slots - 1))
+    {
+        return EXIT_OUT_OF_MEMORY; // LCOV_EXCL_LINE
+    }
+
+    for (size_t i = 0; i < stage_count; i++)
+    {
+        struct stage *stage = &pipeline->stages[i];
+        stage->pipeline = pipeline;
+        if (!queue_init(&stage->input, &pipeline->slots[slots * (i * 2 + 1)], slots - 1) ||
+            !queue_init(&stage->output, &pipeline->slots[slots * (i * 2 + 2)], slots - 1))
+        {
+            return EXIT_OUT_OF_MEMORY; // LCOV_EXCL_LINE
+        }
+    }
+
+    // Input buffers are allocated up front so only lines longer than a batch allocate later.
+    // The output of a batch grows as it's written.
+    for (size_t i = 0; i < pipeline->batch_count; i++)
+    {
+        struct batch *batch = &pipeline->batches[i];
+        batch->data = cli_calloc(1, PIPELINE_BATCH_SIZE + 1);
+        batch->capacity = PIPELINE_BATCH_SIZE;
+        if (batch->data == NULL)
+        {
+            return EXIT_OUT_OF_MEMORY;
+        }
+        queue_push(&pipeline->recycled, batch);
+    }
+    return EXIT_SUCCESS;
+}
+#endif
+
+// Validates, and decomposes if 'decompose' is non-null, the versions with a pipeline of
+// 'thread_count' parsing threads. Returns -1 if the pipeline cannot be started, in which
+// case the versions should be processed sequentially.
+static int run_pipeline(int argc, char *argv[], const struct key_field *key, size_t thread_count,
+                        void (*decompose)(const char *, size_t, const semy_t *))
+{
+#if defined(HAVE_POSIX_IO)
+    struct pipeline pipeline = {0};
+    pthread_t threads[MAX_THREADS];
+    pthread_t reader;
+    size_t started = 0;
+
+    pipeline.argc = argc;
+    pipeline.argv = argv;
+    pipeline.key = *key;
+    pipeline.decompose = decompose;
+
+    if (pipeline_init(&pipeline, thread_count) != EXIT_SUCCESS)
+    {
+        pipeline_free(&pipeline);
+        cli_fprintf(stderr, "error: memory allocation failed\n");
+        return EXIT_OUT_OF_MEMORY;
+    }
+
+    while (started < thread_count && pthread_create(&threads[started], NULL, pipeline_work, &pipeline.stages[started]) == 0)
+    {
+        started += 1;
+    }
+
+    // LCOV_EXCL_START
+    if (started < thread_count || pthread_create(&reader, NULL, pipeline_read, &pipeline) != 0)
+    {
+        for (size_t i = 0; i < started; i++)
+        {
+            pipeline_send(&pipeline, NULL);
+            pthread_join(threads[i], NULL);
+        }
+        pipeline_free(&pipeline);
+        return -1;
+    }
+    // LCOV_EXCL_STOP
+
+    const int r = pipeline_write(&pipeline);
+
+    pthread_join(reader, NULL);
+    for (size_t i = 0; i < started; i++)
+    {
+        pthread_join(threads[i], NULL);
+    }
+    pipeline_free(&pipeline);
+    return r;
+#else
+    (void)argc;
+    (void)argv;
+    (void)key;
+    (void)thread_count;
+    (void)decompose;
+    return -1;
+#endif
+}
+
+static int do_validate(int argc, char *argv[])
+{
+    struct input input;
+    struct key_field key;
+    size_t thread_count = 0;
+    int r = parse_stream_options(&argc, &argv, &key, &thread_count);
+    if (r != EXIT_SUCCESS)
+    {
+        return r;
+    }
+
+    if (thread_count > 0)
+    {
+        r = run_pipeline(argc, argv, &key, thread_count, NULL);
+        if (r != -1)
+        {
+            return r;
+        }
+    }
+
+    input_init(&input, argc, argv, &key, false);
+
+    for (;;)
+    {
+        const char *version = NULL;
+        size_t length = 0;
+        r = input_next(&input, &version, &length);
+        if (r != EXIT_SUCCESS || version == NULL)
+        {
+            break;
+        }
+
+        semy_t semver;
+        r = parse(version, length, &semver);
+        if (r != EXIT_SUCCESS)
+        {
+            break;
+        }
+    }
+
+    input_close(&input);
+    return r;
+}
+
+// Validates each line of the chunk until it ends or its failures fill up.
+static void scan_chunk(struct chunk *chunk)
+{
+    const double start = stats_clock();
+    while (chunk->cursor < chunk->end && chunk->failure_count < REPORT_FAILURE_CAPACITY)
+    {
+        const char *start = chunk->cursor;
+        const char *stop = memchr(start, '\n', (size_t)(chunk->end - start));
+        const char *next = (stop == NULL) ? chunk->end : stop + 1;
+        if (stop == NULL)
+        {
+            stop = chunk->end;
+        }
+
+        const size_t length = line_length(start, stop);
+        if (length > 0)
+        {
+            const char *version = NULL;
+            size_t version_length = 0;
+            select_field(chunk->key, start, length, &version, &version_length);
+
+            semy_t semver;
+            size_t position = 0;
+            const semy_error_t error = diagnose_version(version, version_length, &semver, &position);
+            chunk->versions += 1;
+            if (error != SEMY_NO_ERROR)
+            {
+                struct failure *failure = &chunk->failures[chunk->failure_count++];
+                failure->version = start;
+                failure->length = length;
+                failure->line = chunk->lines;
+                failure->offset = chunk->offset;
+                failure->position = (size_t)(version - start) + position;
+                failure->error = error;
+            }
+        }
+
+        chunk->lines += 1;
+        chunk->offset += (uint64_t)(next - start);
+        chunk->cursor = next;
+    }
+    chunk->parse += stats_clock() - start;
+}
+
+#if defined(HAVE_POSIX_IO)
+static void *scan_chunk_thread(void *chunk)
+{
+    scan_chunk(chunk);
+    return NULL;
+}
+#endif
+
+// Scans the chunks in [first, count) that have room for more failures. The first
+// chunk is scanned by the calling thread and the remainder by worker threads.
+static void scan_chunks(struct report *report, size_t first, size_t count)
+{
+#if defined(HAVE_POSIX_IO)
+    pthread_t threads[MAX_THREADS];
+    bool started[MAX_THREADS] = {false};
+
+    for (size_t i = first + 1; i < count; i++)
+    {
+        struct chunk *chunk = &report->chunks[i];
+        if (chunk->cursor < chunk->end && chunk->failure_count < REPORT_FAILURE_CAPACITY)
+        {
+            started[i] = pthread_create(&threads[i], NULL, scan_chunk_thread, chunk) == 0;
+            if (!started[i])
+            {
+                scan_chunk(chunk); // LCOV_EXCL_LINE
+            }
+        }
+    }
+
+    scan_chunk(&report->chunks[first]);
+
+    for (size_t i = first + 1; i < count; i++)
+    {
+        if (started[i])
+        {
+            pthread_join(threads[i], NULL);
+        }
+    }
+#else
+    for (size_t i = first; i < count; i++)
+    {
+        scan_chunk(&report->chunks[i]);
+    }
+#endif
+}
+
+// Prints the source, line number, byte offset, status, error position, and text of a line.
+static void print_status(const struct report *report, uint64_t line, uint64_t offset, const char *status,
+                         size_t position, const char *text, size_t length)
+{
+    output_string(report->source);
+    output_char('\t');
+    output_uint(report->line + line + 1U);
+    output_char('\t');
+    output_uint(offset);
+    output_char('\t');
+    output_string(status);
+    output_char('\t');
+    output_uint(position);
+    output_char('\t');
+    output_write(text, length);
+    output_char('\n');
+}
+
+static void print_failure(struct report *report, const struct failure *failure)
+{
+    const char *status = (failure->error == SEMY_LIMITS_EXCEEDED) ? "limits-exceeded" : "bad-syntax";
+    print_status(report, failure->line, failure->offset, status, failure->position, failure->version, failure->length);
+    report->invalid = true;
+}
+
+// Prints the status of each line the chunk scanned since it was last printed. Only the
+// failures are printed if the report is limited to malformed versions; otherwise the lines
+// between them are walked again to print the valid versions, whose position is their end.
+static void print_chunk(struct report *report, struct chunk *chunk)
+{
+    size_t next = 0;
+
+    if (report->malformed_only)
+    {
+        for (; next < chunk->failure_count; next++)
+        {
+            print_failure(report, &chunk->failures[next]);
+        }
+    }
+
+    while (chunk->printed < chunk->cursor && !report->malformed_only)
+    {
+        const char *start = chunk->printed;
+        const char *stop = memchr(start, '\n', (size_t)(chunk->cursor - start));
+        const char *after = (stop == NULL) ? chunk->cursor : stop + 1;
+        if (stop == NULL)
+        {
+            stop = chunk->cursor;
+        }
+
+        const size_t length = line_length(start, stop);
+        if (next < chunk->failure_count && chunk->failures[next].line == chunk->printed_lines)
+        {
+            print_failure(report, &chunk->failures[next++]);
+        }
+        else if (length > 0)
+        {
+            const char *version = NULL;
+            size_t version_length = 0;
+            select_field(chunk->key, start, length, &version, &version_length);
+            const size_t position = (size_t)(version - start) + version_length;
+            print_status(report, chunk->printed_lines, chunk->printed_offset, "ok", position, start, length);
+        }
+
+        chunk->printed_lines += 1;
+        chunk->printed_offset += (uint64_t)(after - start);
+        chunk->printed = after;
+    }
+    chunk->failure_count = 0;
+}
+
+// Validates the lines of a batch in parallel and prints their status in input order.
+// The batch must end on a line boundary unless it's the end of the source.
+static void report_batch(struct report *report, const char *data, size_t size, uint64_t offset)
+{
+    const char *end = data + size;
+    const char *cursor = data;
+    size_t count = 0;
+
+    // Split the batch into chunks that begin on line boundaries.
+    size_t target = 1 + size / REPORT_CHUNK_SIZE;
+    if (target > report->thread_count)
+    {
+        target = report->thread_count;
+    }
+
+    while (cursor < end)
+    {
+        const char *stop = end;
+        if (count + 1 < target)
+        {
+            const size_t split = size / target * (count + 1);
+            stop = (data + split > cursor) ? data + split : cursor;
+            stop = memchr(stop, '\n', (size_t)(end - stop));
+            stop = (stop == NULL) ? end : stop + 1;
+        }
+
+        struct chunk *chunk = &report->chunks[count++];
+        chunk->key = &report->key;
+        chunk->cursor = cursor;
+        chunk->end = stop;
+        chunk->offset = offset + (uint64_t)(cursor - data);
+        chunk->lines = 0;
+        chunk->versions = 0;
+        chunk->parse = 0.0;
+        chunk->failure_count = 0;
+        chunk->printed = cursor;
+        chunk->printed_lines = 0;
+        chunk->printed_offset = chunk->offset;
+        cursor = stop;
+    }
+
+    // Print chunks in order. When a chunk stops early because its failures filled up,
+    // print what it found and scan again; later chunks wait until it completes.
+    size_t first = 0;
+    while (first < count)
+    {
+        scan_chunks(report, first, count);
+
+        for (; first < count; first++)
+        {
+            struct chunk *chunk = &report->chunks[first];
+            print_chunk(report, chunk);
+            if (chunk->cursor < chunk->end)
+            {
+                break;
+            }
+            report->line += chunk->lines;
+            run_stats.items += chunk->versions;
+            run_stats.parse += chunk->parse;
+        }
+    }
+}
+
+// Reports on a stream by reading it in batches of complete lines.
+static int report_stream(struct report *report, FILE *stream)
+{
+    size_t capacity = REPORT_BATCH_SIZE;
+    size_t length = 0;
+    uint64_t offset = 0;
+    bool eof = false;
+
+    char *buffer = cli_calloc(1, capacity);
+    if (buffer == NULL)
+    {
+        cli_fprintf(stderr, "error: memory allocation failed\n");
+        return EXIT_OUT_OF_MEMORY;
+    }
+
+    while (!eof)
+    {
+        // Grow the buffer if a single line fills it entirely.
+        if (length == capacity)
+        {
+            char *larger = cli_calloc(2, capacity);
+            if (larger == NULL)
+            {
+                free(buffer);
+                cli_fprintf(stderr, "error: memory allocation failed\n");
+                return EXIT_OUT_OF_MEMORY;
+            }
+            memcpy(larger, buffer, length);
+            free(buffer);
+            buffer = larger;
+            capacity *= 2;
+        }
+
+        const double start = stats_clock();
+        const size_t count = cli_fread(&buffer[length], capacity - length, stream);
+        run_stats.read += stats_clock() - start;
+        run_stats.bytes += count;
+        if (count == 0)
+        {
+            // LCOV_EXCL_START
+            if (ferror(stream))
+            {
+                free(buffer);
+                cli_fprintf(stderr, "error: failed to read input\n");
+                return EXIT_GENERAL_ERROR;
+            }
+            // LCOV_EXCL_STOP
+            eof = true;
+        }
+        length += count;
+
+        // Hold back the incomplete line at the end of the buffer until more is read.
+        size_t size = length;
+        if (!eof)
+        {
+            while (size > 0 && buffer[size - 1] != '\n')
+            {
+                size -= 1;
+            }
+        }
+
+        report_batch(report, buffer, size, offset);
+        memmove(buffer, &buffer[size], length - size);
+        length -= size;
+        offset += size;
+    }
+
+    free(buffer);
+    return EXIT_SUCCESS;
+}
+
+// Reports on a file (or stdin if 'path' is null).
+static int report_file(struct report *report, const char *path)
+{
+    report->source = (path == NULL) ? "-" : path;
+    report->line = 0;
+
+    if (path == NULL)
+    {
+        return report_stream(report, stdin);
+    }
+
+#if defined(HAVE_POSIX_IO)
+    struct mapping *mapping = NULL;
+    int r = map_file(path, true, &mapping);
+    if (r != EXIT_SUCCESS)
+    {
+        return r;
+    }
+
+    if (mapping != NULL)
+    {
+        report_batch(report, mapping->data, mapping->size, 0);
+        unmap_file(mapping);
+        return EXIT_SUCCESS;
+    }
+#endif
+
+    FILE *stream = cli_fopen(path);
+    // LCOV_EXCL_START
+    if (stream == NULL)
+    {
+        cli_fprintf(stderr, "error: cannot open file '%s'\n", path);
+        return EXIT_GENERAL_ERROR;
+    }
+    // LCOV_EXCL_STOP
+    r = report_stream(report, stream);
+    fclose(stream);
+    return r;
+}
+
+static size_t default_thread_count(void)
+{
+#if defined(HAVE_POSIX_IO) && defined(_SC_NPROCESSORS_ONLN)
+    const long count = sysconf(_SC_NPROCESSORS_ONLN);
+    if (count > MAX_THREADS)
+    {
+        return MAX_THREADS; // LCOV_EXCL_LINE
+    }
+    else if (count > 0)
+    {
+        return (size_t)count;
+    }
+#endif
+    return 1; // LCOV_EXCL_LINE
+}
+
+// Validates every version rather than stopping at the first malformed one and prints the
+// source, line number, byte offset, status, and error position of each version, or only of
+// the malformed versions with '-m'.
+static int do_report(int argc, char *argv[])
+{
+    struct report report = {0};
+    uint64_t arguments = 0;
+    int r = EXIT_SUCCESS;
+    int i = 0;
+
+    report.thread_count = default_thread_count();
+    report.key.delimiter = '\t';
+
+    for (;;)
+    {
+        if (i < argc && strcmp(argv[i], "-m") == 0)
+        {
+            report.malformed_only = true;
+            i += 1;
+            continue;
+        }
+
+        r = parse_key_option(argc, argv, &i, &report.key);
+        if (r == -1)
+        {
+            r = parse_thread_option(argc, argv, &i, &report.thread_count);
+        }
+
+        if (r == -1)
+        {
+            r = EXIT_SUCCESS;
+            break;
+        }
+        else if (r != EXIT_SUCCESS)
+        {
+            return r;
+        }
+    }
+
+    report.chunks = cli_calloc(report.thread_count, sizeof(report.chunks[0]));
+    struct failure *failures = cli_calloc(report.thread_count * REPORT_FAILURE_CAPACITY, sizeof(failures[0]));
+    if (report.chunks == NULL || failures == NULL)
+    {
+        free(report.chunks);
+        free(failures);
+        cli_fprintf(stderr, "error: memory allocation failed\n");
+        return EXIT_OUT_OF_MEMORY;
+    }
+
+    for (size_t j = 0; j < report.thread_count; j++)
+    {
+        report.chunks[j].failures = &failures[j * REPORT_FAILURE_CAPACITY];
+    }
+
+    for (; i < argc && r == EXIT_SUCCESS; i++)
+    {
+        if (strcmp(argv[i], "-f") == 0)
+        {
+            if (i + 1 >= argc)
+            {
+                cli_fprintf(stderr, "error: expected a file name after '-f'\n");
+                r = EXIT_INVALID_OPTION;
+                break;
+            }
+            i += 1;
+            r = report_file(&report, argv[i]);
+        }
+        else if (strcmp(argv[i], "-") == 0)
+        {
+            r = report_file(&report, NULL);
+        }
+        else
+        {
+            // Arguments are numbered by their position among the version arguments.
+            report.source = "arg";
+            report.line = arguments++;
+            run_stats.bytes += strlen(argv[i]);
+            report_batch(&report, argv[i], strlen(argv[i]), 0);
+        }
+    }
+
+    free(report.chunks);
+    free(failures);
+
+    if (r == EXIT_SUCCESS && report.invalid)
+    {
+        r = EXIT_BAD_SYNTAX;
+    }
+    return r;
+}
+
+// Initializes the sort key of a record from the parsed version it contains.
+static void fill_sort_key(struct sort_key *key, const char *record, size_t record_length,
+                          const char *version, size_t length, const semy_t *semver)
+{
+    key->string = record;
+    key->length = (uint32_t)record_length;
+    key->core[0] = semy_get_major(semver);
+    key->core[1] = semy_get_minor(semver);
+    key->core[2] = semy_get_patch(semver);
+    key->pre_release = 0;
+    key->pre_release_length = 0;
+
+    // The core version consists of digits and dots so the first hyphen starts the pre-release.
+    if (semy_get_pre_release_count(semver) > 0)
+    {
+        const char *start = (const char *)memchr(version, '-', length) + 1;
+        const char *stop = memchr(start, '+', length - (size_t)(start - version));
+        if (stop == NULL)
+        {
+            stop = version + length;
+        }
+        key->pre_release = (uint32_t)(start - record);
+        key->pre_release_length = (uint16_t)(stop - start);
+    }
+}
+
+// Writes the sorted versions to the output directly from where they reside in
+// memory (an argument, read block, or mapped file) using gathered writes.
+static int write_sorted(const struct sort_key *keys, size_t count)
+{
+    static const char newline[] = "\n";
+    struct iovec iov[GATHER_COUNT];
+    int iov_count = 0;
+
+    if (!output_flush())
+    {
+        return EXIT_GENERAL_ERROR; // LCOV_EXCL_LINE
+    }
+
+    for (size_t i = 0; i <= count; i++)
+    {
+        if (iov_count == GATHER_COUNT || (i == count && iov_count > 0))
+        {
+            const double start = stats_clock();
+            // LCOV_EXCL_START
+            if (!cli_writev(output.fd, iov, iov_count))
+            {
+                cli_fprintf(stderr, "error: failed to write output\n");
+                return EXIT_GENERAL_ERROR;
+            }
+            // LCOV_EXCL_STOP
+            run_stats.output += stats_clock() - start;
+            iov_count = 0;
+        }
+
+        if (i < count)
+        {
+            iov[iov_count].iov_base = (void *)keys[i].string;
+            iov[iov_count].iov_len = keys[i].length;
+            iov[iov_count + 1].iov_base = (void *)newline;
+            iov[iov_count + 1].iov_len = 1;
+            iov_count += 2;
+        }
+    }
+    return EXIT_SUCCESS;
+}
+
+static int do_sort(int argc, char *argv[])
+{
+    struct input input;
+    struct key_field field;
+    struct sort_key *keys = NULL;
+    size_t capacity = 0;
+    size_t count = 0;
+    int r = parse_key_options(&argc, &argv, &field);
+    if (r != EXIT_SUCCESS)
+    {
+        return r;
+    }
+
+    input_init(&input, argc, argv, &field, true);
+
+    for (;;)
+    {
+        const char *version = NULL;
+        size_t length = 0;
+        r = input_next(&input, &version, &length);
+        if (r != EXIT_SUCCESS || version == NULL)
+        {
+            break;
+        }
+
+        semy_t semver;
+        r = parse(version, length, &semver);
+        if (r != EXIT_SUCCESS)
+        {
+            break;
+        }
+
+        if (count == capacity)
+        {
+            capacity = (capacity == 0) ? 64 : capacity * 2;
+            struct sort_key *grown = cli_calloc(capacity, sizeof(keys[0]));
+            if (grown == NULL)
+            {
+                cli_fprintf(stderr, "error: memory allocation failed\n");
+                r = EXIT_OUT_OF_MEMORY;
+                break;
+            }
+            if (count > 0)
+            {
+                memcpy(grown, keys, count * sizeof(keys[0]));
+            }
+            free(keys);
+            keys = grown;
+        }
+
+        fill_sort_key(&keys[count++], input.record, input.record_length, version, length, &semver);
+    }
+
+    // Without versions there's nothing to sort or write, and 'keys' is null.
+    if (r == EXIT_SUCCESS && count > 0)
+    {
+        const double start = stats_clock();
+        qsort(keys, count, sizeof(keys[0]), compare_sort_keys);
+        run_stats.sort += stats_clock() - start;
+        r = write_sorted(keys, count);
+    }
+
+    input_close(&input);
+    free(keys);
+    return r;
+}
+
+static int do_compare(int argc, char *argv[])
+{
+    semy_t semvers[2] = {0};
+
+    if (argc != 2)
+    {
+        cli_fprintf(stderr, "error: expected exactly two version strings\n");
+        return EXIT_INVALID_OPTION;
+    }
+
+    stats_parse_begin();
+    for (int i = 0; i < 2; i++)
+    {
+        const int r = parse(argv[i], strlen(argv[i]), &semvers[i]);
+        if (r != EXIT_SUCCESS)
+        {
+            stats_parse_end();
+            return r;
+        }
+    }
+    stats_parse_end();
+
+    int32_t result = 0;
+    semy_compare(&semvers[0], &semvers[1], &result);
+
+    output_int(result);
+    output_char('\n');
+    return EXIT_SUCCESS;
+}
+
+static void decompose_json(const char *version, size_t length, const semy_t *semver)
+{
+    output_line("{");
+    output_string("    \"raw\": \"");
+    output_write(version, length);
+    output_string("\",\n    \"major\": ");
+    output_int(semy_get_major(semver));
+    output_string(",\n    \"minor\": ");
+    output_int(semy_get_minor(semver));
+    output_string(",\n    \"patch\": ");
+    output_int(semy_get_patch(semver));
+    output_line(",");
+
+    const int32_t pre_release_count = semy_get_pre_release_count(semver);
+    if (pre_release_count > 0)
+    {
+        output_line("    \"preRelease\": [");
+        for (int32_t i = 0; i < pre_release_count; i++)
+        {
+            output_string("        \"");
+            output_string(semy_get_pre_release(semver, i));
+            output_line((i < pre_release_count - 1) ? "\"," : "\"");
+        }
+        output_line("    ],");
+    }
+    else
+    {
+        output_line("    \"preRelease\": [],");
+    }
+
+    const int32_t build_metadata_count = semy_get_build_count(semver);
+    if (build_metadata_count > 0)
+    {
+        output_line("    \"buildMetadata\": [");
+        for (int32_t i = 0; i < build_metadata_count; i++)
+        {
+            output_string("        \"");
+            output_string(semy_get_build(semver, i));
+            output_line((i < build_metadata_count - 1) ? "\"," : "\"");
+        }
+        output_line("    ]");
+    }
+    else
+    {
+        output_line("    \"buildMetadata\": []");
+    }
+
+    output_line("}");
+}
+
+static void decompose_xml(const char *version, size_t length, const semy_t *semver)
+{
+    output_line("<?xml version=\"1.0\" encoding=\"utf-8\"?>");
+    output_line("<semver>");
+    output_string("    <raw>");
+    output_write(version, length);
+    output_string("</raw>\n    <major>");
+    output_int(semy_get_major(semver));
+    output_string("</major>\n    <minor>");
+    output_int(semy_get_minor(semver));
+    output_string("</minor>\n    <patch>");
+    output_int(semy_get_patch(semver));
+    output_line("</patch>");
+
+    const int32_t pre_release_count = semy_get_pre_release_count(semver);
+    if (pre_release_count > 0)
+    {
+        output_line("    <preRelease>");
+        for (int32_t i = 0; i < pre_release_count; i++)
+        {
+            output_string("        <identifier>");
+            output_string(semy_get_pre_release(semver, i));
+            output_line("</identifier>");
+        }
+        output_line("    </preRelease>");
+    }
+    else
+    {
+        output_line("    <preRelease></preRelease>");
+    }
+
+    const int32_t build_metadata_count = semy_get_build_count(semver);
+    if (build_metadata_count > 0)
+    {
+        output_line("    <buildMetadata>");
+        for (int32_t i = 0; i < build_metadata_count; i++)
+        {
+            output_string("        <identifier>");
+            output_string(semy_get_build(semver, i));
+            output_line("</identifier>");
+        }
+        output_line("    </buildMetadata>");
+    }
+    else
+    {
+        output_line("    <buildMetadata></buildMetadata>");
+    }
+
+    output_line("</semver>");
+}
+
+// Prints the identifiers separated by 'separator', each wrapped in 'quote' (if any).
+static void decompose_identifiers(const semy_t *semver, bool pre_release, char separator, const char *quote)
+{
+    const int32_t count = pre_release ? semy_get_pre_release_count(semver) : semy_get_build_count(semver);
+    for (int32_t i = 0; i < count; i++)
+    {
+        if (i > 0)
+        {
+            output_char(separator);
+        }
+        output_string(quote);
+        output_string(pre_release ? semy_get_pre_release(semver, i) : semy_get_build(semver, i));
+        output_string(quote);
+    }
+}
+
+static void decompose_ndjson(const char *version, size_t length, const semy_t *semver)
+{
+    output_string("{\"raw\":\"");
+    output_write(version, length);
+    output_string("\",\"major\":");
+    output_int(semy_get_major(semver));
+    output_string(",\"minor\":");
+    output_int(semy_get_minor(semver));
+    output_string(",\"patch\":");
+    output_int(semy_get_patch(semver));
+    output_string(",\"preRelease\":[");
+    decompose_identifiers(semver, true, ',', "\"");
+    output_string("],\"buildMetadata\":[");
+    decompose_identifiers(semver, false, ',', "\"");
+    output_line("]}");
+}
+
+static void decompose_tsv(const char *version, size_t length, const semy_t *semver)
+{
+    output_write(version, length);
+    output_char('\t');
+    output_int(semy_get_major(semver));
+    output_char('\t');
+    output_int(semy_get_minor(semver));
+    output_char('\t');
+    output_int(semy_get_patch(semver));
+    output_char('\t');
+    decompose_identifiers(semver, true, '.', "");
+    output_char('\t');
+    decompose_identifiers(semver, false, '.', "");
+    output_char('\n');
+}
+
+// Decomposes every version on its own line.
+static int decompose_each(struct input *input, void (*decompose)(const char *, size_t, const semy_t *))
+{
+    for (;;)
+    {
+        const char *version = NULL;
+        size_t length = 0;
+        int r = input_next(input, &version, &length);
+        if (r != EXIT_SUCCESS || version == NULL)
+        {
+            return r;
+        }
+
+        semy_t semver;
+        r = parse(version, length, &semver);
+        if (r != EXIT_SUCCESS)
+        {
+            return r;
+        }
+        decompose(version, length, &semver);
+    }
+}
+
+static bool column_append(struct column *column, const void *data, size_t length)
+{
+    if (column->length + length > column->capacity)
+    {
+        size_t capacity = (column->capacity == 0) ? 4096 : column->capacity * 2;
+        while (capacity < column->length + length)
+        {
+            capacity *= 2;
+        }
+
+        uint8_t *grown = cli_calloc(capacity, 1);
+        if (grown == NULL)
+        {
+            return false;
+        }
+        if (column->length > 0)
+        {
+            memcpy(grown, column->data, column->length);
+        }
+        free(column->data);
+        column->data = grown;
+        column->capacity = capacity;
+    }
+    memcpy(&column->data[column->length], data, length);
+    column->length += length;
+    return true;
+}
+
+static bool column_append_u32(struct column *column, uint32_t value)
+{
+    const uint8_t bytes[4] = {
+        (uint8_t)value,
+        (uint8_t)(value >> 8),
+        (uint8_t)(value >> 16),
+        (uint8_t)(value >> 24),
+    };
+    return column_append(column, bytes, sizeof(bytes));
+}
+
+static void output_u32(uint32_t value)
+{
+    output_char((char)(uint8_t)value);
+    output_char((char)(uint8_t)(value >> 8));
+    output_char((char)(uint8_t)(value >> 16));
+    output_char((char)(uint8_t)(value >> 24));
+}
+
+static void output_u64(uint64_t value)
+{
+    output_u32((uint32_t)value);
+    output_u32((uint32_t)(value >> 32));
+}
+
+// Writes the column padded with zeros to a multiple of eight bytes.
+static void output_column(const struct column *column)
+{
+    static const char padding[8] = {0};
+    if (column->length > 0)
+    {
+        output_write((const char *)column->data, column->length);
+    }
+    output_write(padding, (8 - (column->length % 8)) % 8);
+}
+
+enum
+{
+    COLUMN_VALIDITY,
+    COLUMN_MAJOR,
+    COLUMN_MINOR,
+    COLUMN_PATCH,
+    COLUMN_PRE_RELEASE_ROWS,
+    COLUMN_PRE_RELEASE_OFFSETS,
+    COLUMN_PRE_RELEASE_DATA,
+    COLUMN_BUILD_ROWS,
+    COLUMN_BUILD_OFFSETS,
+    COLUMN_BUILD_DATA,
+    COLUMN_COUNT,
+};
+
+// Appends the pre-release or build identifiers of a row: the identifier bytes to
+// the data column, their end offsets to the offsets column, and the end index of
+// the row's identifiers to the rows column.
+static bool columnar_identifiers(struct column *columns, const semy_t *semver, bool pre_release)
+{
+    struct column *rows = &columns[pre_release ? COLUMN_PRE_RELEASE_ROWS : COLUMN_BUILD_ROWS];
+    struct column *offsets = &columns[pre_release ? COLUMN_PRE_RELEASE_OFFSETS : COLUMN_BUILD_OFFSETS];
+    struct column *data = &columns[pre_release ? COLUMN_PRE_RELEASE_DATA : COLUMN_BUILD_DATA];
+    const int32_t count = (semver == NULL) ? 0 : pre_release ? semy_get_pre_release_count(semver) : semy_get_build_count(semver);
+
+    for (int32_t i = 0; i < count; i++)
+    {
+        const char *identifier = pre_release ? semy_get_pre_release(semver, i) : semy_get_build(semver, i);
+        if (!column_append(data, identifier, strlen(identifier)))
+        {
+            return false;
+        }
+
+        if (data->length > UINT32_MAX || !column_append_u32(offsets, (uint32_t)data->length))
+        {
+            return false;
+        }
+    }
+    return column_append_u32(rows, (uint32_t)(offsets->length / 4 - 1));
+}
+
+// Writes the versions as fixed-width little-endian columns that can be memory
+// mapped and used without parsing. Malformed versions are recorded as null rows.
+static int decompose_columnar(const struct key_field *key, int argc, char *argv[])
+{
+    struct column columns[COLUMN_COUNT];
+    struct input input;
+    uint64_t rows = 0;
+    int r = EXIT_SUCCESS;
+
+    memset(columns, 0, sizeof(columns));
+    input_init(&input, argc, argv, key, false);
+
+    // Offset columns begin with a leading zero so row 'i' spans [i, i + 1).
+    const int offset_columns[] = {COLUMN_PRE_RELEASE_ROWS, COLUMN_PRE_RELEASE_OFFSETS, COLUMN_BUILD_ROWS, COLUMN_BUILD_OFFSETS};
+    for (size_t i = 0; i < sizeof(offset_columns) / sizeof(offset_columns[0]); i++)
+    {
+        if (!column_append_u32(&columns[offset_columns[i]], 0))
+        {
+            r = EXIT_OUT_OF_MEMORY;
+        }
+    }
+
+    while (r == EXIT_SUCCESS)
+    {
+        const char *version = NULL;
+        size_t length = 0;
+        r = input_next(&input, &version, &length);
+        if (r != EXIT_SUCCESS || version == NULL)
+        {
+            break;
+        }
+
+        semy_t semver;
+        const bool valid = parse_version(version, length, &semver) == SEMY_NO_ERROR;
+        run_stats.items += 1;
+
+        if ((rows % 8) == 0)
+        {
+            const uint8_t zero = 0;
+            if (!column_append(&columns[COLUMN_VALIDITY], &zero, 1))
+            {
+                r = EXIT_OUT_OF_MEMORY;
+                break;
+            }
+        }
+
+        if (valid)
+        {
+            columns[COLUMN_VALIDITY].data[rows / 8] |= (uint8_t)(1U << (rows % 8));
+        }
+
+        if (!column_append_u32(&columns[COLUMN_MAJOR], valid ? (uint32_t)semy_get_major(&semver) : 0) ||
+            !column_append_u32(&columns[COLUMN_MINOR], valid ? (uint32_t)semy_get_minor(&semver) : 0) ||
+            !column_append_u32(&columns[COLUMN_PATCH], valid ? (uint32_t)semy_get_patch(&semver) : 0) ||
+            !columnar_identifiers(columns, valid ? &semver : NULL, true) ||
+            !columnar_identifiers(columns, valid ? &semver : NULL, false))
+        {
+            r = EXIT_OUT_OF_MEMORY;
+            break;
+        }
+        rows += 1;
+    }
+
+    if (r == EXIT_OUT_OF_MEMORY)
+    {
+        cli_fprintf(stderr, "error: memory allocation failed\n");
+    }
+    else if (r == EXIT_SUCCESS)
+    {
+        output_write("SEMYCOL1", 8);
+        output_u32(1); // Format version.
+        output_u32(COLUMN_COUNT);
+        output_u64(rows);
+        for (int i = 0; i < COLUMN_COUNT; i++)
+        {
+            output_u64(columns[i].length);
+        }
+        for (int i = 0; i < COLUMN_COUNT; i++)
+        {
+            output_column(&columns[i]);
+        }
+    }
+
+    for (int i = 0; i < COLUMN_COUNT; i++)
+    {
+        free(columns[i].data);
+    }
+    input_close(&input);
+    return r;
+}
+
+static int do_decompose(const char *format, int argc, char *argv[])
+{
+    void (*decompose)(const char *, size_t, const semy_t *) = NULL;
+    struct key_field key;
+    size_t thread_count = 0;
+    bool bulk = false;
+
+    int r = parse_stream_options(&argc, &argv, &key, &thread_count);
+    if (r != EXIT_SUCCESS)
+    {
+        return r;
+    }
+
+    if (thread_count > 0 && strcmp(format, "ndjson") != 0 && strcmp(format, "tsv") != 0)
+    {
+        cli_fprintf(stderr, "error: the '-j' option requires the 'ndjson' or 'tsv' format\n");
+        return EXIT_INVALID_OPTION;
+    }
+
+    if (strcmp(format, "columnar") == 0)
+    {
+        return decompose_columnar(&key, argc, argv);
+    }
+    else if (strcmp(format, "json") == 0)
+    {
+        decompose = decompose_json;
+    }
+    else if (strcmp(format, "xml") == 0)
+    {
+        decompose = decompose_xml;
+    }
+    else if (strcmp(format, "ndjson") == 0)
+    {
+        decompose = decompose_ndjson;
+        bulk = true;
+    }
+    else if (strcmp(format, "tsv") == 0)
+    {
+        decompose = decompose_tsv;
+        bulk = true;
+    }
+    else
+    {
+        cli_fprintf(stderr, "error: invalid format: '%s'\n", format);
+        return EXIT_INVALID_OPTION;
+    }
+
+    struct input input;
+    if (bulk && thread_count > 0)
+    {
+        r = run_pipeline(argc, argv, &key, thread_count, decompose);
+        if (r != -1)
+        {
+            return r;
+        }
+    }
+
+    if (bulk)
+    {
+        input_init(&input, argc, argv, &key, false);
+        r = decompose_each(&input, decompose);
+        input_close(&input);
+        return r;
+    }
+
+    const char *versions[2] = {NULL, NULL};
+    size_t lengths[2] = {0, 0};
+    input_init(&input, argc, argv, &key, true);
+
+    // Read up to two versions to verify exactly one was provided.
+    for (int i = 0; i < 2; i++)
+    {
+        r = input_next(&input, &versions[i], &lengths[i]);
+        if (r != EXIT_SUCCESS)
+        {
+            input_close(&input);
+            return r;
+        }
+    }
+
+    if (versions[0] == NULL || versions[1] != NULL)
+    {
+        cli_fprintf(stderr, "error: expected exactly one version string\n");
+        input_close(&input);
+        return EXIT_INVALID_OPTION;
+    }
+
+    // Reading the versions stopped timing, which resumes for the one that's parsed.
+    semy_t semver = {0};
+    stats_parse_begin();
+    r = parse(versions[0], lengths[0], &semver);
+    if (r == EXIT_SUCCESS)
+    {
+        decompose(versions[0], lengths[0], &semver);
+    }
+
+    input_close(&input);
+    return r;
+}
+
+static int do_build_index(int argc, char *argv[])
+{
+    struct input input;
+    struct key_field key;
+    const char **versions = NULL;
+    size_t *lengths = NULL;
+    void *index = NULL;
+    size_t capacity = 0;
+    size_t count = 0;
+    int r = parse_key_options(&argc, &argv, &key);
+    if (r != EXIT_SUCCESS)
+    {
+        return r;
+    }
+
+    if (argc < 1)
+    {
+        cli_fprintf(stderr, "error: expected an index file name\n");
+        return EXIT_INVALID_OPTION;
+    }
+
+    input_init(&input, argc - 1, argv + 1, &key, true);
+
+    for (;;)
+    {
+        const char *version = NULL;
+        size_t length = 0;
+        r = input_next(&input, &version, &length);
+        if (r != EXIT_SUCCESS || version == NULL)
+        {
+            break;
+        }
+
+        semy_t semver;
+        r = parse(version, length, &semver);
+        if (r != EXIT_SUCCESS)
+        {
+            break;
+        }
+
+        if (count == capacity)
+        {
+            capacity = (capacity == 0) ? 64 : capacity * 2;
+            const char **grown_versions = cli_calloc(capacity, sizeof(versions[0]));
+            size_t *grown_lengths = cli_calloc(capacity, sizeof(lengths[0]));
+            if (grown_versions == NULL || grown_lengths == NULL)
+            {
+                free((void *)grown_versions);
+                free(grown_lengths);
+                cli_fprintf(stderr, "error: memory allocation failed\n");
+                r = EXIT_OUT_OF_MEMORY;
+                break;
+            }
+            if (count > 0)
+            {
+                memcpy((void *)grown_versions, (const void *)versions, count * sizeof(versions[0]));
+                memcpy(grown_lengths, lengths, count * sizeof(lengths[0]));
+            }
+            free((void *)versions);
+            free(lengths);
+            versions = grown_versions;
+            lengths = grown_lengths;
+        }
+
+        versions[count] = version;
+        lengths[count] = length;
+        count += 1;
+    }
+
+    if (r == EXIT_SUCCESS)
+    {
+        size_t size = 0;
+        semy_index_build(versions, lengths, count, NULL, &size);
+
+        index = cli_calloc(1, size);
+        if (index == NULL)
+        {
+            cli_fprintf(stderr, "error: memory allocation failed\n");
+            r = EXIT_OUT_OF_MEMORY;
+        }
+        else if (semy_index_build(versions, lengths, count, index, &size) != SEMY_NO_ERROR)
+        {
+            // LCOV_EXCL_START
+            cli_fprintf(stderr, "error: internal malfunction\n");
+            r = EXIT_GENERAL_ERROR;
+            // LCOV_EXCL_STOP
+        }
+        else if (!cli_write_file(argv[0], index, size))
+        {
+            cli_fprintf(stderr, "error: cannot write file '%s'\n", argv[0]);
+            r = EXIT_GENERAL_ERROR;
+        }
+    }
+
+    input_close(&input);
+    free((void *)versions);
+    free(lengths);
+    free(index);
+    return r;
+}
+
+// Prints the indexed versions in [v1, v2] where 'v2' is 'v1' when only one version is given.
+static int query_index(const semy_index_t *index, int argc, char *argv[])
+{
+    semy_t semvers[2];
+    size_t lower = 0;
+    size_t upper = 0;
+    size_t ignored = 0;
+
+    stats_parse_begin();
+    for (int i = 0; i < argc; i++)
+    {
+        const int r = parse(argv[i], strlen(argv[i]), &semvers[i]);
+        if (r != EXIT_SUCCESS)
+        {
+            stats_parse_end();
+            return r;
+        }
+    }
+    stats_parse_end();
+
+    if (semy_index_search(index, &semvers[0], &lower, &ignored) != SEMY_NO_ERROR ||
+        semy_index_search(index, &semvers[argc - 1], &ignored, &upper) != SEMY_NO_ERROR)
+    {
+        cli_fprintf(stderr, "error: invalid index file\n");
+        return EXIT_GENERAL_ERROR;
+    }
+
+    for (size_t i = lower; i < upper; i++)
+    {
+        const char *version = semy_index_get(index, i);
+        if (version == NULL)
+        {
+            cli_fprintf(stderr, "error: invalid index file\n");
+            return EXIT_GENERAL_ERROR;
+        }
+        output_line(version);
+    }
+    return EXIT_SUCCESS;
+}
+
+static int do_query_index(int argc, char *argv[])
+{
+    if (argc < 2 || argc > 3)
+    {
+        cli_fprintf(stderr, "error: expected an index file name followed by one or two versions\n");
+        return EXIT_INVALID_OPTION;
+    }
+
+    const char *path = argv[0];
+    const void *data = NULL;
+    size_t size = 0;
+
+#if defined(HAVE_POSIX_IO)
+    struct mapping *mapping = NULL;
+    int r = map_file(path, false, &mapping);
+    if (r != EXIT_SUCCESS)
+    {
+        return r;
+    }
+
+    if (mapping != NULL)
+    {
+        data = mapping->data;
+        size = mapping->size;
+    }
+#else
+    // Without memory mapping, read the index into memory.
+    char *buffer = NULL;
+    size_t capacity = 0;
+    int r = EXIT_SUCCESS;
+
+    FILE *stream = cli_fopen(path);
+    if (stream == NULL)
+    {
+        cli_fprintf(stderr, "error: cannot open file '%s'\n", path);
+        return EXIT_GENERAL_ERROR;
+    }
 
-#define EXIT_BAD_SYNTAX 1
-#define EXIT_INVALID_OPTION 2
-#define EXIT_GENERAL_ERROR 3
-#define EXIT_OUT_OF_MEMORY 4
+    for (;;)
+    {
+        if (size == capacity)
+        {
+            capacity = (capacity == 0) ? READ_BLOCK_SIZE : capacity * 2;
+            char *grown = cli_calloc(1, capacity);
+            if (grown == NULL)
+            {
+                fclose(stream);
+                free(buffer);
+                cli_fprintf(stderr, "error: memory allocation failed\n");
+                return EXIT_OUT_OF_MEMORY;
+            }
+            if (size > 0)
+            {
+                memcpy(grown, buffer, size);
+            }
+            free(buffer);
+            buffer = grown;
+        }
+
+        const double start = stats_clock();
+        const size_t count = cli_fread(&buffer[size], capacity - size, stream);
+        run_stats.read += stats_clock() - start;
+        run_stats.bytes += count;
+        if (count == 0)
+        {
+            break;
+        }
+        size += count;
+    }
+    fclose(stream);
+    data = buffer;
+#endif
+
+    semy_index_t index;
+    if (data == NULL || semy_index_open(&index, data, size) != SEMY_NO_ERROR)
+    {
+        cli_fprintf(stderr, "error: invalid index file '%s'\n", path);
+        r = EXIT_GENERAL_ERROR;
+    }
+    else
+    {
+        r = query_index(&index, argc - 1, argv + 1);
+    }
+
+#if defined(HAVE_POSIX_IO)
+    if (mapping != NULL)
+    {
+        unmap_file(mapping);
+    }
+#else
+    free(buffer);
+#endif
+    return r;
+}
 
-struct semver
+// State kept by --serve across requests.
+struct server
 {
-    const char *string;
-    semy_t value;
+    struct sort_key *keys; // Reused by every 'sort' request.
+    size_t capacity;
 };
 
-// LCOV_EXCL_START
-static void cli_fprintf(FILE *stream, const char *format, ...)
+// Splits the next token, delimited by spaces or tabs, off the remainder of a request.
+static bool next_token(const char **cursor, const char *end, const char **token, size_t *length)
 {
-    va_list args;
-    va_start(args, format);
-    vfprintf(stream, format, args);
-    va_end(args);
-}
-// LCOV_EXCL_STOP
+    const char *s = *cursor;
+    while (s < end && (*s == ' ' || *s == '\t'))
+    {
+        s += 1;
+    }
 
-static void cli_puts(const char *s)
-{
-    cli_fprintf(stdout, "%s\n", s);
+    *token = s;
+    while (s < end && *s != ' ' && *s != '\t')
+    {
+        s += 1;
+    }
+
+    *length = (size_t)(s - *token);
+    *cursor = s;
+    return *length > 0;
 }
 
-static void *cli_calloc(size_t count, size_t size)
+static size_t count_tokens(const char *cursor, const char *end)
 {
-    return calloc(count, size);
+    const char *token;
+    size_t length;
+    size_t count = 0;
+    while (next_token(&cursor, end, &token, &length))
+    {
+        count += 1;
+    }
+    return count;
 }
 
-static int compare_semvers(const void *a, const void *b)
+// Responses are a single line: the exit status the equivalent command would
+// return followed by what it would print to stdout or, on failure, stderr.
+static void serve_error(int status, const char *message)
 {
-    const struct semver *x = (const struct semver *)a;
-    const struct semver *y = (const struct semver *)b;
-    int32_t result = 0;
-    semy_compare(&x->value, &y->value, &result);
-    return (int)result;
+    output_int(status);
+    output_string(" error: ");
+    output_string(message);
+    output_char('\n');
 }
 
-static int parse(const char *string, semy_t *semvar)
+static bool serve_parse(const char *token, size_t length, semy_t *semver)
 {
-    const semy_error_t err = semy_parse(semvar, sizeof(semvar[0]), string);
-    if (err == SEMY_BAD_SYNTAX)
+    const char *message;
+    const int r = parse_status(parse_version(token, length, semver), &message);
+    if (r != EXIT_SUCCESS)
     {
-        cli_fprintf(stderr, "error: invalid semantic version\n");
-        return EXIT_BAD_SYNTAX;
+        serve_error(r, message);
+        return false;
     }
-    else if (err == SEMY_LIMITS_EXCEEDED)
+    return true;
+}
+
+static void serve_compare(const char *cursor, const char *end)
+{
+    semy_t semvers[2];
+    const char *token;
+    size_t length;
+
+    if (count_tokens(cursor, end) != 2)
     {
-        cli_fprintf(stderr, "error: semantic version is too complex for this implementation\n");
-        return EXIT_GENERAL_ERROR;
+        serve_error(EXIT_INVALID_OPTION, "expected exactly two version strings");
+        return;
     }
-    // LCOV_EXCL_START
-    else if (err != SEMY_NO_ERROR)
+
+    for (int i = 0; i < 2; i++)
     {
-        cli_fprintf(stderr, "error: internal malfunction\n");
-        return EXIT_GENERAL_ERROR;
+        next_token(&cursor, end, &token, &length);
+        if (!serve_parse(token, length, &semvers[i]))
+        {
+            return;
+        }
     }
-    // LCOV_EXCL_STOP
-    return EXIT_SUCCESS;
+
+    int32_t result = 0;
+    semy_compare(&semvers[0], &semvers[1], &result);
+
+    output_string("0 ");
+    output_int(result);
+    output_char('\n');
 }
 
-static int do_validate(int argc, char *argv[])
+static void serve_validate(const char *cursor, const char *end)
 {
-    for (int i = 0; i < argc; i++)
+    const char *token;
+    size_t length;
+
+    while (next_token(&cursor, end, &token, &length))
     {
-        semy_t semver = {0};
-        const int r = parse(argv[i], &semver);
-        if (r != EXIT_SUCCESS)
+        semy_t semver;
+        if (!serve_parse(token, length, &semver))
         {
-            return r;
+            return;
         }
     }
-    return EXIT_SUCCESS;
+    output_line("0");
 }
 
-static int do_sort(int argc, char *argv[])
+// Parses a comparator: a version optionally prefixed with one of the
+// operators =, <, <=, >, or >=. A version without an operator must be equal.
+static bool serve_comparator(const char *token, size_t length, const char **op, semy_t *semver)
 {
-    struct semver *semvers = cli_calloc(argc, sizeof(semvers[0]));
-    if (semvers == NULL)
+    size_t prefix = 0;
+    while (prefix < length && prefix < 2 && strchr("<>=", token[prefix]) != NULL)
     {
-        cli_fprintf(stderr, "error: memory allocation failed\n");
-        return EXIT_OUT_OF_MEMORY;
+        prefix += 1;
     }
 
-    for (int i = 0; i < argc; i++)
+    static const char *const operators[] = {"=", "<", "<=", ">", ">="};
+    *op = "=";
+    if (prefix > 0)
     {
-        struct semver *semver = &semvers[i];
-        semver->string = argv[i];
-        const int r = parse(semver->string, &semver->value);
-        if (r != EXIT_SUCCESS)
+        *op = NULL;
+        for (size_t i = 0; i < sizeof(operators) / sizeof(operators[0]); i++)
         {
-            free(semvers);
-            return r;
+            if (strlen(operators[i]) == prefix && memcmp(operators[i], token, prefix) == 0)
+            {
+                *op = operators[i];
+            }
         }
-    }
 
-    qsort(semvers, argc, sizeof(semvers[0]), compare_semvers);
+        if (*op == NULL)
+        {
+            serve_error(EXIT_BAD_SYNTAX, "invalid comparator");
+            return false;
+        }
+    }
+    return serve_parse(token + prefix, length - prefix, semver);
+}
 
-    for (int i = 0; i < argc; i++)
+static bool compare_satisfies(const char *op, int32_t result)
+{
+    switch (op[0])
     {
-        cli_puts(semvers[i].string);
+    case '<':
+        return (op[1] == '=') ? (result <= 0) : (result < 0);
+    case '>':
+        return (op[1] == '=') ? (result >= 0) : (result > 0);
+    default:
+        return result == 0;
     }
-
-    free(semvers);
-    return EXIT_SUCCESS;
 }
 
-static int do_compare(int argc, char *argv[])
+// Answers whether a version satisfies every comparator that follows it.
+static void serve_satisfies(const char *cursor, const char *end)
 {
-    semy_t semvers[2] = {0};
-    semy_error_t err;
+    semy_t semver;
+    const char *token;
+    size_t length;
+    bool satisfied = true;
 
-    if (argc != 2)
+    if (count_tokens(cursor, end) < 2)
     {
-        cli_fprintf(stderr, "error: expected exactly two version strings\n");
-        return EXIT_INVALID_OPTION;
+        serve_error(EXIT_INVALID_OPTION, "expected a version followed by one or more comparators");
+        return;
     }
 
-    for (int i = 0; i < 2; i++)
+    next_token(&cursor, end, &token, &length);
+    if (!serve_parse(token, length, &semver))
     {
-        const int r = parse(argv[i], &semvers[i]);
-        if (r != EXIT_SUCCESS)
+        return;
+    }
+
+    while (next_token(&cursor, end, &token, &length))
+    {
+        const char *op;
+        semy_t bound;
+        if (!serve_comparator(token, length, &op, &bound))
         {
-            return r;
+            return;
         }
-    }
 
-    int32_t result = 0;
-    semy_compare(&semvers[0], &semvers[1], &result);
+        int32_t result = 0;
+        semy_compare(&semver, &bound, &result);
+        satisfied = satisfied && compare_satisfies(op, result);
+    }
 
-    cli_fprintf(stdout, "%d\n", result);
-    return EXIT_SUCCESS;
+    output_line(satisfied ? "0 true" : "0 false");
 }
 
-static int do_decompose(const char *format, int argc, char *argv[])
+// Answers with the versions sorted in ascending order, separated by spaces.
+static void serve_sort(struct server *server, const char *cursor, const char *end)
 {
-    enum { INVALID, JSON, XML } target = INVALID;
+    const char *token;
+    size_t length;
+    size_t count = 0;
 
-    if (strcmp(format, "json") == 0)
+    while (next_token(&cursor, end, &token, &length))
     {
-        target = JSON;
+        semy_t semver;
+        if (!serve_parse(token, length, &semver))
+        {
+            return;
+        }
+
+        if (count == server->capacity)
+        {
+            const size_t capacity = (count == 0) ? 64 : count * 2;
+            struct sort_key *grown = cli_calloc(capacity, sizeof(grown[0]));
+            if (grown == NULL)
+            {
+                serve_error(EXIT_OUT_OF_MEMORY, "memory allocation failed");
+                return;
+            }
+            if (count > 0)
+            {
+                memcpy(grown, server->keys, count * sizeof(grown[0]));
+            }
+            free(server->keys);
+            server->keys = grown;
+            server->capacity = capacity;
+        }
+        fill_sort_key(&server->keys[count++], token, length, token, length, &semver);
     }
-    else if (strcmp(format, "xml") == 0)
+
+    // The keys are null until the first request with versions.
+    if (count > 0)
     {
-        target = XML;
+        qsort(server->keys, count, sizeof(server->keys[0]), compare_sort_keys);
     }
-    else
+
+    output_char('0');
+    for (size_t i = 0; i < count; i++)
     {
-        cli_fprintf(stderr, "error: invalid format: '%s'\n", format);
-        return EXIT_INVALID_OPTION;
+        output_char(' ');
+        output_write(server->keys[i].string, server->keys[i].length);
+    }
+    output_char('\n');
+}
+
+// Answers a single request. Returns false if the client asked to quit.
+static bool serve_request(struct server *server, const char *line, size_t length)
+{
+    const char *cursor = line;
+    const char *end = line + length;
+    const char *name;
+    size_t name_length;
+
+    if (!next_token(&cursor, end, &name, &name_length))
+    {
+        return true; // A line of blanks is ignored like an empty line.
     }
 
-    if (argc != 1)
+#define REQUEST_IS(s) (name_length == sizeof(s) - 1 && memcmp(name, s, name_length) == 0)
+    if (REQUEST_IS("compare"))
     {
-        cli_fprintf(stderr, "error: expected exactly one version string\n");
-        return EXIT_INVALID_OPTION;
+        serve_compare(cursor, end);
+    }
+    else if (REQUEST_IS("validate"))
+    {
+        serve_validate(cursor, end);
+    }
+    else if (REQUEST_IS("satisfies"))
+    {
+        serve_satisfies(cursor, end);
+    }
+    else if (REQUEST_IS("sort"))
+    {
+        serve_sort(server, cursor, end);
+    }
+    else if (REQUEST_IS("quit"))
+    {
+        return false;
+    }
+    else
+    {
+        output_string("2 error: invalid request '");
+        output_write(name, name_length);
+        output_string("'\n");
     }
+#undef REQUEST_IS
+    return true;
+}
 
-    semy_t semver = {0};
-    const int r = parse(argv[0], &semver);
+// Returns true if the reader holds another complete request.
+static bool reader_pending(const struct reader *reader)
+{
+    return memchr(&reader->current->data[reader->begin], '\n', reader->end - reader->begin) != NULL;
+}
+
+// Answers requests from 'stream' until it ends or the client quits. Responses are
+// flushed once no further request is buffered so pipelined requests are answered
+// with few writes while a client waiting on each response is never kept waiting.
+// Responses still buffered when the client quits or its input ends are flushed
+// before returning since a socket client's stream is closed afterward.
+static int serve_stream(struct server *server, FILE *stream)
+{
+    struct reader reader;
+    int r = reader_open(&reader, NULL, NULL);
     if (r != EXIT_SUCCESS)
     {
         return r;
     }
+    reader.stream = stream;
+    reader.interactive = true;
 
-    if (target == JSON)
+    for (;;)
     {
-        cli_puts("{");
-        cli_fprintf(stdout, "    \"raw\": \"%s\",\n", argv[0]);
-        cli_fprintf(stdout, "    \"major\": %d,\n", semy_get_major(&semver));
-        cli_fprintf(stdout, "    \"minor\": %d,\n", semy_get_minor(&semver));
-        cli_fprintf(stdout, "    \"patch\": %d,\n", semy_get_patch(&semver));
-
-        const int32_t pre_release_count = semy_get_pre_release_count(&semver);
-        if (pre_release_count > 0)
-        {
-            cli_puts("    \"preRelease\": [");
-            for (int32_t i = 0; i < pre_release_count; i++)
-            {
-                cli_fprintf(stdout, "        \"%s\"", semy_get_pre_release(&semver, i));
-                if (i < pre_release_count - 1)
-                {
-                    cli_puts(",");
-                }
-                else
-                {
-                    cli_puts("");
-                }
-            }
-            cli_puts("    ],");
-        }
-        else
+        const char *line = NULL;
+        size_t length = 0;
+        r = reader_next(&reader, &line, &length);
+        if (r != EXIT_SUCCESS || line == NULL)
         {
-            cli_puts("    \"preRelease\": [],");
+            break;
         }
 
-        const int32_t build_metadata_count = semy_get_build_count(&semver);
-        if (build_metadata_count > 0)
+        if (!serve_request(server, line, length))
         {
-            cli_puts("    \"buildMetadata\": [");
-            for (int32_t i = 0; i < build_metadata_count; i++)
-            {
-                cli_fprintf(stdout, "        \"%s\"", semy_get_build(&semver, i));
-                if (i < build_metadata_count - 1)
-                {
-                    cli_puts(",");
-                }
-                else
-                {
-                    cli_puts("");
-                }
-            }
-            cli_puts("    ]");
+            break;
         }
-        else
+
+        if (!reader_pending(&reader) && !output_flush())
         {
-            cli_puts("    \"buildMetadata\": []");
+            break; // LCOV_EXCL_LINE
         }
+    }
+
+    output_flush();
+    reader_close(&reader);
+    return r;
+}
+
+#if defined(HAVE_POSIX_IO)
+// LCOV_EXCL_START
+// A client of the socket server.
+struct session
+{
+    struct server server;
+    FILE *stream;
+    int fd;
+};
+
+// Answers a client on its own thread. Output is thread local so each session has its own.
+static void *serve_session(void *context)
+{
+    struct session *session = context;
+    output.fd = session->fd;
+    output.length = 0;
+    output.failed = false;
+
+    serve_stream(&session->server, session->stream);
+
+    fclose(session->stream);
+    free(session->server.keys);
+    free(session);
+    return NULL;
+}
+
+// Listens on a Unix domain socket and answers each client that connects on its own thread
+// until the process is terminated. A stale socket left by a previous server is replaced.
+static int serve_socket(const char *path)
+{
+    struct sockaddr_un address;
+    memset(&address, 0, sizeof(address));
+    address.sun_family = AF_UNIX;
 
-        cli_puts("}");
+    if (strlen(path) >= sizeof(address.sun_path))
+    {
+        cli_fprintf(stderr, "error: socket path '%s' is too long\n", path);
+        return EXIT_INVALID_OPTION;
     }
-    else
+    memcpy(address.sun_path, path, strlen(path));
+
+    struct stat status;
+    if (lstat(path, &status) == 0 && S_ISSOCK(status.st_mode))
     {
-        cli_puts("<?xml version=\"1.0\" encoding=\"utf-8\"?>");
-        cli_puts("<semver>");
-        cli_fprintf(stdout, "    <raw>%s</raw>\n", argv[0]);
-        cli_fprintf(stdout, "    <major>%d</major>\n", semy_get_major(&semver));
-        cli_fprintf(stdout, "    <minor>%d</minor>\n", semy_get_minor(&semver));
-        cli_fprintf(stdout, "    <patch>%d</patch>\n", semy_get_patch(&semver));
+        unlink(path);
+    }
 
-        const int32_t pre_release_count = semy_get_pre_release_count(&semver);
-        if (pre_release_count > 0)
-        {
-            cli_puts("    <preRelease>");
-            for (int32_t i = 0; i < pre_release_count; i++)
-            {
-                cli_fprintf(stdout, "        <identifier>%s</identifier>\n", semy_get_pre_release(&semver, i));
-            }
-            cli_puts("    </preRelease>");
-        }
-        else
+    const int listener = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (listener < 0 ||
+        bind(listener, (const struct sockaddr *)&address, sizeof(address)) != 0 ||
+        listen(listener, SOMAXCONN) != 0)
+    {
+        cli_fprintf(stderr, "error: cannot listen on socket '%s'\n", path);
+        if (listener >= 0)
         {
-            cli_puts("    <preRelease></preRelease>");
+            close(listener);
         }
+        return EXIT_GENERAL_ERROR;
+    }
+
+    // A client that disconnects early must end its session, not the server.
+    signal(SIGPIPE, SIG_IGN);
+
+    // The server runs until it's terminated so its statistics could never be printed.
+    run_stats.enabled = false;
+
+    pthread_attr_t attributes;
+    pthread_attr_init(&attributes);
+    pthread_attr_setdetachstate(&attributes, PTHREAD_CREATE_DETACHED);
 
-        const int32_t build_metadata_count = semy_get_build_count(&semver);
-        if (build_metadata_count > 0)
+    for (;;)
+    {
+        const int fd = accept(listener, NULL, NULL);
+        if (fd < 0)
         {
-            cli_puts("    <buildMetadata>");
-            for (int32_t i = 0; i < build_metadata_count; i++)
+            if (errno == EINTR || errno == ECONNABORTED)
             {
-                cli_fprintf(stdout, "        <identifier>%s</identifier>\n", semy_get_build(&semver, i));
+                continue;
             }
-            cli_puts("    </buildMetadata>");
+            cli_fprintf(stderr, "error: cannot accept connection on socket '%s'\n", path);
+            break;
         }
-        else
+
+        struct session *session = cli_calloc(1, sizeof(session[0]));
+        FILE *stream = (session != NULL) ? fdopen(fd, "rb") : NULL;
+        if (stream == NULL)
         {
-            cli_puts("    <buildMetadata></buildMetadata>");
+            free(session);
+            close(fd);
+            continue;
         }
 
-        cli_puts("</semver>");
+        session->stream = stream;
+        session->fd = fd;
+
+        // If a thread cannot be started, the client is served before accepting another.
+        pthread_t thread;
+        if (pthread_create(&thread, &attributes, serve_session, session) != 0)
+        {
+            const int stdout_fd = output.fd;
+            serve_session(session);
+            output.fd = stdout_fd;
+            output.length = 0;
+            output.failed = false;
+        }
     }
 
-    return EXIT_SUCCESS;
+    pthread_attr_destroy(&attributes);
+    close(listener);
+    return EXIT_GENERAL_ERROR;
+}
+// LCOV_EXCL_STOP
+#endif
+
+static int do_serve(int argc, char *argv[])
+{
+    struct server server = {0};
+    int r;
+
+    if (argc > 1)
+    {
+        cli_fprintf(stderr, "error: expected at most one socket path\n");
+        return EXIT_INVALID_OPTION;
+    }
+
+    if (argc == 0)
+    {
+        r = serve_stream(&server, stdin);
+    }
+    else
+    {
+#if defined(HAVE_POSIX_IO)
+        r = serve_socket(argv[0]); // LCOV_EXCL_LINE
+#else
+        cli_fprintf(stderr, "error: sockets are unsupported on this platform\n");
+        r = EXIT_GENERAL_ERROR;
+#endif
+    }
+
+    free(server.keys);
+    return r;
 }
 
 static void print_usage(void)
 {
-    cli_puts("Usage:");
-    cli_puts("");
-    cli_puts("  semver --compare <version1> <version2>");
-    cli_puts("  semver --decompose=<format> <version>");
-    cli_puts("  semver --sort <version>...");
-    cli_puts("  semver --validate <version>...");
-    cli_puts("");
+    output_line("Usage:");
+    output_line("");
+    output_line("  semver --compare <version1> <version2>");
+    output_line("  semver --decompose=<format> [-j <threads>] <version>...");
+    output_line("  semver --sort <version>...");
+    output_line("  semver --validate [-j <threads>] <version>...");
+    output_line("  semver --report [-m] [-j <threads>] <version>...");
+    output_line("  semver --build-index <file> <version>...");
+    output_line("  semver --query-index <file> <version> [<version>]");
+    output_line("  semver --serve [<socket>]");
+    output_line("  semver --stats <command>");
+    output_line("");
+    output_line("With --decompose, --sort, --validate, --report, and --build-index, a <version>");
+    output_line("of '-' reads versions from stdin and '-f <file>' reads them from a file, one");
+    output_line("per line. Leading '-k <field>' and '-t <char>' options select the version");
+    output_line("from a field of each line, delimited by 'char' (default: tab), and --sort and");
+    output_line("--report print the whole line.");
+    output_line("");
 }
 
 static int do_usage(void)
 {
     print_usage();
-    cli_puts("Run 'semver --help' for more information.");
+    output_line("Run 'semver --help' for more information.");
     return EXIT_SUCCESS;
 }
 
 static int do_help(void)
 {
     print_usage();
-    cli_puts("Options:");
-    cli_puts("");
-    cli_puts("  -c <v1> <version2>");
-    cli_puts("  --compare <version1> <version2>");
-    cli_puts("       Compare semantic versions 'v1' and 'v2' and print -1, 0, 1 depending");
-    cli_puts("       on if v1 < v2, v1 = v2, v1 > v2 (respectively).");
-    cli_puts("");
-    cli_puts("  -d<format> <version>");
-    cli_puts("  -decompose=<format> <version>");
-    cli_puts("       Decompose a semantic version into its identifiers.");
-    cli_puts("");
-    cli_puts("  -s <versions>...");
-    cli_puts("  --sort <versions>...");
-    cli_puts("       Sort semantic versions and print them in ascending order on their");
-    cli_puts("       own line to stdout.");
-    cli_puts("");
-    cli_puts("  -v <versions>...");
-    cli_puts("  --validate <versions>...");
-    cli_puts("       Validate one or more semantic versions. If any semantic version is");
-    cli_puts("       invalid, the exit status will be 1.");
-    cli_puts("");
-    cli_puts("Exit status:");
-    cli_puts("  0  if OK,");
-    cli_puts("  1  if one or more semantic versions are malformed,");
-    cli_puts("  2  if the program arguments are incorrect,");
-    cli_puts("  3  if a general error occurred while processing the input.");
-    cli_puts("");
-    cli_puts("This program is distributed under the MIT License.");
+    output_line("Options:");
+    output_line("");
+    output_line("  -c <v1> <version2>");
+    output_line("  --compare <version1> <version2>");
+    output_line("       Compare semantic versions 'v1' and 'v2' and print -1, 0, 1 depending");
+    output_line("       on if v1 < v2, v1 = v2, v1 > v2 (respectively).");
+    output_line("");
+    output_line("  -d<format> [-j <threads>] <version>...");
+    output_line("  -decompose=<format> [-j <threads>] <version>...");
+    output_line("       Decompose semantic versions into their identifiers. The 'json' and");
+    output_line("       'xml' formats accept exactly one version. The 'ndjson' and 'tsv'");
+    output_line("       formats accept any number of versions and print one per line.");
+    output_line("       The 'columnar' format writes binary column arrays (see semy(1)).");
+    output_line("       With -j, the 'ndjson' and 'tsv' formats read the input on one thread,");
+    output_line("       parse it on 'threads' threads, and print it on another.");
+    output_line("");
+    output_line("  -s <versions>...");
+    output_line("  --sort <versions>...");
+    output_line("       Sort semantic versions and print them in ascending order on their");
+    output_line("       own line to stdout.");
+    output_line("");
+    output_line("  -v [-j <threads>] <versions>...");
+    output_line("  --validate [-j <threads>] <versions>...");
+    output_line("       Validate one or more semantic versions. If any semantic version is");
+    output_line("       invalid, the exit status will be 1. With -j, the input is read on");
+    output_line("       one thread and validated on 'threads' threads.");
+    output_line("");
+    output_line("  -r [-m] [-j <threads>] <versions>...");
+    output_line("  --report [-m] [-j <threads>] <versions>...");
+    output_line("       Validate every semantic version using 'threads' threads (default: one");
+    output_line("       per processor) and print the source, line number, byte offset, status");
+    output_line("       ('ok', 'bad-syntax', or 'limits-exceeded'), error position in the line,");
+    output_line("       and text of each version, tab separated, in input order. With -m only");
+    output_line("       the malformed versions are printed. If any semantic version is");
+    output_line("       invalid, the exit status will be 1.");
+    output_line("");
+    output_line("  --build-index <file> <versions>...");
+    output_line("       Write an index of the semantic versions, sorted by precedence, to");
+    output_line("       'file'. The index is memory mapped by --query-index without parsing.");
+    output_line("");
+    output_line("  --query-index <file> <version1> [<version2>]");
+    output_line("       Print the indexed versions equal in precedence to 'version1', or");
+    output_line("       those from 'version1' to 'version2' inclusive, in ascending order.");
+    output_line("");
+    output_line("  --serve [<socket>]");
+    output_line("       Answer requests, one per line, read from stdin or from clients of the");
+    output_line("       Unix domain socket 'socket'. The requests are 'compare <v1> <v2>',");
+    output_line("       'validate <version>...', 'satisfies <version> <comparator>...',");
+    output_line("       'sort <version>...', and 'quit'. Each is answered on a single line");
+    output_line("       with the exit status then the output or error of the equivalent");
+    output_line("       command (see semy(1)). Each client of the socket is served on its");
+    output_line("       own thread.");
+    output_line("");
+    output_line("  --stats <command>");
+    output_line("       Run the command, e.g. '--sort -f <file>', then print the versions");
+    output_line("       parsed, bytes read, seconds spent reading the input, parsing (summed");
+    output_line("       over threads), sorting, and writing the output, peak memory, and");
+    output_line("       versions parsed per second to stderr.");
+    output_line("");
+    output_line("Exit status:");
+    output_line("  0  if OK,");
+    output_line("  1  if one or more semantic versions are malformed,");
+    output_line("  2  if the program arguments are incorrect,");
+    output_line("  3  if a general error occurred while processing the input.");
+    output_line("");
+    output_line("This program is distributed under the MIT License.");
     return EXIT_SUCCESS;
 }
 
 static int do_version(void)
 {
-    cli_puts("0.9.0");
+    output_line("0.9.0");
     return EXIT_SUCCESS;
 }
 
-static int cli_main(int argc, char *argv[])
+// Prints how much the command run since 'start' processed and where its time went to stderr.
+static void print_stats(double start)
+{
+    output_flush();
+    const double total = cli_clock() - start;
+
+    cli_fprintf(stderr, "items: %llu\n", (unsigned long long)run_stats.items);
+    cli_fprintf(stderr, "bytes read: %llu\n", (unsigned long long)run_stats.bytes);
+    cli_fprintf(stderr, "read time: %.6f s\n", run_stats.read);
+    cli_fprintf(stderr, "parse time: %.6f s\n", run_stats.parse);
+    cli_fprintf(stderr, "sort time: %.6f s\n", run_stats.sort);
+    cli_fprintf(stderr, "output time: %.6f s\n", run_stats.output);
+    cli_fprintf(stderr, "total time: %.6f s\n", total);
+    cli_fprintf(stderr, "peak memory: %llu KiB\n", (unsigned long long)cli_peak_memory());
+    cli_fprintf(stderr, "items per second: %.0f\n", (total > 0.0) ? (double)run_stats.items / total : 0.0);
+    run_stats.enabled = false;
+}
+
+static int run_command(int argc, char *argv[])
 {
     if (argc > 1)
     {
@@ -391,6 +3856,37 @@ static int cli_main(int argc, char *argv[])
         {
             return do_validate(argc - 2, argv + 2);
         }
+
+        if (strcmp(arg, "-r") == 0 ||
+            strcmp(arg, "--report") == 0)
+        {
+            return do_report(argc - 2, argv + 2);
+        }
+
+        if (strcmp(arg, "--build-index") == 0)
+        {
+            return do_build_index(argc - 2, argv + 2);
+        }
+
+        if (strcmp(arg, "--query-index") == 0)
+        {
+            return do_query_index(argc - 2, argv + 2);
+        }
+
+        if (strcmp(arg, "--serve") == 0)
+        {
+            return do_serve(argc - 2, argv + 2);
+        }
+
+        if (strcmp(arg, "--stats") == 0)
+        {
+            memset(&run_stats, 0, sizeof(run_stats));
+            run_stats.enabled = true;
+            const double start = cli_clock();
+            const int r = run_command(argc - 1, argv + 1);
+            print_stats(start);
+            return r;
+        }
         
         if (arg[0] == '-')
         {
@@ -401,6 +3897,29 @@ static int cli_main(int argc, char *argv[])
     return do_usage();
 }
 
+// The benchmarks run commands through run_command() with their output discarded.
+#ifndef BENCHMARKING
+static int cli_main(int argc, char *argv[])
+{
+    output.fd = 1;
+    output.length = 0;
+    output.failed = false;
+
+    int r = run_command(argc, argv);
+    if (!output_flush())
+    {
+        // LCOV_EXCL_START
+        cli_fprintf(stderr, "error: failed to write output\n");
+        if (r == EXIT_SUCCESS)
+        {
+            r = EXIT_GENERAL_ERROR;
+        }
+        // LCOV_EXCL_STOP
+    }
+    return r;
+}
+#endif
+
 // LCOV_EXCL_START
 #ifndef UNIT_TESTING
 int main(int argc, char *argv[])
@@ -16,6 +16,24 @@
 #include <string.h>
 #include <assert.h>
 
+#if !defined(__STDC_NO_ATOMICS__)
+#include <stdatomic.h>
+#endif
+
+// Static tracepoints for tracers such as bpftrace and SystemTap. Tracers set the semaphore
+// of a probe while they're attached to it, so probe arguments that cost something to
+// compute are only computed while traced. Otherwise each probe is a single no-op.
+#if defined(SEMY_USDT)
+#define _SDT_HAS_SEMAPHORES 1
+#include <sys/sdt.h>
+#define PROBE_SEMAPHORE(name) volatile unsigned short semy_##name##_semaphore __attribute__((section(".probes")))
+#define PROBE_ENABLED(name) __builtin_expect(semy_##name##_semaphore != 0, 0)
+PROBE_SEMAPHORE(parse_start);
+PROBE_SEMAPHORE(parse_done);
+PROBE_SEMAPHORE(compare_start);
+PROBE_SEMAPHORE(compare_done);
+#endif
+
 #define MAX_VERSION_LENGTH 200
 #define MAX_IDENTIFIERS 25
 
@@ -63,6 +81,23 @@ static_assert((offsetof(struct preRelease, numeric_value) % 4) == 0, "expected 3
 static_assert((offsetof(struct preRelease, string_value) % 2) == 0, "expected 16-bit alignment");
 static_assert((offsetof(struct preRelease, is_alphanumeric) % 2) == 0, "expected 16-bit alignment");
 
+// The compact layouts store the same identifier strings as 'semVer' but not their
+// offsets or numeric values, which are recovered by scanning the strings instead.
+// The layout field is the negated size of the layout; it overlaps the major version
+// of 'semVer' which is never negative so the layouts can be told apart.
+struct semVerCompact
+{
+    int32_t layout;
+    int32_t versions[VERSION_CORE_COUNT];
+    uint8_t pre_release_count;
+    uint8_t build_metadata_count;
+    char strings[]; // Null-terminated pre-release identifiers followed by build identifiers.
+};
+
+static_assert(offsetof(struct semVerCompact, layout) == offsetof(struct semVer, versions[VERSION_CORE_MAJOR]), "expected the layout to overlap the major version");
+static_assert((offsetof(struct semVerCompact, versions) % 4) == 0, "expected 32-bit alignment");
+static_assert(sizeof(semy_compact32_t) == 32, "expected 32 bytes");
+static_assert(sizeof(semy_compact64_t) == 64, "expected 64 bytes");
 static_assert(sizeof(semy_t) == 512, "expected 0.5 kb");
 static_assert(sizeof(semy_error_t) == 4, "expected 4 bytes");
 
@@ -140,6 +175,7 @@ static semy_error_t parse_digits(const char *string, size_t *advance)
     }
     else
     {
+        *advance = 0;
         return SEMY_BAD_SYNTAX;
     }
 
@@ -170,6 +206,7 @@ static semy_error_t parse_numeric_identifier(const char *string, size_t *advance
     }
     else
     {
+        *advance = 0;
         return SEMY_BAD_SYNTAX;
     }
 
@@ -183,7 +220,7 @@ static semy_error_t parse_numeric_identifier(const char *string, size_t *advance
 }
 
 // <version-core> ::= <major> "." <minor> "." <patch>
-static semy_error_t parse_version_core(struct semVer *semver, const char *string, size_t *advance)
+static semy_error_t parse_version_core(int32_t versions[VERSION_CORE_COUNT], const char *string, size_t *advance)
 {
     const char *s = string;
     size_t len = 0;
@@ -193,12 +230,14 @@ static semy_error_t parse_version_core(struct semVer *semver, const char *string
     err = parse_numeric_identifier(s, &len);
     if (err != SEMY_NO_ERROR)
     {
+        *advance = s - string;
         return err;
     }
 
-    err = str2int(s, len, &semver->versions[VERSION_CORE_MAJOR]);
+    err = str2int(s, len, &versions[VERSION_CORE_MAJOR]);
     if (err != SEMY_NO_ERROR)
     {
+        *advance = s - string;
         return err;
     }
     s += len;
@@ -206,6 +245,7 @@ static semy_error_t parse_version_core(struct semVer *semver, const char *string
     // "."
     if (*s != '.')
     {
+        *advance = s - string;
         return SEMY_BAD_SYNTAX;
     }
     s += 1;
@@ -214,12 +254,14 @@ static semy_error_t parse_version_core(struct semVer *semver, const char *string
     err = parse_numeric_identifier(s, &len);
     if (err != SEMY_NO_ERROR)
     {
+        *advance = s - string;
         return err;
     }
 
-    err = str2int(s, len, &semver->versions[VERSION_CORE_MINOR]);
+    err = str2int(s, len, &versions[VERSION_CORE_MINOR]);
     if (err != SEMY_NO_ERROR)
     {
+        *advance = s - string;
         return err;
     }
     s += len;
@@ -227,6 +269,7 @@ static semy_error_t parse_version_core(struct semVer *semver, const char *string
     // "."
     if (*s != '.')
     {
+        *advance = s - string;
         return SEMY_BAD_SYNTAX;
     }
     s += 1;
@@ -235,12 +278,14 @@ static semy_error_t parse_version_core(struct semVer *semver, const char *string
     err = parse_numeric_identifier(s, &len);
     if (err != SEMY_NO_ERROR)
     {
+        *advance = s - string;
         return err;
     }
 
-    err = str2int(s, len, &semver->versions[VERSION_CORE_PATCH]);
+    err = str2int(s, len, &versions[VERSION_CORE_PATCH]);
     if (err != SEMY_NO_ERROR)
     {
+        *advance = s - string;
         return err;
     }
     s += len;
@@ -324,6 +369,7 @@ static semy_error_t parse_pre_release_identifier(const char *string, size_t *adv
         }
     }
     
+    *advance = 0;
     return SEMY_BAD_SYNTAX;
 }
 
@@ -381,12 +427,14 @@ static semy_error_t parse_pre_release(struct semVer *semver, const char *string,
         err = parse_pre_release_identifier(s, &len, &is_alnum);
         if (err != SEMY_NO_ERROR)
         {
+            *advance = s - string;
             return err;
         }
 
         err = add_pre_release_identifier(semver, is_alnum, s, len);
         if (err != SEMY_NO_ERROR)
         {
+            *advance = s - string;
             return err;
         }
         s += len;
@@ -451,12 +499,14 @@ static semy_error_t parse_build(struct semVer *semver, const char *string, size_
         err = parse_build_metadata(s, &len);
         if (err != SEMY_NO_ERROR)
         {
+            *advance = s - string;
             return err;
         }
 
         err = add_build_metadata(semver, s, len);
         if (err != SEMY_NO_ERROR)
         {
+            *advance = s - string;
             return err;
         }
         s += len;
@@ -474,47 +524,268 @@ static semy_error_t parse_build(struct semVer *semver, const char *string, size_
 
 // <valid semver> ::= <version-core>
 //                  | <version-core> [ "-" <pre-release> [ "+" <build> ] ]
-static semy_error_t parse_semver(struct semVer *semver, const char *string, size_t *advance)
+//
+// Like the functions above, this function populates 'advance' with the offset of the
+// byte where parsing failed if it fails. The 'production' is populated with the last
+// production parsed so extraneous characters are attributed to the one they follow.
+static semy_error_t parse_semver(struct semVer *semver, const char *string, size_t *advance, semy_production_t *production)
 {
     const char *s = string;
     size_t len = 0;
     semy_error_t err = SEMY_NO_ERROR;
 
-    err = parse_version_core(semver, s, &len);
+    *production = SEMY_PRODUCTION_VERSION_CORE;
+    err = parse_version_core(semver->versions, s, &len);
+    s += len;
     if (err != SEMY_NO_ERROR)
     {
+        *advance = s - string;
         return err;
     }
-    s += len;
 
     if (*s == '-')
     {
         s += 1;
+        *production = SEMY_PRODUCTION_PRE_RELEASE;
         err = parse_pre_release(semver, s, &len);
+        s += len;
         if (err != SEMY_NO_ERROR)
         {
+            *advance = s - string;
             return err;
         }
-        s += len;
     }
 
     if (*s == '+')
     {
         s += 1;
+        *production = SEMY_PRODUCTION_BUILD;
         err = parse_build(semver, s, &len);
+        s += len;
         if (err != SEMY_NO_ERROR)
         {
+            *advance = s - string;
             return err;
         }
-        s += len;
     }
 
     *advance = s - string;
     return SEMY_NO_ERROR;
 }
 
-SEMY_API semy_error_t semy_parse(semy_t *semver, size_t size, const char *version)
+// Parses a version into the full layout and populates 'offset' and 'production' as
+// documented by 'semy_parse_diagnose'.
+static semy_error_t parse_diagnosed(struct semVer *sv, const char *version, size_t *offset, semy_production_t *production)
+{
+    // Verify the version string is not unnecessarily long.
+    // 1 kb is more than enough for any legit version string.
+    for (size_t i = 0; version[i] != '\0'; i++)
+    {
+        if (i >= MAX_VERSION_LENGTH)
+        {
+            *offset = i;
+            *production = SEMY_PRODUCTION_NONE;
+            return SEMY_LIMITS_EXCEEDED;
+        }
+    }
+
+    static_assert(sizeof(sv->strings) > MAX_VERSION_LENGTH, "expected enough buffer space to contain string content");
+    memset(sv, 0, sizeof(sv[0]));
+
+    semy_error_t err = parse_semver(sv, version, offset, production);
+    if (err == SEMY_NO_ERROR)
+    {
+        // The semantic version string was parsed successfully.
+        // Now check for any extraneous characters.
+        if (version[*offset] != '\0')
+        {
+            return SEMY_BAD_SYNTAX;
+        }
+        *production = SEMY_PRODUCTION_NONE;
+    }
+    return err;
+}
+
+static semy_error_t parse(struct semVer *sv, const char *version)
+{
+    size_t offset;
+    semy_production_t production;
+    return parse_diagnosed(sv, version, &offset, &production);
+}
+
+// Read-only view of a version whose identifier strings are packed one after another,
+// pre-release identifiers first, as they are in every layout.
+struct packedView
+{
+    const int32_t *versions;
+    int32_t pre_release_count;
+    int32_t build_metadata_count;
+    const char *strings;
+};
+
+static struct packedView full_view(const struct semVer *sv)
+{
+    struct packedView view;
+    view.versions = sv->versions;
+    view.pre_release_count = sv->pre_release_count;
+    view.build_metadata_count = sv->build_metadata_count;
+    view.strings = sv->strings;
+    return view;
+}
+
+// Returns the number of bytes taken by the packed identifier strings, null bytes included.
+static size_t packed_length(const struct packedView *view)
+{
+    const char *end = view->strings;
+    for (int32_t i = 0; i < view->pre_release_count + view->build_metadata_count; i++)
+    {
+        end += strlen(end) + 1;
+    }
+    return (size_t)(end - view->strings);
+}
+
+// Copies a version into a packed layout of 'size' bytes if its identifiers fit.
+static semy_error_t compact(const struct packedView *view, struct semVerCompact *out, size_t size)
+{
+    const size_t length = packed_length(view);
+    const size_t capacity = size - offsetof(struct semVerCompact, strings);
+    if (length > capacity)
+    {
+        return SEMY_LIMITS_EXCEEDED;
+    }
+
+    memset(out, 0, offsetof(struct semVerCompact, strings));
+    out->layout = -(int32_t)size;
+    memcpy(out->versions, view->versions, sizeof(out->versions));
+    out->pre_release_count = (uint8_t)view->pre_release_count;
+    out->build_metadata_count = (uint8_t)view->build_metadata_count;
+    memcpy(out->strings, view->strings, length);
+    return SEMY_NO_ERROR;
+}
+
+// Appends an identifier to the strings of a packed layout, which end at 'end', and counts it.
+static semy_error_t append_packed(uint8_t *count, char **strings, const char *end, const char *s, size_t slen)
+{
+    if (*count == UINT8_MAX || (size_t)(end - *strings) <= slen)
+    {
+        return SEMY_LIMITS_EXCEEDED;
+    }
+
+    memcpy(*strings, s, slen);
+    (*strings)[slen] = '\0';
+    *strings += slen + 1;
+    *count += 1;
+    return SEMY_NO_ERROR;
+}
+
+// Parses a version directly into a packed layout of 'size' bytes. Unlike 'parse' its length
+// and number of identifiers are bounded only by the room in the layout.
+static semy_error_t parse_extended(struct semVerCompact *out, size_t size, const char *version, size_t *offset, semy_production_t *production)
+{
+    memset(out, 0, offsetof(struct semVerCompact, strings));
+    out->layout = -(int32_t)size;
+
+    const char *s = version;
+    size_t len = 0;
+    *production = SEMY_PRODUCTION_VERSION_CORE;
+    semy_error_t err = parse_version_core(out->versions, s, &len);
+    s += len;
+    if (err != SEMY_NO_ERROR)
+    {
+        *offset = s - version;
+        return err;
+    }
+
+    // Each identifier is stored in place of the separator preceding it, null terminated.
+    char *strings = out->strings;
+    const char *end = (const char *)out + size;
+    if (*s == '-')
+    {
+        *production = SEMY_PRODUCTION_PRE_RELEASE;
+        do
+        {
+            s += 1;
+            bool is_alnum = false;
+            err = parse_pre_release_identifier(s, &len, &is_alnum);
+            if (err == SEMY_NO_ERROR && !is_alnum)
+            {
+                int32_t value;
+                err = str2int(s, len, &value);
+            }
+
+            if (err == SEMY_NO_ERROR)
+            {
+                err = append_packed(&out->pre_release_count, &strings, end, s, len);
+            }
+
+            if (err != SEMY_NO_ERROR)
+            {
+                *offset = s - version;
+                return err;
+            }
+            s += len;
+        } while (*s == '.');
+    }
+
+    if (*s == '+')
+    {
+        *production = SEMY_PRODUCTION_BUILD;
+        do
+        {
+            s += 1;
+            err = parse_build_metadata(s, &len);
+            if (err == SEMY_NO_ERROR)
+            {
+                err = append_packed(&out->build_metadata_count, &strings, end, s, len);
+            }
+
+            if (err != SEMY_NO_ERROR)
+            {
+                *offset = s - version;
+                return err;
+            }
+            s += len;
+        } while (*s == '.');
+    }
+
+    // Check for any extraneous characters.
+    *offset = s - version;
+    if (*s != '\0')
+    {
+        return SEMY_BAD_SYNTAX;
+    }
+    *production = SEMY_PRODUCTION_NONE;
+    return SEMY_NO_ERROR;
+}
+
+// Returns true if 'size' selects one of the packed layouts: compact or extended.
+static bool is_packed_size(size_t size)
+{
+    if (size == sizeof(semy_compact32_t) || size == sizeof(semy_compact64_t))
+    {
+        return true;
+    }
+    return size > sizeof(semy_t) && size <= INT32_MAX;
+}
+
+#if defined(SEMY_STATS)
+// Each thread counts into its own statistics so counting needs no synchronization.
+static _Thread_local semy_stats_t stats;
+
+// The parser reports how far it read, so counting bytes doesn't scan the version again.
+static void count_parse(size_t offset, semy_error_t err)
+{
+    stats.parses += 1;
+    stats.parse_results[err] += 1;
+    stats.parsed_bytes += offset;
+}
+#endif
+
+static semy_error_t parse_layout(semy_t *semver, size_t size, const char *version, size_t *offset, semy_production_t *production)
 {
+    *offset = 0;
+    *production = SEMY_PRODUCTION_NONE;
+
     if (version == NULL)
     {
         return SEMY_INVALID_OPERATION;
@@ -525,152 +796,361 @@ SEMY_API semy_error_t semy_parse(semy_t *semver, size_t size, const char *versio
         return SEMY_INVALID_OPERATION;
     }
 
-    if (size != sizeof(struct semVer))
+    if (size == sizeof(struct semVer))
     {
-        return SEMY_INVALID_OPERATION;
+        return parse_diagnosed((struct semVer *)semver->buf, version, offset, production);
     }
 
-    // Verify the version string is not unnecessarily long.
-    // 1 kb is more than enough for any legit version string.
-    for (size_t i = 0; version[i] != '\0'; i++)
+    if (size == sizeof(semy_compact32_t) || size == sizeof(semy_compact64_t))
     {
-        if (i >= MAX_VERSION_LENGTH)
+        struct semVer sv;
+        semy_error_t err = parse_diagnosed(&sv, version, offset, production);
+        if (err == SEMY_NO_ERROR)
         {
-            return SEMY_LIMITS_EXCEEDED;
+            const struct packedView view = full_view(&sv);
+            err = compact(&view, (struct semVerCompact *)semver->buf, size);
         }
+        return err;
     }
 
-    struct semVer *sv = (struct semVer *)semver->buf;
-    static_assert(sizeof(sv->strings) > MAX_VERSION_LENGTH, "expected enough buffer space to contain string content");
-    memset(sv, 0, sizeof(sv[0]));
+    if (!is_packed_size(size))
+    {
+        return SEMY_INVALID_OPERATION;
+    }
 
-    size_t advance = 0;
-    semy_error_t err = parse_semver(sv, version, &advance);
-    if (err == SEMY_NO_ERROR)
+    return parse_extended((struct semVerCompact *)semver->buf, size, version, offset, production);
+}
+
+static semy_error_t parse_traced(semy_t *semver, size_t size, const char *version, size_t *offset, semy_production_t *production)
+{
+#if defined(SEMY_USDT)
+    if (PROBE_ENABLED(parse_start))
     {
-        // The semantic version string was parsed successfully.
-        // Now check for any extraneous characters.
-        version += advance;
-        if (*version != '\0')
-        {
-            err = SEMY_BAD_SYNTAX;
-        }
+        DTRACE_PROBE3(semy, parse_start, version, (version != NULL) ? strlen(version) : 0, size);
+    }
+#endif
+
+    const semy_error_t err = parse_layout(semver, size, version, offset, production);
+
+#if defined(SEMY_STATS)
+    count_parse(*offset, err);
+#endif
+
+#if defined(SEMY_USDT)
+    // Identifier counts are -1 if the version wasn't parsed.
+    if (PROBE_ENABLED(parse_done))
+    {
+        const bool parsed = (err == SEMY_NO_ERROR);
+        DTRACE_PROBE5(semy, parse_done, version, (version != NULL) ? strlen(version) : 0, (int)err,
+                      parsed ? semy_get_pre_release_count(semver) : -1, parsed ? semy_get_build_count(semver) : -1);
     }
+#endif
     return err;
 }
 
+SEMY_API semy_error_t semy_parse(semy_t *semver, size_t size, const char *version)
+{
+    size_t offset;
+    semy_production_t production;
+    return parse_traced(semver, size, version, &offset, &production);
+}
+
+SEMY_API semy_error_t semy_parse_diagnose(semy_t *semver, size_t size, const char *version, size_t *offset, semy_production_t *production)
+{
+    if (offset == NULL)
+    {
+        return SEMY_INVALID_OPERATION;
+    }
+
+    if (production == NULL)
+    {
+        return SEMY_INVALID_OPERATION;
+    }
+
+    return parse_traced(semver, size, version, offset, production);
+}
+
+static bool is_compact(const semy_t *semver)
+{
+    return ((const struct semVerCompact *)semver->buf)->layout < 0;
+}
+
+static const int32_t *get_versions(const semy_t *semver)
+{
+    if (is_compact(semver))
+    {
+        return ((const struct semVerCompact *)semver->buf)->versions;
+    }
+    return ((const struct semVer *)semver->buf)->versions;
+}
+
+// Returns the identifier at 'index' among the pre-release and build identifiers of a compact layout.
+static const char *get_compact_identifier(const struct semVerCompact *sv, int32_t index)
+{
+    const char *s = sv->strings;
+    for (int32_t i = 0; i < index; i++)
+    {
+        s += strlen(s) + 1;
+    }
+    return s;
+}
+
 SEMY_API int32_t semy_get_major(const semy_t *semver)
 {
-    const struct semVer *sv = (const struct semVer *)semver->buf;
-    if (sv == NULL)
+    if (semver == NULL)
     {
         return -1;
     }
-    return sv->versions[VERSION_CORE_MAJOR];
+    return get_versions(semver)[VERSION_CORE_MAJOR];
 }
 
 SEMY_API int32_t semy_get_minor(const semy_t *semver)
 {
-    const struct semVer *sv = (const struct semVer *)semver->buf;
-    if (sv == NULL)
+    if (semver == NULL)
     {
         return -1;
     }
-    return sv->versions[VERSION_CORE_MINOR];
+    return get_versions(semver)[VERSION_CORE_MINOR];
 }
 
 SEMY_API int32_t semy_get_patch(const semy_t *semver)
 {
-    const struct semVer *sv = (const struct semVer *)semver->buf;
-    if (sv == NULL)
+    if (semver == NULL)
     {
         return -1;
     }
-    return sv->versions[VERSION_CORE_PATCH];
+    return get_versions(semver)[VERSION_CORE_PATCH];
 }
 
 SEMY_API int32_t semy_get_pre_release_count(const semy_t *semver)
 {
-    const struct semVer *sv = (const struct semVer *)semver->buf;
-    if (sv == NULL)
+    if (semver == NULL)
     {
         return -1;
     }
-    return sv->pre_release_count;
+
+    if (is_compact(semver))
+    {
+        return ((const struct semVerCompact *)semver->buf)->pre_release_count;
+    }
+    return ((const struct semVer *)semver->buf)->pre_release_count;
 }
 
 SEMY_API const char *semy_get_pre_release(const semy_t *semver, int32_t index)
 {
-    const struct semVer *sv = (const struct semVer *)semver->buf;
-    if (sv == NULL)
+    if (semver == NULL)
     {
         return NULL;
     }
 
-    if (index < 0 || index >= sv->pre_release_count)
+    if (index < 0 || index >= semy_get_pre_release_count(semver))
     {
         return NULL;
     }
 
+    if (is_compact(semver))
+    {
+        return get_compact_identifier((const struct semVerCompact *)semver->buf, index);
+    }
+
+    const struct semVer *sv = (const struct semVer *)semver->buf;
     const struct preRelease *id = &sv->pre_release[index];
     return &sv->strings[id->string_value];
 }
 
 SEMY_API int32_t semy_get_build_count(const semy_t *semver)
 {
-    const struct semVer *sv = (const struct semVer *)semver->buf;
-    if (sv == NULL)
+    if (semver == NULL)
     {
         return -1;
     }
-    return sv->build_metadata_count;
+
+    if (is_compact(semver))
+    {
+        return ((const struct semVerCompact *)semver->buf)->build_metadata_count;
+    }
+    return ((const struct semVer *)semver->buf)->build_metadata_count;
 }
 
 SEMY_API const char *semy_get_build(const semy_t *semver, int32_t index)
 {
-    const struct semVer *sv = (const struct semVer *)semver->buf;
     if (semver == NULL)
     {
         return NULL;
     }
 
-    if (index < 0 || index >= sv->build_metadata_count)
+    if (index < 0 || index >= semy_get_build_count(semver))
     {
         return NULL;
     }
 
+    if (is_compact(semver))
+    {
+        const struct semVerCompact *sv = (const struct semVerCompact *)semver->buf;
+        return get_compact_identifier(sv, sv->pre_release_count + index);
+    }
+
+    const struct semVer *sv = (const struct semVer *)semver->buf;
     return &sv->strings[sv->build_metadata[index]];
 }
 
-SEMY_API semy_error_t semy_compare(const semy_t *sv1, const semy_t *sv2, int32_t *result)
+static bool is_numeric(const char *s)
 {
-    const struct semVer *a = (const struct semVer *)sv1->buf;
-    const struct semVer *b = (const struct semVer *)sv2->buf;
+    for (; *s != '\0'; s++)
+    {
+        if (!is_digit(*s))
+        {
+            return false;
+        }
+    }
+    return true;
+}
 
-    if (a == NULL)
+static int32_t sign(int value)
+{
+    return (int32_t)(value > 0) - (int32_t)(value < 0);
+}
+
+// Compares pre-release identifiers by their text alone. Numeric identifiers
+// have no leading zeros so the longer one is greater; if they have the same
+// length, then comparing their digits lexically is comparing them numerically.
+static int32_t compare_identifiers(const char *x, const char *y)
+{
+    const bool x_numeric = is_numeric(x);
+    const bool y_numeric = is_numeric(y);
+
+    if (x_numeric && y_numeric)
     {
-        return SEMY_INVALID_OPERATION;
+        const size_t x_length = strlen(x);
+        const size_t y_length = strlen(y);
+        if (x_length != y_length)
+        {
+            return (x_length < y_length) ? -1 : 1;
+        }
+    }
+    else if (x_numeric != y_numeric)
+    {
+        return x_numeric ? -1 : 1;
     }
+    return sign(strcmp(x, y));
+}
 
-    if (b == NULL)
+static struct packedView packed_view(const semy_t *semver)
+{
+    struct packedView view;
+    if (is_compact(semver))
     {
-        return SEMY_INVALID_OPERATION;
+        const struct semVerCompact *sv = (const struct semVerCompact *)semver->buf;
+        view.versions = sv->versions;
+        view.pre_release_count = sv->pre_release_count;
+        view.build_metadata_count = sv->build_metadata_count;
+        view.strings = sv->strings;
     }
+    else
+    {
+        view = full_view((const struct semVer *)semver->buf);
+    }
+    return view;
+}
 
-    if (result == NULL)
+// Restores the full layout of a version from its packed identifiers, provided they're
+// within its limits, which an extended layout need not be.
+static semy_error_t expand(const struct packedView *in, struct semVer *out)
+{
+    if (in->pre_release_count > MAX_IDENTIFIERS || in->build_metadata_count > MAX_IDENTIFIERS || packed_length(in) > MAX_VERSION_LENGTH)
     {
-        return SEMY_INVALID_OPERATION;
+        return SEMY_LIMITS_EXCEEDED;
     }
 
-    // Compare the major, minor, and patch versions.
-    for (int32_t i = 0; i < VERSION_CORE_COUNT; i++)
+    memset(out, 0, sizeof(out[0]));
+    memcpy(out->versions, in->versions, sizeof(out->versions));
+
+    const char *s = in->strings;
+    for (int32_t i = 0; i < in->pre_release_count + in->build_metadata_count; i++)
     {
-        const int32_t v1 = a->versions[i];
-        const int32_t v2 = b->versions[i];
-        if (v1 < v2)
+        const size_t slen = strlen(s);
+        if (i < in->pre_release_count)
         {
-            *result = -1;
-            return SEMY_NO_ERROR;
+            add_pre_release_identifier(out, !is_numeric(s), s, slen);
+        }
+        else
+        {
+            add_build_metadata(out, s, slen);
+        }
+        s += slen + 1;
+    }
+    return SEMY_NO_ERROR;
+}
+
+// Compares versions by their packed identifiers.
+static int32_t compare_packed(const struct packedView *a, const struct packedView *b)
+{
+    for (int32_t i = 0; i < VERSION_CORE_COUNT; i++)
+    {
+        if (a->versions[i] != b->versions[i])
+        {
+            return (a->versions[i] < b->versions[i]) ? -1 : 1;
+        }
+    }
+
+    // A pre-release version has lower precedence than a normal version.
+    if (a->pre_release_count == 0 || b->pre_release_count == 0)
+    {
+        return (int32_t)(a->pre_release_count == 0) - (int32_t)(b->pre_release_count == 0);
+    }
+
+    const char *x = a->strings;
+    const char *y = b->strings;
+    for (int32_t i = 0; i < a->pre_release_count && i < b->pre_release_count; i++)
+    {
+        const int32_t result = compare_identifiers(x, y);
+        if (result != 0)
+        {
+            return result;
+        }
+        x += strlen(x) + 1;
+        y += strlen(y) + 1;
+    }
+    return sign(a->pre_release_count - b->pre_release_count);
+}
+
+static semy_error_t compare(const semy_t *sv1, const semy_t *sv2, int32_t *result)
+{
+    const struct semVer *a = (const struct semVer *)sv1->buf;
+    const struct semVer *b = (const struct semVer *)sv2->buf;
+
+    if (a == NULL)
+    {
+        return SEMY_INVALID_OPERATION;
+    }
+
+    if (b == NULL)
+    {
+        return SEMY_INVALID_OPERATION;
+    }
+
+    if (result == NULL)
+    {
+        return SEMY_INVALID_OPERATION;
+    }
+
+    if (is_compact(sv1) || is_compact(sv2))
+    {
+        const struct packedView x = packed_view(sv1);
+        const struct packedView y = packed_view(sv2);
+        *result = compare_packed(&x, &y);
+        return SEMY_NO_ERROR;
+    }
+
+    // Compare the major, minor, and patch versions.
+    for (int32_t i = 0; i < VERSION_CORE_COUNT; i++)
+    {
+        const int32_t v1 = a->versions[i];
+        const int32_t v2 = b->versions[i];
+        if (v1 < v2)
+        {
+            *result = -1;
+            return SEMY_NO_ERROR;
         }
         else if (v1 > v2)
         {
@@ -781,3 +1261,3349 @@ SEMY_API semy_error_t semy_compare(const semy_t *sv1, const semy_t *sv2, int32_t
     *result = 0;
     return SEMY_NO_ERROR;
 }
+
+#if defined(SEMY_STATS) || defined(SEMY_USDT)
+// The part of two versions that decided their comparison.
+enum compareStage
+{
+    COMPARE_EQUAL,
+    COMPARE_CORE,
+    COMPARE_PRE_RELEASE,
+};
+
+// Versions with equal version cores are decided, if at all, by their pre-release identifiers.
+static enum compareStage compare_stage(const semy_t *sv1, const semy_t *sv2, int32_t result)
+{
+    if (memcmp(get_versions(sv1), get_versions(sv2), sizeof(int32_t) * VERSION_CORE_COUNT) != 0)
+    {
+        return COMPARE_CORE;
+    }
+    return (result != 0) ? COMPARE_PRE_RELEASE : COMPARE_EQUAL;
+}
+#endif
+
+#if defined(SEMY_STATS)
+static void count_compare(const semy_t *sv1, const semy_t *sv2, int32_t result)
+{
+    stats.compares += 1;
+    switch (compare_stage(sv1, sv2, result))
+    {
+    case COMPARE_CORE:
+        stats.core_decided += 1;
+        break;
+
+    case COMPARE_PRE_RELEASE:
+        stats.pre_release_decided += 1;
+        break;
+
+    case COMPARE_EQUAL:
+        break;
+    }
+}
+#endif
+
+SEMY_API semy_error_t semy_compare(const semy_t *sv1, const semy_t *sv2, int32_t *result)
+{
+#if defined(SEMY_USDT)
+    DTRACE_PROBE2(semy, compare_start, sv1, sv2);
+#endif
+
+    const semy_error_t err = compare(sv1, sv2, result);
+
+#if defined(SEMY_STATS)
+    if (err == SEMY_NO_ERROR)
+    {
+        count_compare(sv1, sv2, *result);
+    }
+#endif
+
+#if defined(SEMY_USDT)
+    // The result and stage are 0 and -1 if the versions weren't compared.
+    if (PROBE_ENABLED(compare_done))
+    {
+        const bool compared = (err == SEMY_NO_ERROR);
+        DTRACE_PROBE5(semy, compare_done, sv1, sv2, (int)err, compared ? *result : 0,
+                      compared ? (int)compare_stage(sv1, sv2, *result) : -1);
+    }
+#endif
+    return err;
+}
+
+// Index layout. All integers are little-endian.
+//
+//   header:  the magic "SEMYIDX1", a 32-bit format version, 32 reserved bits,
+//            the 64-bit version count, and the 64-bit size of the key table.
+//   entries: count + 1 pairs of 64-bit offsets into the key and string tables where
+//            entry i spans [offsets[i], offsets[i + 1]) of each table.
+//   keys:    the key of each version in ascending order, padded to 8 bytes.
+//   strings: the null-terminated version strings in ascending order.
+//
+// Keys are encoded such that comparing them with memcmp() agrees with semy_compare().
+// The version core is three 32-bit big-endian integers. Each pre-release identifier
+// is KEY_NUMERIC followed by a 32-bit big-endian integer or KEY_ALPHANUMERIC followed
+// by its characters and a null byte; KEY_END follows the last identifier. A version
+// without pre-release identifiers ends with KEY_NORMAL so it follows its pre-releases.
+#define INDEX_MAGIC "SEMYIDX1"
+#define INDEX_FORMAT_VERSION 1
+#define INDEX_HEADER_SIZE 32
+#define INDEX_ENTRY_SIZE 16
+
+#define KEY_END 0x00
+#define KEY_NUMERIC 0x01
+#define KEY_ALPHANUMERIC 0x02
+#define KEY_NORMAL 0xFF
+#define MAX_KEY_LENGTH ((VERSION_CORE_COUNT * 4) + MAX_VERSION_LENGTH + (MAX_IDENTIFIERS * 5) + 1)
+
+struct indexView
+{
+    const uint8_t *entries;
+    const uint8_t *keys;
+    const char *strings;
+    size_t count;
+    size_t keys_size;
+    size_t strings_size;
+};
+
+// Sort record written over the entry table while building an index.
+struct indexSort
+{
+    const uint8_t *key;
+    uint32_t length;
+    uint32_t position; // Position of the version in the input.
+};
+
+static_assert(sizeof(struct indexView) <= sizeof(semy_index_t), "expected the index view to fit");
+static_assert(sizeof(struct indexSort) <= INDEX_ENTRY_SIZE, "expected sort records to fit in the entry table");
+
+static void store_be32(uint8_t *bytes, uint32_t value)
+{
+    bytes[0] = (uint8_t)(value >> 24);
+    bytes[1] = (uint8_t)(value >> 16);
+    bytes[2] = (uint8_t)(value >> 8);
+    bytes[3] = (uint8_t)value;
+}
+
+static void store_le64(uint8_t *bytes, uint64_t value)
+{
+    for (int i = 0; i < 8; i++)
+    {
+        bytes[i] = (uint8_t)(value >> (i * 8));
+    }
+}
+
+static uint64_t load_le64(const uint8_t *bytes)
+{
+    uint64_t value = 0;
+    for (int i = 7; i >= 0; i--)
+    {
+        value = (value << 8) | bytes[i];
+    }
+    return value;
+}
+
+static size_t align8(size_t size)
+{
+    return (size + 7) & ~(size_t)7;
+}
+
+static size_t encode_key(const struct semVer *sv, uint8_t key[MAX_KEY_LENGTH])
+{
+    size_t length = 0;
+
+    for (int32_t i = 0; i < VERSION_CORE_COUNT; i++)
+    {
+        store_be32(&key[length], (uint32_t)sv->versions[i]);
+        length += 4;
+    }
+
+    if (sv->pre_release_count == 0)
+    {
+        key[length++] = KEY_NORMAL;
+        return length;
+    }
+
+    for (int32_t i = 0; i < sv->pre_release_count; i++)
+    {
+        const struct preRelease *id = &sv->pre_release[i];
+        if (id->is_alphanumeric)
+        {
+            const char *s = &sv->strings[id->string_value];
+            const size_t slen = strlen(s);
+            key[length++] = KEY_ALPHANUMERIC;
+            memcpy(&key[length], s, slen + 1); // +1 for the null byte
+            length += slen + 1;
+        }
+        else
+        {
+            key[length++] = KEY_NUMERIC;
+            store_be32(&key[length], (uint32_t)id->numeric_value);
+            length += 4;
+        }
+    }
+
+    key[length++] = KEY_END;
+    return length;
+}
+
+// Parses a version that is null terminated if 'lengths' is null.
+static semy_error_t parse_indexed(struct semVer *sv, const char *const *versions, const size_t *lengths, size_t i)
+{
+    if (versions[i] == NULL)
+    {
+        return SEMY_INVALID_OPERATION;
+    }
+
+    if (lengths == NULL)
+    {
+        return parse(sv, versions[i]);
+    }
+
+    char version[MAX_VERSION_LENGTH + 1];
+    if (lengths[i] > MAX_VERSION_LENGTH)
+    {
+        return SEMY_LIMITS_EXCEEDED;
+    }
+
+    memcpy(version, versions[i], lengths[i]);
+    version[lengths[i]] = '\0';
+    if (strlen(version) != lengths[i])
+    {
+        return SEMY_BAD_SYNTAX; // Embedded null character.
+    }
+    return parse(sv, version);
+}
+
+static int compare_keys(const uint8_t *a, size_t a_length, const uint8_t *b, size_t b_length)
+{
+    const int result = memcmp(a, b, (a_length < b_length) ? a_length : b_length);
+    if (result != 0)
+    {
+        return result;
+    }
+    return (a_length > b_length) - (a_length < b_length);
+}
+
+static int compare_index_sort(const void *a, const void *b)
+{
+    const struct indexSort *x = (const struct indexSort *)a;
+    const struct indexSort *y = (const struct indexSort *)b;
+
+    const int result = compare_keys(x->key, x->length, y->key, y->length);
+    if (result != 0)
+    {
+        return result;
+    }
+
+    // Preserve the input order of equal versions.
+    return (x->position > y->position) - (x->position < y->position);
+}
+
+SEMY_API semy_error_t semy_index_build(const char *const *versions, const size_t *lengths, size_t count, void *buffer, size_t *size)
+{
+    if (versions == NULL && count > 0)
+    {
+        return SEMY_INVALID_OPERATION;
+    }
+
+    if (size == NULL)
+    {
+        return SEMY_INVALID_OPERATION;
+    }
+
+    if (count > UINT32_MAX)
+    {
+        return SEMY_LIMITS_EXCEEDED;
+    }
+
+    struct semVer sv;
+    uint8_t key[MAX_KEY_LENGTH];
+    size_t keys_size = 0;
+    size_t strings_size = 0;
+
+    // Validate the versions and compute the size of each table.
+    for (size_t i = 0; i < count; i++)
+    {
+        const semy_error_t err = parse_indexed(&sv, versions, lengths, i);
+        if (err != SEMY_NO_ERROR)
+        {
+            return err;
+        }
+        keys_size += encode_key(&sv, key);
+        strings_size += ((lengths == NULL) ? strlen(versions[i]) : lengths[i]) + 1;
+    }
+
+    const size_t keys_offset = INDEX_HEADER_SIZE + ((count + 1) * INDEX_ENTRY_SIZE);
+    const size_t strings_offset = keys_offset + align8(keys_size);
+    const size_t required = strings_offset + strings_size;
+
+    if (buffer == NULL)
+    {
+        *size = required;
+        return SEMY_NO_ERROR;
+    }
+
+    if (*size < required || ((uintptr_t)buffer % 8) != 0)
+    {
+        *size = required;
+        return SEMY_INVALID_OPERATION;
+    }
+    *size = required;
+
+    uint8_t *data = (uint8_t *)buffer;
+    uint8_t *entries = &data[INDEX_HEADER_SIZE];
+    uint8_t *keys = &data[keys_offset];
+    char *strings = (char *)&data[strings_offset];
+
+    // Encode keys in input order and sort records referencing them. The records
+    // temporarily occupy the entry table which is large enough to hold them.
+    struct indexSort *records = (struct indexSort *)entries;
+    size_t offset = 0;
+    for (size_t i = 0; i < count; i++)
+    {
+        parse_indexed(&sv, versions, lengths, i);
+        records[i].key = &keys[offset];
+        records[i].length = (uint32_t)encode_key(&sv, &keys[offset]);
+        records[i].position = (uint32_t)i;
+        offset += records[i].length;
+    }
+    qsort(records, count, sizeof(records[0]), compare_index_sort);
+
+    // Copy the strings in sorted order, replacing each record with its entry.
+    offset = 0;
+    for (size_t i = 0; i < count; i++)
+    {
+        const size_t position = records[i].position;
+        const size_t slen = (lengths == NULL) ? strlen(versions[position]) : lengths[position];
+        memcpy(&strings[offset], versions[position], slen);
+        strings[offset + slen] = '\0';
+        store_le64(&entries[(i * INDEX_ENTRY_SIZE) + 8], offset);
+        offset += slen + 1;
+    }
+
+    // Re-encode the keys in sorted order now that the records are gone.
+    offset = 0;
+    for (size_t i = 0; i < count; i++)
+    {
+        const uint64_t string_offset = load_le64(&entries[(i * INDEX_ENTRY_SIZE) + 8]);
+        parse(&sv, &strings[string_offset]);
+        store_le64(&entries[i * INDEX_ENTRY_SIZE], offset);
+        offset += encode_key(&sv, &keys[offset]);
+    }
+    memset(&keys[keys_size], 0, align8(keys_size) - keys_size);
+
+    store_le64(&entries[count * INDEX_ENTRY_SIZE], keys_size);
+    store_le64(&entries[(count * INDEX_ENTRY_SIZE) + 8], strings_size);
+
+    memcpy(data, INDEX_MAGIC, 8);
+    memset(&data[8], 0, 8);
+    data[8] = INDEX_FORMAT_VERSION;
+    store_le64(&data[16], count);
+    store_le64(&data[24], keys_size);
+    return SEMY_NO_ERROR;
+}
+
+SEMY_API semy_error_t semy_index_open(semy_index_t *index, const void *data, size_t size)
+{
+    if (index == NULL || data == NULL)
+    {
+        return SEMY_INVALID_OPERATION;
+    }
+
+    // Verify the header and that every table lies within the data.
+    const uint8_t *bytes = (const uint8_t *)data;
+    if (size < INDEX_HEADER_SIZE + INDEX_ENTRY_SIZE || memcmp(bytes, INDEX_MAGIC, 8) != 0)
+    {
+        return SEMY_BAD_SYNTAX;
+    }
+
+    if (bytes[8] != INDEX_FORMAT_VERSION || bytes[9] != 0 || bytes[10] != 0 || bytes[11] != 0)
+    {
+        return SEMY_BAD_SYNTAX;
+    }
+
+    const uint64_t count = load_le64(&bytes[16]);
+    const uint64_t keys_size = load_le64(&bytes[24]);
+    if (count >= (size - INDEX_HEADER_SIZE) / INDEX_ENTRY_SIZE)
+    {
+        return SEMY_BAD_SYNTAX;
+    }
+
+    const size_t keys_offset = INDEX_HEADER_SIZE + (((size_t)count + 1) * INDEX_ENTRY_SIZE);
+    if (keys_size > size - keys_offset || align8((size_t)keys_size) > size - keys_offset)
+    {
+        return SEMY_BAD_SYNTAX;
+    }
+
+    const uint8_t *sentinel = &bytes[INDEX_HEADER_SIZE + ((size_t)count * INDEX_ENTRY_SIZE)];
+    const size_t strings_offset = keys_offset + align8((size_t)keys_size);
+    const uint64_t strings_size = load_le64(&sentinel[8]);
+    if (load_le64(sentinel) != keys_size || strings_size > size - strings_offset)
+    {
+        return SEMY_BAD_SYNTAX;
+    }
+
+    struct indexView *view = (struct indexView *)index->buf;
+    view->entries = &bytes[INDEX_HEADER_SIZE];
+    view->keys = &bytes[keys_offset];
+    view->strings = (const char *)&bytes[strings_offset];
+    view->count = (size_t)count;
+    view->keys_size = (size_t)keys_size;
+    view->strings_size = (size_t)strings_size;
+    return SEMY_NO_ERROR;
+}
+
+SEMY_API size_t semy_index_count(const semy_index_t *index)
+{
+    if (index == NULL)
+    {
+        return 0;
+    }
+    return ((const struct indexView *)index->buf)->count;
+}
+
+// Locates the span of entry 'i' in a table, verifying it's within the table
+// since offsets are read from the (possibly untrusted) index data.
+static bool index_span(const struct indexView *view, size_t i, size_t field, size_t table_size, size_t *begin, size_t *end)
+{
+    const uint64_t x = load_le64(&view->entries[(i * INDEX_ENTRY_SIZE) + field]);
+    const uint64_t y = load_le64(&view->entries[((i + 1) * INDEX_ENTRY_SIZE) + field]);
+    if (x > y || y > table_size)
+    {
+        return false;
+    }
+    *begin = (size_t)x;
+    *end = (size_t)y;
+    return true;
+}
+
+SEMY_API const char *semy_index_get(const semy_index_t *index, size_t position)
+{
+    if (index == NULL)
+    {
+        return NULL;
+    }
+
+    const struct indexView *view = (const struct indexView *)index->buf;
+    if (position >= view->count)
+    {
+        return NULL;
+    }
+
+    size_t begin = 0;
+    size_t end = 0;
+    if (!index_span(view, position, 8, view->strings_size, &begin, &end) || begin == end || view->strings[end - 1] != '\0')
+    {
+        return NULL;
+    }
+    return &view->strings[begin];
+}
+
+// Returns the first position whose key is greater than (or not less than if 'inclusive' is false) the given key.
+static semy_error_t index_bound(const struct indexView *view, const uint8_t *key, size_t length, bool inclusive, size_t *bound)
+{
+    size_t low = 0;
+    size_t high = view->count;
+
+    while (low < high)
+    {
+        const size_t middle = low + ((high - low) / 2);
+        size_t begin = 0;
+        size_t end = 0;
+        if (!index_span(view, middle, 0, view->keys_size, &begin, &end))
+        {
+            return SEMY_BAD_SYNTAX;
+        }
+
+        const int result = compare_keys(&view->keys[begin], end - begin, key, length);
+        if (result < 0 || (inclusive && result == 0))
+        {
+            low = middle + 1;
+        }
+        else
+        {
+            high = middle;
+        }
+    }
+
+    *bound = low;
+    return SEMY_NO_ERROR;
+}
+
+SEMY_API semy_error_t semy_index_search(const semy_index_t *index, const semy_t *version, size_t *lower, size_t *upper)
+{
+    if (index == NULL || version == NULL || lower == NULL || upper == NULL)
+    {
+        return SEMY_INVALID_OPERATION;
+    }
+
+    const struct indexView *view = (const struct indexView *)index->buf;
+    const struct semVer *sv = (const struct semVer *)version->buf;
+    struct semVer expanded;
+    if (is_compact(version))
+    {
+        const struct packedView view = packed_view(version);
+        const semy_error_t err = expand(&view, &expanded);
+        if (err != SEMY_NO_ERROR)
+        {
+            return err;
+        }
+        sv = &expanded;
+    }
+
+    uint8_t key[MAX_KEY_LENGTH];
+    const size_t length = encode_key(sv, key);
+
+    const semy_error_t err = index_bound(view, key, length, false, lower);
+    if (err != SEMY_NO_ERROR)
+    {
+        return err;
+    }
+    return index_bound(view, key, length, true, upper);
+}
+
+// Arena layout. The version core and identifier counts of each version are stored in
+// an array of entries that grows by doubling. The identifier strings of each version
+// are copied, packed as they are in 'semVer', into the slab being filled and the entry
+// points to them. Slabs never move, so an entry stays valid as the array grows.
+//
+// An interned arena instead stores each pre-release identifier as a 32-bit token: a
+// numeric identifier is its value, which never has the INTERNED bit set, and an
+// alphanumeric identifier is INTERNED plus its id in the intern table. The tokens are
+// followed by the packed build identifiers. Once the ids are ranked in ASCII order,
+// replacing each id with its rank makes comparing tokens an integer comparison that
+// also orders numeric identifiers before alphanumeric ones.
+#define ARENA_SLAB_SIZE (64 * 1024)
+#define ARENA_INITIAL_CAPACITY 256
+#define INTERN_INITIAL_SLOTS 64
+#define INTERNED UINT32_C(0x80000000)
+
+struct arenaEntry
+{
+    const char *strings;
+    int32_t versions[VERSION_CORE_COUNT];
+    uint8_t pre_release_count;
+    uint8_t build_metadata_count;
+};
+
+struct arenaSlab
+{
+    struct arenaSlab *previous;
+    size_t used;
+    char data[ARENA_SLAB_SIZE];
+};
+
+// Deduplicates alphanumeric identifiers. The hash table maps an identifier to its id,
+// which is its position in 'strings', and 'ranks' holds the ASCII order of the first
+// 'ranked' ids. Identifiers interned after they were ranked are compared by their text.
+struct internTable
+{
+    uint32_t *slots; // Open addressed with linear probing; each slot is an id plus one or zero if empty.
+    size_t slot_count;
+    const char **strings;
+    uint32_t *ranks;
+    size_t count;
+    size_t capacity;
+    size_t ranked;
+};
+
+struct arena
+{
+    struct arenaEntry *entries;
+    size_t count;
+    size_t capacity;
+    struct arenaSlab *slab;      // The slab being filled; it links to those filled before it.
+    struct internTable *intern;  // Null until an interned arena adds its first version.
+    bool interned;
+};
+
+// Sort record used to rank interned identifiers.
+struct internSort
+{
+    const char *string;
+    uint32_t id;
+};
+
+static_assert(sizeof(struct arena) <= sizeof(semy_arena_t), "expected the arena to fit");
+static_assert(sizeof(struct arenaEntry) <= 24, "expected at most 24 bytes");
+static_assert(ARENA_SLAB_SIZE > MAX_VERSION_LENGTH + (MAX_IDENTIFIERS * 4), "expected the identifiers of any version to fit a slab");
+
+static struct packedView arena_view(const struct arena *arena, size_t position)
+{
+    const struct arenaEntry *entry = &arena->entries[position];
+    struct packedView view;
+    view.versions = entry->versions;
+    view.pre_release_count = entry->pre_release_count;
+    view.build_metadata_count = entry->build_metadata_count;
+    view.strings = entry->strings;
+    return view;
+}
+
+SEMY_API semy_error_t semy_arena_init(semy_arena_t *arena)
+{
+    if (arena == NULL)
+    {
+        return SEMY_INVALID_OPERATION;
+    }
+
+    memset(arena, 0, sizeof(arena[0]));
+    return SEMY_NO_ERROR;
+}
+
+SEMY_API semy_error_t semy_arena_init_interned(semy_arena_t *arena)
+{
+    if (arena == NULL)
+    {
+        return SEMY_INVALID_OPERATION;
+    }
+
+    memset(arena, 0, sizeof(arena[0]));
+    ((struct arena *)arena->buf)->interned = true;
+    return SEMY_NO_ERROR;
+}
+
+SEMY_API void semy_arena_free(semy_arena_t *arena)
+{
+    if (arena == NULL)
+    {
+        return;
+    }
+
+    struct arena *a = (struct arena *)arena->buf;
+    while (a->slab != NULL)
+    {
+        struct arenaSlab *previous = a->slab->previous;
+        free(a->slab);
+        a->slab = previous;
+    }
+
+    if (a->intern != NULL)
+    {
+        free(a->intern->slots);
+        free(a->intern->strings);
+        free(a->intern->ranks);
+        free(a->intern);
+    }
+
+    // The arena keeps interning so it can be reused as it was initialized.
+    const bool interned = a->interned;
+    free(a->entries);
+    memset(arena, 0, sizeof(arena[0]));
+    a->interned = interned;
+}
+
+// Returns space for 'length' bytes aligned to 'alignment', starting a new slab if needed.
+static char *arena_allocate(struct arena *arena, size_t length, size_t alignment)
+{
+    size_t used = 0;
+    if (arena->slab != NULL)
+    {
+        used = (arena->slab->used + alignment - 1) & ~(alignment - 1);
+    }
+
+    if (arena->slab == NULL || used > ARENA_SLAB_SIZE || ARENA_SLAB_SIZE - used < length)
+    {
+        struct arenaSlab *slab = malloc(sizeof(struct arenaSlab));
+        if (slab == NULL)
+        {
+            return NULL; // LCOV_EXCL_LINE
+        }
+        slab->previous = arena->slab;
+        arena->slab = slab;
+        used = 0;
+    }
+
+    arena->slab->used = used + length;
+    return &arena->slab->data[used];
+}
+
+static uint32_t hash_identifier(const char *s, size_t slen)
+{
+    // FNV-1a
+    uint32_t hash = UINT32_C(2166136261);
+    for (size_t i = 0; i < slen; i++)
+    {
+        hash = (hash ^ (uint8_t)s[i]) * UINT32_C(16777619);
+    }
+    return hash;
+}
+
+// Grows the hash table of the intern table so it's never more than half full.
+static semy_error_t intern_grow(struct internTable *table)
+{
+    const size_t slot_count = (table->slot_count == 0) ? INTERN_INITIAL_SLOTS : table->slot_count * 2;
+    uint32_t *slots = calloc(slot_count, sizeof(slots[0]));
+    if (slots == NULL)
+    {
+        return SEMY_OUT_OF_MEMORY; // LCOV_EXCL_LINE
+    }
+
+    for (size_t i = 0; i < table->count; i++)
+    {
+        const char *s = table->strings[i];
+        size_t slot = hash_identifier(s, strlen(s)) & (slot_count - 1);
+        while (slots[slot] != 0)
+        {
+            slot = (slot + 1) & (slot_count - 1);
+        }
+        slots[slot] = (uint32_t)i + 1;
+    }
+
+    free(table->slots);
+    table->slots = slots;
+    table->slot_count = slot_count;
+    return SEMY_NO_ERROR;
+}
+
+// Returns the id of an alphanumeric identifier, adding it to the intern table if it's new.
+static semy_error_t intern(struct arena *arena, const char *s, size_t slen, uint32_t *id)
+{
+    struct internTable *table = arena->intern;
+    semy_error_t err = SEMY_NO_ERROR;
+
+    if (table->count >= table->slot_count / 2)
+    {
+        err = intern_grow(table);
+        if (err != SEMY_NO_ERROR)
+        {
+            return err; // LCOV_EXCL_LINE
+        }
+    }
+
+    size_t slot = hash_identifier(s, slen) & (table->slot_count - 1);
+    while (table->slots[slot] != 0)
+    {
+        const char *existing = table->strings[table->slots[slot] - 1];
+        if (strncmp(existing, s, slen) == 0 && existing[slen] == '\0')
+        {
+            *id = table->slots[slot] - 1;
+            return SEMY_NO_ERROR;
+        }
+        slot = (slot + 1) & (table->slot_count - 1);
+    }
+
+    // LCOV_EXCL_START
+    if (table->count >= INTERNED)
+    {
+        return SEMY_LIMITS_EXCEEDED;
+    }
+    // LCOV_EXCL_STOP
+
+    if (table->count == table->capacity)
+    {
+        const size_t capacity = (table->capacity == 0) ? ARENA_INITIAL_CAPACITY : table->capacity * 2;
+        const char **strings = realloc(table->strings, capacity * sizeof(strings[0]));
+        if (strings == NULL)
+        {
+            return SEMY_OUT_OF_MEMORY; // LCOV_EXCL_LINE
+        }
+        table->strings = strings;
+        table->capacity = capacity;
+    }
+
+    char *string = arena_allocate(arena, slen + 1, 1);
+    if (string == NULL)
+    {
+        return SEMY_OUT_OF_MEMORY; // LCOV_EXCL_LINE
+    }
+    memcpy(string, s, slen);
+    string[slen] = '\0';
+
+    *id = (uint32_t)table->count;
+    table->strings[table->count] = string;
+    table->slots[slot] = (uint32_t)table->count + 1;
+    table->count += 1;
+    return SEMY_NO_ERROR;
+}
+
+// Copies the identifiers of a version into the arena and returns where they're stored.
+static semy_error_t arena_store(struct arena *arena, const struct semVer *sv, const char **strings)
+{
+    *strings = "";
+    if (sv->chars_allocated == 0)
+    {
+        return SEMY_NO_ERROR;
+    }
+
+    if (arena->intern == NULL)
+    {
+        char *data = arena_allocate(arena, sv->chars_allocated, 1);
+        if (data == NULL)
+        {
+            return SEMY_OUT_OF_MEMORY; // LCOV_EXCL_LINE
+        }
+        memcpy(data, sv->strings, sv->chars_allocated);
+        *strings = data;
+        return SEMY_NO_ERROR;
+    }
+
+    // Intern the alphanumeric identifiers first so the slab space for the tokens is contiguous.
+    uint32_t tokens[MAX_IDENTIFIERS];
+    for (int32_t i = 0; i < sv->pre_release_count; i++)
+    {
+        const struct preRelease *id = &sv->pre_release[i];
+        tokens[i] = (uint32_t)id->numeric_value;
+        if (id->is_alphanumeric)
+        {
+            const char *s = &sv->strings[id->string_value];
+            const semy_error_t err = intern(arena, s, strlen(s), &tokens[i]);
+            if (err != SEMY_NO_ERROR)
+            {
+                return err; // LCOV_EXCL_LINE
+            }
+            tokens[i] |= INTERNED;
+        }
+    }
+
+    const size_t tokens_size = (size_t)sv->pre_release_count * sizeof(tokens[0]);
+    const size_t build_offset = (sv->build_metadata_count > 0) ? sv->build_metadata[0] : sv->chars_allocated;
+    const size_t build_size = sv->chars_allocated - build_offset;
+
+    char *data = arena_allocate(arena, tokens_size + build_size, sizeof(tokens[0]));
+    if (data == NULL)
+    {
+        return SEMY_OUT_OF_MEMORY; // LCOV_EXCL_LINE
+    }
+    memcpy(data, tokens, tokens_size);
+    memcpy(data + tokens_size, &sv->strings[build_offset], build_size);
+    *strings = data;
+    return SEMY_NO_ERROR;
+}
+
+SEMY_API semy_error_t semy_arena_parse(semy_arena_t *arena, const char *version, size_t *position)
+{
+    if (arena == NULL || version == NULL)
+    {
+        return SEMY_INVALID_OPERATION;
+    }
+
+    struct semVer sv;
+    semy_error_t err = parse(&sv, version);
+    if (err != SEMY_NO_ERROR)
+    {
+        return err;
+    }
+
+    struct arena *a = (struct arena *)arena->buf;
+    if (a->interned && a->intern == NULL)
+    {
+        a->intern = calloc(1, sizeof(struct internTable));
+        if (a->intern == NULL)
+        {
+            return SEMY_OUT_OF_MEMORY; // LCOV_EXCL_LINE
+        }
+    }
+
+    if (a->count == a->capacity)
+    {
+        const size_t capacity = (a->capacity == 0) ? ARENA_INITIAL_CAPACITY : a->capacity * 2;
+        // LCOV_EXCL_START
+        if (capacity > SIZE_MAX / sizeof(struct arenaEntry))
+        {
+            return SEMY_LIMITS_EXCEEDED;
+        }
+        // LCOV_EXCL_STOP
+
+        struct arenaEntry *entries = realloc(a->entries, capacity * sizeof(struct arenaEntry));
+        if (entries == NULL)
+        {
+            return SEMY_OUT_OF_MEMORY; // LCOV_EXCL_LINE
+        }
+        a->entries = entries;
+        a->capacity = capacity;
+    }
+
+    struct arenaEntry *entry = &a->entries[a->count];
+    err = arena_store(a, &sv, &entry->strings);
+    if (err != SEMY_NO_ERROR)
+    {
+        return err; // LCOV_EXCL_LINE
+    }
+
+    memcpy(entry->versions, sv.versions, sizeof(entry->versions));
+    entry->pre_release_count = sv.pre_release_count;
+    entry->build_metadata_count = sv.build_metadata_count;
+
+    if (position != NULL)
+    {
+        *position = a->count;
+    }
+    a->count += 1;
+    return SEMY_NO_ERROR;
+}
+
+SEMY_API size_t semy_arena_count(const semy_arena_t *arena)
+{
+    if (arena == NULL)
+    {
+        return 0;
+    }
+    return ((const struct arena *)arena->buf)->count;
+}
+
+SEMY_API size_t semy_arena_identifier_count(const semy_arena_t *arena)
+{
+    if (arena == NULL)
+    {
+        return 0;
+    }
+
+    const struct arena *a = (const struct arena *)arena->buf;
+    return (a->intern == NULL) ? 0 : a->intern->count;
+}
+
+static int compare_intern_sort(const void *a, const void *b)
+{
+    const struct internSort *x = (const struct internSort *)a;
+    const struct internSort *y = (const struct internSort *)b;
+    return strcmp(x->string, y->string);
+}
+
+SEMY_API semy_error_t semy_arena_rank(semy_arena_t *arena)
+{
+    if (arena == NULL)
+    {
+        return SEMY_INVALID_OPERATION;
+    }
+
+    struct internTable *table = ((struct arena *)arena->buf)->intern;
+    if (table == NULL || table->ranked == table->count)
+    {
+        return SEMY_NO_ERROR;
+    }
+
+    struct internSort *records = malloc(table->count * sizeof(records[0]));
+    uint32_t *ranks = realloc(table->ranks, table->capacity * sizeof(ranks[0]));
+    // LCOV_EXCL_START
+    if (records == NULL || ranks == NULL)
+    {
+        free(records);
+        if (ranks != NULL)
+        {
+            table->ranks = ranks;
+        }
+        return SEMY_OUT_OF_MEMORY;
+    }
+    // LCOV_EXCL_STOP
+    table->ranks = ranks;
+
+    for (size_t i = 0; i < table->count; i++)
+    {
+        records[i].string = table->strings[i];
+        records[i].id = (uint32_t)i;
+    }
+
+    // Identifiers are distinct so no two records compare equal.
+    qsort(records, table->count, sizeof(records[0]), compare_intern_sort);
+    for (size_t i = 0; i < table->count; i++)
+    {
+        ranks[records[i].id] = (uint32_t)i;
+    }
+
+    free(records);
+    table->ranked = table->count;
+    return SEMY_NO_ERROR;
+}
+
+// Restores the full layout of a version stored in an interned arena.
+static void expand_interned(const struct internTable *table, const struct arenaEntry *entry, struct semVer *out)
+{
+    memset(out, 0, sizeof(out[0]));
+    memcpy(out->versions, entry->versions, sizeof(out->versions));
+
+    const uint32_t *tokens = (const uint32_t *)entry->strings;
+    for (int32_t i = 0; i < entry->pre_release_count; i++)
+    {
+        if (tokens[i] & INTERNED)
+        {
+            const char *s = table->strings[tokens[i] & ~INTERNED];
+            add_pre_release_identifier(out, true, s, strlen(s));
+        }
+        else
+        {
+            // Format the digits backwards from the end of the buffer.
+            char digits[16];
+            size_t start = sizeof(digits);
+            uint32_t value = tokens[i];
+            do
+            {
+                digits[--start] = (char)('0' + (value % 10));
+                value /= 10;
+            } while (value > 0);
+            add_pre_release_identifier(out, false, &digits[start], sizeof(digits) - start);
+        }
+    }
+
+    const char *s = (const char *)&tokens[entry->pre_release_count];
+    for (int32_t i = 0; i < entry->build_metadata_count; i++)
+    {
+        const size_t slen = strlen(s);
+        add_build_metadata(out, s, slen);
+        s += slen + 1;
+    }
+}
+
+SEMY_API semy_error_t semy_arena_get(const semy_arena_t *arena, size_t position, semy_t *semy, size_t size)
+{
+    if (arena == NULL || semy == NULL)
+    {
+        return SEMY_INVALID_OPERATION;
+    }
+
+    const struct arena *a = (const struct arena *)arena->buf;
+    if (position >= a->count)
+    {
+        return SEMY_INVALID_OPERATION;
+    }
+
+    const bool is_compact_size = is_packed_size(size);
+    if (size != sizeof(struct semVer) && !is_compact_size)
+    {
+        return SEMY_INVALID_OPERATION;
+    }
+
+    struct semVer sv;
+    struct semVer *out = is_compact_size ? &sv : (struct semVer *)semy->buf;
+    if (a->intern != NULL)
+    {
+        expand_interned(a->intern, &a->entries[position], out);
+    }
+    else
+    {
+        const struct packedView view = arena_view(a, position);
+        expand(&view, out);
+    }
+
+    if (is_compact_size)
+    {
+        const struct packedView view = full_view(&sv);
+        return compact(&view, (struct semVerCompact *)semy->buf, size);
+    }
+    return SEMY_NO_ERROR;
+}
+
+// Compares versions in an interned arena by their tokens.
+static int32_t compare_interned(const struct internTable *table, const struct arenaEntry *a, const struct arenaEntry *b)
+{
+    for (int32_t i = 0; i < VERSION_CORE_COUNT; i++)
+    {
+        if (a->versions[i] != b->versions[i])
+        {
+            return (a->versions[i] < b->versions[i]) ? -1 : 1;
+        }
+    }
+
+    // A pre-release version has lower precedence than a normal version.
+    if (a->pre_release_count == 0 || b->pre_release_count == 0)
+    {
+        return (int32_t)(a->pre_release_count == 0) - (int32_t)(b->pre_release_count == 0);
+    }
+
+    const uint32_t *x = (const uint32_t *)a->strings;
+    const uint32_t *y = (const uint32_t *)b->strings;
+    for (int32_t i = 0; i < a->pre_release_count && i < b->pre_release_count; i++)
+    {
+        uint32_t u = x[i];
+        uint32_t v = y[i];
+        if (u != v && (u & v & INTERNED))
+        {
+            const uint32_t u_id = u & ~INTERNED;
+            const uint32_t v_id = v & ~INTERNED;
+            if (u_id >= table->ranked || v_id >= table->ranked)
+            {
+                return sign(strcmp(table->strings[u_id], table->strings[v_id]));
+            }
+            u = INTERNED | table->ranks[u_id];
+            v = INTERNED | table->ranks[v_id];
+        }
+
+        if (u != v)
+        {
+            return (u < v) ? -1 : 1;
+        }
+    }
+    return sign(a->pre_release_count - b->pre_release_count);
+}
+
+SEMY_API semy_error_t semy_arena_compare(const semy_arena_t *arena, size_t a, size_t b, int32_t *result)
+{
+    if (arena == NULL || result == NULL)
+    {
+        return SEMY_INVALID_OPERATION;
+    }
+
+    const struct arena *ar = (const struct arena *)arena->buf;
+    if (a >= ar->count || b >= ar->count)
+    {
+        return SEMY_INVALID_OPERATION;
+    }
+
+    if (ar->intern != NULL)
+    {
+        *result = compare_interned(ar->intern, &ar->entries[a], &ar->entries[b]);
+        return SEMY_NO_ERROR;
+    }
+
+    const struct packedView x = arena_view(ar, a);
+    const struct packedView y = arena_view(ar, b);
+    *result = compare_packed(&x, &y);
+    return SEMY_NO_ERROR;
+}
+
+// Column store layout. Each property of the versions is stored in its own array, indexed
+// by position, so a scan only reads the columns it tests. The major, minor, and patch
+// columns hold 32-bit integers and the pre-release column is a bitmap with a bit set for
+// each version with pre-release identifiers. The identifier strings of every version are
+// packed, as they are in 'semVer', one version after another into a single buffer and
+// version i spans [offsets[i], offsets[i + 1]) of it.
+#define COLUMNS_INITIAL_CAPACITY 256
+
+struct columns
+{
+    int32_t *core[VERSION_CORE_COUNT];
+    uint64_t *pre_release;
+    uint64_t *offsets;
+    uint8_t *pre_release_counts;
+    uint8_t *build_metadata_counts;
+    char *data;
+    size_t data_size;
+    size_t data_capacity;
+    size_t count;
+    size_t capacity;
+};
+
+static_assert(sizeof(struct columns) <= sizeof(semy_columns_t), "expected the column store to fit");
+static_assert((COLUMNS_INITIAL_CAPACITY % 64) == 0, "expected the bitmap to grow by whole words");
+
+SEMY_API semy_error_t semy_columns_init(semy_columns_t *columns)
+{
+    if (columns == NULL)
+    {
+        return SEMY_INVALID_OPERATION;
+    }
+
+    memset(columns, 0, sizeof(columns[0]));
+    return SEMY_NO_ERROR;
+}
+
+SEMY_API void semy_columns_free(semy_columns_t *columns)
+{
+    if (columns == NULL)
+    {
+        return;
+    }
+
+    struct columns *c = (struct columns *)columns->buf;
+    for (int32_t i = 0; i < VERSION_CORE_COUNT; i++)
+    {
+        free(c->core[i]);
+    }
+    free(c->pre_release);
+    free(c->offsets);
+    free(c->pre_release_counts);
+    free(c->build_metadata_counts);
+    free(c->data);
+    memset(columns, 0, sizeof(columns[0]));
+}
+
+// Resizes an array to 'capacity' elements. The array is unchanged if it fails.
+static bool resize_column(void **array, size_t capacity, size_t element_size)
+{
+    // LCOV_EXCL_START
+    if (capacity > SIZE_MAX / element_size)
+    {
+        return false;
+    }
+    // LCOV_EXCL_STOP
+
+    void *resized = realloc(*array, capacity * element_size);
+    if (resized == NULL)
+    {
+        return false; // LCOV_EXCL_LINE
+    }
+    *array = resized;
+    return true;
+}
+
+// Makes room for one more version and 'length' more bytes of identifier strings.
+// The capacity is only raised once every column has grown.
+static semy_error_t columns_reserve(struct columns *c, size_t length)
+{
+    if (c->count == c->capacity)
+    {
+        const size_t capacity = (c->capacity == 0) ? COLUMNS_INITIAL_CAPACITY : c->capacity * 2;
+        bool resized = true;
+        for (int32_t i = 0; i < VERSION_CORE_COUNT; i++)
+        {
+            resized = resized && resize_column((void **)&c->core[i], capacity, sizeof(int32_t));
+        }
+        resized = resized && resize_column((void **)&c->pre_release, capacity / 64, sizeof(uint64_t));
+        resized = resized && resize_column((void **)&c->offsets, capacity + 1, sizeof(uint64_t));
+        resized = resized && resize_column((void **)&c->pre_release_counts, capacity, sizeof(uint8_t));
+        resized = resized && resize_column((void **)&c->build_metadata_counts, capacity, sizeof(uint8_t));
+        if (!resized)
+        {
+            return SEMY_OUT_OF_MEMORY; // LCOV_EXCL_LINE
+        }
+
+        memset(&c->pre_release[c->capacity / 64], 0, (capacity - c->capacity) / 8);
+        c->offsets[0] = 0;
+        c->capacity = capacity;
+    }
+
+    if (c->data_capacity - c->data_size < length)
+    {
+        size_t capacity = (c->data_capacity == 0) ? (COLUMNS_INITIAL_CAPACITY * 16) : c->data_capacity * 2;
+        while (capacity - c->data_size < length)
+        {
+            capacity *= 2; // LCOV_EXCL_LINE
+        }
+
+        if (!resize_column((void **)&c->data, capacity, 1))
+        {
+            return SEMY_OUT_OF_MEMORY; // LCOV_EXCL_LINE
+        }
+        c->data_capacity = capacity;
+    }
+    return SEMY_NO_ERROR;
+}
+
+static semy_error_t columns_append(struct columns *c, const struct packedView *view)
+{
+    const size_t length = packed_length(view);
+
+    const semy_error_t err = columns_reserve(c, length);
+    if (err != SEMY_NO_ERROR)
+    {
+        return err; // LCOV_EXCL_LINE
+    }
+
+    const size_t i = c->count;
+    for (int32_t j = 0; j < VERSION_CORE_COUNT; j++)
+    {
+        c->core[j][i] = view->versions[j];
+    }
+
+    if (view->pre_release_count > 0)
+    {
+        c->pre_release[i / 64] |= UINT64_C(1) << (i % 64);
+    }
+
+    c->pre_release_counts[i] = (uint8_t)view->pre_release_count;
+    c->build_metadata_counts[i] = (uint8_t)view->build_metadata_count;
+    // The data is null until a version with identifiers is appended.
+    if (length > 0)
+    {
+        memcpy(&c->data[c->data_size], view->strings, length);
+        c->data_size += length;
+    }
+    c->offsets[i + 1] = c->data_size;
+    c->count += 1;
+    return SEMY_NO_ERROR;
+}
+
+SEMY_API semy_error_t semy_columns_append(semy_columns_t *columns, const semy_t *version)
+{
+    if (columns == NULL || version == NULL)
+    {
+        return SEMY_INVALID_OPERATION;
+    }
+
+    const struct packedView view = packed_view(version);
+    return columns_append((struct columns *)columns->buf, &view);
+}
+
+SEMY_API semy_error_t semy_columns_parse(semy_columns_t *columns, const char *const *versions, const size_t *lengths, size_t count, size_t *parsed)
+{
+    if (parsed != NULL)
+    {
+        *parsed = 0;
+    }
+
+    if (columns == NULL || (versions == NULL && count > 0))
+    {
+        return SEMY_INVALID_OPERATION;
+    }
+
+    struct columns *c = (struct columns *)columns->buf;
+    for (size_t i = 0; i < count; i++)
+    {
+        struct semVer sv;
+        semy_error_t err = parse_indexed(&sv, versions, lengths, i);
+        if (err == SEMY_NO_ERROR)
+        {
+            const struct packedView view = packed_view((const semy_t *)&sv);
+            err = columns_append(c, &view);
+        }
+
+        if (err != SEMY_NO_ERROR)
+        {
+            return err;
+        }
+
+        if (parsed != NULL)
+        {
+            *parsed = i + 1;
+        }
+    }
+    return SEMY_NO_ERROR;
+}
+
+SEMY_API size_t semy_columns_count(const semy_columns_t *columns)
+{
+    if (columns == NULL)
+    {
+        return 0;
+    }
+    return ((const struct columns *)columns->buf)->count;
+}
+
+SEMY_API const int32_t *semy_columns_core(const semy_columns_t *columns, semy_field_t field)
+{
+    if (columns == NULL || field < SEMY_FIELD_MAJOR || field > SEMY_FIELD_PATCH)
+    {
+        return NULL;
+    }
+    return ((const struct columns *)columns->buf)->core[field - SEMY_FIELD_MAJOR];
+}
+
+SEMY_API const uint64_t *semy_columns_pre_release(const semy_columns_t *columns)
+{
+    if (columns == NULL)
+    {
+        return NULL;
+    }
+    return ((const struct columns *)columns->buf)->pre_release;
+}
+
+SEMY_API semy_error_t semy_columns_get(const semy_columns_t *columns, size_t position, semy_t *semy, size_t size)
+{
+    if (columns == NULL || semy == NULL)
+    {
+        return SEMY_INVALID_OPERATION;
+    }
+
+    const struct columns *c = (const struct columns *)columns->buf;
+    if (position >= c->count)
+    {
+        return SEMY_INVALID_OPERATION;
+    }
+
+    if (size != sizeof(struct semVer) && !is_packed_size(size))
+    {
+        return SEMY_INVALID_OPERATION;
+    }
+
+    int32_t versions[VERSION_CORE_COUNT];
+    for (int32_t i = 0; i < VERSION_CORE_COUNT; i++)
+    {
+        versions[i] = c->core[i][position];
+    }
+
+    struct packedView view;
+    view.versions = versions;
+    view.pre_release_count = c->pre_release_counts[position];
+    view.build_metadata_count = c->build_metadata_counts[position];
+    view.strings = &c->data[c->offsets[position]];
+
+    if (size == sizeof(struct semVer))
+    {
+        return expand(&view, (struct semVer *)semy->buf);
+    }
+    return compact(&view, (struct semVerCompact *)semy->buf, size);
+}
+
+// Tests 'count' (at most 64) values of a column and returns a bitmap of those that pass.
+// Each case is a branchless loop that compilers vectorize.
+static uint64_t scan_block(const int32_t *column, size_t count, semy_operator_t op, int32_t value)
+{
+    uint64_t bits = 0;
+
+#define SCAN_BLOCK(comparison)                                      \
+    for (size_t i = 0; i < count; i++)                              \
+    {                                                               \
+        bits |= (uint64_t)(column[i] comparison value) << i;        \
+    }
+
+    switch (op)
+    {
+    case SEMY_EQ:
+        SCAN_BLOCK(==);
+        break;
+    case SEMY_NE:
+        SCAN_BLOCK(!=);
+        break;
+    case SEMY_LT:
+        SCAN_BLOCK(<);
+        break;
+    case SEMY_LE:
+        SCAN_BLOCK(<=);
+        break;
+    case SEMY_GT:
+        SCAN_BLOCK(>);
+        break;
+    default:
+        SCAN_BLOCK(>=);
+        break;
+    }
+
+#undef SCAN_BLOCK
+    return bits;
+}
+
+static bool compare_operator(semy_operator_t op, int32_t a, int32_t b)
+{
+    switch (op)
+    {
+    case SEMY_EQ:
+        return a == b;
+    case SEMY_NE:
+        return a != b;
+    case SEMY_LT:
+        return a < b;
+    case SEMY_LE:
+        return a <= b;
+    case SEMY_GT:
+        return a > b;
+    default:
+        return a >= b;
+    }
+}
+
+SEMY_API semy_error_t semy_columns_scan(const semy_columns_t *columns, const semy_predicate_t *predicates, size_t count, uint64_t *matches)
+{
+    if (columns == NULL || matches == NULL || (predicates == NULL && count > 0))
+    {
+        return SEMY_INVALID_OPERATION;
+    }
+
+    for (size_t p = 0; p < count; p++)
+    {
+        if (predicates[p].field < SEMY_FIELD_MAJOR || predicates[p].field > SEMY_FIELD_PRE_RELEASE ||
+            predicates[p].op < SEMY_EQ || predicates[p].op > SEMY_GE)
+        {
+            return SEMY_INVALID_OPERATION;
+        }
+    }
+
+    // Test the versions 64 at a time so every column of a block is read while it's in cache.
+    const struct columns *c = (const struct columns *)columns->buf;
+    for (size_t block = 0; block * 64 < c->count; block++)
+    {
+        const size_t first = block * 64;
+        const size_t n = (c->count - first < 64) ? (c->count - first) : 64;
+        uint64_t mask = (n == 64) ? UINT64_MAX : ((UINT64_C(1) << n) - 1);
+
+        for (size_t p = 0; p < count && mask != 0; p++)
+        {
+            const semy_predicate_t *predicate = &predicates[p];
+            if (predicate->field == SEMY_FIELD_PRE_RELEASE)
+            {
+                // The field is 1 for versions with pre-release identifiers and 0 otherwise.
+                const uint64_t bits = c->pre_release[block];
+                const uint64_t with = compare_operator(predicate->op, 1, predicate->value) ? bits : 0;
+                const uint64_t without = compare_operator(predicate->op, 0, predicate->value) ? ~bits : 0;
+                mask &= with | without;
+            }
+            else
+            {
+                const int32_t *column = &c->core[predicate->field - SEMY_FIELD_MAJOR][first];
+                mask &= scan_block(column, n, predicate->op, predicate->value);
+            }
+        }
+        matches[block] = mask;
+    }
+    return SEMY_NO_ERROR;
+}
+
+// Registry layout. A snapshot is an array of version sets sorted by package name and each
+// set is an index of the versions of one package followed by its name. Snapshots and sets
+// are never modified once published: the writer builds a new snapshot that shares the sets
+// of unchanged packages with the previous one and swaps it in.
+//
+// Snapshots are reclaimed with epochs. Each reader has a slot it sets to the current epoch
+// while it reads a snapshot and to zero otherwise. Publishing swaps the snapshot, advances
+// the epoch, and retires the previous snapshot and the sets it replaced tagged with the new
+// epoch. A reader whose slot is at least that epoch loaded the snapshot after the swap, so
+// the retired memory is freed once every slot is zero or at least its tag. Slots, the
+// snapshot, and the epoch are accessed sequentially consistently for this reasoning to hold.
+#if !defined(__STDC_NO_ATOMICS__)
+
+#define REGISTRY_INITIAL_CAPACITY 64
+#define REGISTRY_READER_SIZE 128
+
+struct registrySet
+{
+    semy_index_t index;
+    const char *name; // Stored after the index data.
+    uint64_t data[];
+};
+
+struct registrySnapshot
+{
+    size_t count;
+    struct registrySet *sets[];
+};
+
+// The snapshot and sets that are freed once no reader can be reading them.
+struct registryRetired
+{
+    struct registryRetired *next;
+    uint64_t epoch;
+    struct registrySnapshot *snapshot;
+    size_t count;
+    struct registrySet *sets[];
+};
+
+// A staged version; both strings are offsets into the staging text.
+struct registryAddition
+{
+    size_t name;
+    size_t version;
+};
+
+// Sort record used to group staged versions by package.
+struct registrySort
+{
+    const char *name;
+    const char *version;
+    size_t position;
+};
+
+// State only the writer touches. It's kept apart from the registry so staging versions
+// doesn't invalidate the cache line readers load the snapshot from.
+struct registryWriter
+{
+    char *text;
+    size_t text_length;
+    size_t text_capacity;
+    struct registryAddition *additions;
+    size_t count;
+    size_t capacity;
+    struct registryRetired *retired;
+};
+
+// Readers are padded so the slots of two readers never share a cache line.
+struct registryReader
+{
+    _Atomic uint64_t active;
+    _Atomic bool attached;
+    struct registryReader *next;
+    char padding[REGISTRY_READER_SIZE - sizeof(uint64_t) - (2 * sizeof(void *))];
+};
+
+struct registry
+{
+    _Atomic(struct registrySnapshot *) snapshot;
+    _Atomic uint64_t epoch;
+    _Atomic(struct registryReader *) readers;
+    struct registryWriter *writer;
+};
+
+struct registryReaderView
+{
+    struct registry *registry;
+    struct registryReader *reader;
+    struct registrySnapshot *pinned;
+    bool is_pinned;
+};
+
+static_assert(sizeof(struct registry) <= sizeof(semy_registry_t), "expected the registry to fit");
+static_assert(sizeof(struct registryReaderView) <= sizeof(semy_registry_reader_t), "expected the reader to fit");
+static_assert(sizeof(struct registryReader) == REGISTRY_READER_SIZE, "expected readers to be padded");
+
+static void registry_free_retired(struct registryRetired *retired)
+{
+    for (size_t i = 0; i < retired->count; i++)
+    {
+        free(retired->sets[i]);
+    }
+    free(retired->snapshot);
+    free(retired);
+}
+
+// Frees the retired snapshots that no reader can still be reading.
+static void registry_reclaim(struct registry *r)
+{
+    uint64_t oldest = UINT64_MAX;
+    for (struct registryReader *reader = atomic_load(&r->readers); reader != NULL; reader = reader->next)
+    {
+        const uint64_t active = atomic_load(&reader->active);
+        if (active != 0 && active < oldest)
+        {
+            oldest = active;
+        }
+    }
+
+    struct registryRetired **link = &r->writer->retired;
+    while (*link != NULL)
+    {
+        struct registryRetired *retired = *link;
+        if (retired->epoch <= oldest)
+        {
+            *link = retired->next;
+            registry_free_retired(retired);
+        }
+        else
+        {
+            link = &retired->next;
+        }
+    }
+}
+
+SEMY_API semy_error_t semy_registry_init(semy_registry_t *registry)
+{
+    if (registry == NULL)
+    {
+        return SEMY_INVALID_OPERATION;
+    }
+
+    memset(registry, 0, sizeof(registry[0]));
+    struct registry *r = (struct registry *)registry->buf;
+    r->writer = calloc(1, sizeof(struct registryWriter));
+    if (r->writer == NULL)
+    {
+        return SEMY_OUT_OF_MEMORY; // LCOV_EXCL_LINE
+    }
+
+    atomic_init(&r->snapshot, NULL);
+    atomic_init(&r->epoch, 1); // A slot of zero means its reader isn't reading.
+    atomic_init(&r->readers, NULL);
+    return SEMY_NO_ERROR;
+}
+
+SEMY_API void semy_registry_free(semy_registry_t *registry)
+{
+    if (registry == NULL)
+    {
+        return;
+    }
+
+    struct registry *r = (struct registry *)registry->buf;
+    if (r->writer == NULL)
+    {
+        return;
+    }
+
+    while (r->writer->retired != NULL)
+    {
+        struct registryRetired *next = r->writer->retired->next;
+        registry_free_retired(r->writer->retired);
+        r->writer->retired = next;
+    }
+
+    struct registrySnapshot *snapshot = atomic_load(&r->snapshot);
+    if (snapshot != NULL)
+    {
+        for (size_t i = 0; i < snapshot->count; i++)
+        {
+            free(snapshot->sets[i]);
+        }
+        free(snapshot);
+    }
+
+    struct registryReader *reader = atomic_load(&r->readers);
+    while (reader != NULL)
+    {
+        struct registryReader *next = reader->next;
+        free(reader);
+        reader = next;
+    }
+
+    free(r->writer->text);
+    free(r->writer->additions);
+    free(r->writer);
+    memset(registry, 0, sizeof(registry[0]));
+}
+
+// Appends a null-terminated copy of 's' to the staging text and returns its offset.
+static semy_error_t registry_stage_text(struct registryWriter *w, const char *s, size_t *offset)
+{
+    const size_t slen = strlen(s) + 1;
+    if (w->text_capacity - w->text_length < slen)
+    {
+        size_t capacity = (w->text_capacity == 0) ? (REGISTRY_INITIAL_CAPACITY * 16) : w->text_capacity;
+        while (capacity - w->text_length < slen)
+        {
+            // LCOV_EXCL_START
+            if (capacity > SIZE_MAX / 2)
+            {
+                return SEMY_LIMITS_EXCEEDED;
+            }
+            // LCOV_EXCL_STOP
+            capacity *= 2;
+        }
+
+        char *text = realloc(w->text, capacity);
+        if (text == NULL)
+        {
+            return SEMY_OUT_OF_MEMORY; // LCOV_EXCL_LINE
+        }
+        w->text = text;
+        w->text_capacity = capacity;
+    }
+
+    memcpy(&w->text[w->text_length], s, slen);
+    *offset = w->text_length;
+    w->text_length += slen;
+    return SEMY_NO_ERROR;
+}
+
+SEMY_API semy_error_t semy_registry_add(semy_registry_t *registry, const char *name, const char *version)
+{
+    if (registry == NULL || name == NULL || version == NULL || name[0] == '\0')
+    {
+        return SEMY_INVALID_OPERATION;
+    }
+
+    struct registry *r = (struct registry *)registry->buf;
+    if (r->writer == NULL)
+    {
+        return SEMY_INVALID_OPERATION;
+    }
+
+    struct semVer sv;
+    semy_error_t err = parse(&sv, version);
+    if (err != SEMY_NO_ERROR)
+    {
+        return err;
+    }
+
+    struct registryWriter *w = r->writer;
+    if (w->count == w->capacity)
+    {
+        const size_t capacity = (w->capacity == 0) ? REGISTRY_INITIAL_CAPACITY : w->capacity * 2;
+        // LCOV_EXCL_START
+        if (capacity > SIZE_MAX / sizeof(struct registryAddition))
+        {
+            return SEMY_LIMITS_EXCEEDED;
+        }
+        // LCOV_EXCL_STOP
+
+        struct registryAddition *additions = realloc(w->additions, capacity * sizeof(struct registryAddition));
+        if (additions == NULL)
+        {
+            return SEMY_OUT_OF_MEMORY; // LCOV_EXCL_LINE
+        }
+        w->additions = additions;
+        w->capacity = capacity;
+    }
+
+    // Nothing is staged unless both strings are.
+    struct registryAddition addition;
+    const size_t text_length = w->text_length;
+    err = registry_stage_text(w, name, &addition.name);
+    if (err == SEMY_NO_ERROR)
+    {
+        err = registry_stage_text(w, version, &addition.version);
+    }
+
+    if (err != SEMY_NO_ERROR)
+    {
+        w->text_length = text_length; // LCOV_EXCL_LINE
+        return err;                   // LCOV_EXCL_LINE
+    }
+
+    w->additions[w->count] = addition;
+    w->count += 1;
+    return SEMY_NO_ERROR;
+}
+
+static int compare_registry_sort(const void *a, const void *b)
+{
+    const struct registrySort *x = (const struct registrySort *)a;
+    const struct registrySort *y = (const struct registrySort *)b;
+
+    const int result = strcmp(x->name, y->name);
+    if (result != 0)
+    {
+        return result;
+    }
+
+    // Preserve the order versions were staged in.
+    return (x->position > y->position) - (x->position < y->position);
+}
+
+// Builds a set named 'name' of the 'count' versions, which must be valid.
+static semy_error_t registry_build_set(const char *name, const char *const *versions, size_t count, struct registrySet **out)
+{
+    size_t size = 0;
+    semy_index_build(versions, NULL, count, NULL, &size);
+
+    const size_t name_length = strlen(name) + 1;
+    struct registrySet *set = malloc(sizeof(struct registrySet) + align8(size) + name_length);
+    if (set == NULL)
+    {
+        return SEMY_OUT_OF_MEMORY; // LCOV_EXCL_LINE
+    }
+
+    semy_index_build(versions, NULL, count, set->data, &size);
+    semy_index_open(&set->index, set->data, size);
+
+    char *copy = (char *)set->data + align8(size);
+    memcpy(copy, name, name_length);
+    set->name = copy;
+    *out = set;
+    return SEMY_NO_ERROR;
+}
+
+// Returns true if the versions at positions 'a' and 'b' of a trusted index are equal in precedence.
+static bool index_equal_keys(const struct indexView *view, size_t a, size_t b)
+{
+    size_t a_begin = 0;
+    size_t a_end = 0;
+    size_t b_begin = 0;
+    size_t b_end = 0;
+    index_span(view, a, 0, view->keys_size, &a_begin, &a_end);
+    index_span(view, b, 0, view->keys_size, &b_begin, &b_end);
+    return compare_keys(&view->keys[a_begin], a_end - a_begin, &view->keys[b_begin], b_end - b_begin) == 0;
+}
+
+// Builds the set of package 'name' with the versions of 'previous', if non-null, and the
+// 'count' versions of 'staged'. Versions identical to one before them are dropped.
+static semy_error_t registry_merge_set(const char *name, const struct registrySet *previous, const struct registrySort *staged, size_t count, struct registrySet **out)
+{
+    const size_t existing = (previous == NULL) ? 0 : semy_index_count(&previous->index);
+    const char **versions = malloc((existing + count) * sizeof(versions[0]));
+    if (versions == NULL)
+    {
+        return SEMY_OUT_OF_MEMORY; // LCOV_EXCL_LINE
+    }
+
+    for (size_t i = 0; i < existing; i++)
+    {
+        versions[i] = semy_index_get(&previous->index, i);
+    }
+
+    for (size_t i = 0; i < count; i++)
+    {
+        versions[existing + i] = staged[i].version;
+    }
+
+    struct registrySet *set = NULL;
+    semy_error_t err = registry_build_set(name, versions, existing + count, &set);
+    if (err != SEMY_NO_ERROR)
+    {
+        free(versions); // LCOV_EXCL_LINE
+        return err;     // LCOV_EXCL_LINE
+    }
+
+    // Identical versions are equal in precedence, so they're within the same run of equal
+    // keys in the sorted set. Runs are short, so each is searched linearly.
+    const struct indexView *view = (const struct indexView *)set->index.buf;
+    const size_t total = view->count;
+    size_t unique = 0;
+    size_t run = 0; // The number of unique versions before the current run.
+    for (size_t i = 0; i < total; i++)
+    {
+        if (i > 0 && !index_equal_keys(view, i - 1, i))
+        {
+            run = unique;
+        }
+
+        const char *version = semy_index_get(&set->index, i);
+        bool duplicate = false;
+        for (size_t j = run; j < unique && !duplicate; j++)
+        {
+            duplicate = (strcmp(versions[j], version) == 0);
+        }
+
+        if (!duplicate)
+        {
+            versions[unique++] = version;
+        }
+    }
+
+    if (unique < total)
+    {
+        struct registrySet *deduplicated = NULL;
+        err = registry_build_set(name, versions, unique, &deduplicated);
+        free(set);
+        set = deduplicated;
+    }
+
+    free(versions);
+    *out = set;
+    return err;
+}
+
+SEMY_API semy_error_t semy_registry_publish(semy_registry_t *registry)
+{
+    if (registry == NULL)
+    {
+        return SEMY_INVALID_OPERATION;
+    }
+
+    struct registry *r = (struct registry *)registry->buf;
+    struct registryWriter *w = r->writer;
+    if (w == NULL)
+    {
+        return SEMY_INVALID_OPERATION;
+    }
+
+    if (w->count == 0)
+    {
+        registry_reclaim(r);
+        return SEMY_NO_ERROR;
+    }
+
+    // Group the staged versions by package.
+    struct registrySort *records = malloc(w->count * sizeof(records[0]));
+    if (records == NULL)
+    {
+        return SEMY_OUT_OF_MEMORY; // LCOV_EXCL_LINE
+    }
+
+    size_t groups = 1;
+    for (size_t i = 0; i < w->count; i++)
+    {
+        records[i].name = &w->text[w->additions[i].name];
+        records[i].version = &w->text[w->additions[i].version];
+        records[i].position = i;
+    }
+    qsort(records, w->count, sizeof(records[0]), compare_registry_sort);
+    for (size_t i = 1; i < w->count; i++)
+    {
+        if (strcmp(records[i - 1].name, records[i].name) != 0)
+        {
+            groups += 1;
+        }
+    }
+
+    struct registrySnapshot *previous = atomic_load(&r->snapshot);
+    const size_t previous_count = (previous == NULL) ? 0 : previous->count;
+    struct registrySnapshot *snapshot = malloc(sizeof(struct registrySnapshot) + ((previous_count + groups) * sizeof(snapshot->sets[0])));
+    struct registryRetired *retired = malloc(sizeof(struct registryRetired) + (groups * sizeof(retired->sets[0])));
+    struct registrySet **fresh = malloc(groups * sizeof(fresh[0]));
+    if (snapshot == NULL || retired == NULL || fresh == NULL)
+    {
+        // LCOV_EXCL_START
+        free(records);
+        free(snapshot);
+        free(retired);
+        free(fresh);
+        return SEMY_OUT_OF_MEMORY;
+        // LCOV_EXCL_STOP
+    }
+
+    // Merge the sets of the previous snapshot with the groups, both sorted by name.
+    semy_error_t err = SEMY_NO_ERROR;
+    size_t count = 0;
+    size_t fresh_count = 0;
+    size_t replaced = 0;
+    size_t p = 0;
+    size_t g = 0;
+    while (p < previous_count || g < w->count)
+    {
+        int order = 1;
+        if (g == w->count)
+        {
+            order = -1;
+        }
+        else if (p < previous_count)
+        {
+            order = strcmp(previous->sets[p]->name, records[g].name);
+        }
+
+        if (order < 0)
+        {
+            snapshot->sets[count++] = previous->sets[p++];
+            continue;
+        }
+
+        size_t end = g + 1;
+        while (end < w->count && strcmp(records[end].name, records[g].name) == 0)
+        {
+            end += 1;
+        }
+
+        struct registrySet *set = NULL;
+        err = registry_merge_set(records[g].name, (order == 0) ? previous->sets[p] : NULL, &records[g], end - g, &set);
+        if (err != SEMY_NO_ERROR)
+        {
+            break; // LCOV_EXCL_LINE
+        }
+
+        fresh[fresh_count++] = set;
+        snapshot->sets[count++] = set;
+        if (order == 0)
+        {
+            retired->sets[replaced++] = previous->sets[p++];
+        }
+        g = end;
+    }
+
+    free(records);
+    if (err != SEMY_NO_ERROR)
+    {
+        // LCOV_EXCL_START
+        for (size_t i = 0; i < fresh_count; i++)
+        {
+            free(fresh[i]);
+        }
+        free(fresh);
+        free(snapshot);
+        free(retired);
+        return err;
+        // LCOV_EXCL_STOP
+    }
+    free(fresh);
+
+    // Readers that load the epoch after it advances also load the new snapshot.
+    snapshot->count = count;
+    atomic_store(&r->snapshot, snapshot);
+    retired->epoch = atomic_fetch_add(&r->epoch, 1) + 1;
+    retired->snapshot = previous;
+    retired->count = replaced;
+    retired->next = w->retired;
+    w->retired = retired;
+
+    w->count = 0;
+    w->text_length = 0;
+    registry_reclaim(r);
+    return SEMY_NO_ERROR;
+}
+
+SEMY_API semy_error_t semy_registry_attach(semy_registry_t *registry, semy_registry_reader_t *reader)
+{
+    if (registry == NULL || reader == NULL)
+    {
+        return SEMY_INVALID_OPERATION;
+    }
+
+    struct registry *r = (struct registry *)registry->buf;
+    if (r->writer == NULL)
+    {
+        return SEMY_INVALID_OPERATION;
+    }
+
+    // Reuse a detached reader before allocating another.
+    struct registryReader *record = NULL;
+    for (struct registryReader *it = atomic_load(&r->readers); it != NULL; it = it->next)
+    {
+        bool expected = false;
+        if (atomic_compare_exchange_strong(&it->attached, &expected, true))
+        {
+            record = it;
+            break;
+        }
+    }
+
+    if (record == NULL)
+    {
+        record = calloc(1, sizeof(struct registryReader));
+        if (record == NULL)
+        {
+            return SEMY_OUT_OF_MEMORY; // LCOV_EXCL_LINE
+        }
+
+        atomic_init(&record->active, 0);
+        atomic_init(&record->attached, true);
+        record->next = atomic_load(&r->readers);
+        while (!atomic_compare_exchange_weak(&r->readers, &record->next, record))
+        {
+            // The head changed; 'next' was updated to the new head.
+        }
+    }
+
+    memset(reader, 0, sizeof(reader[0]));
+    struct registryReaderView *v = (struct registryReaderView *)reader->buf;
+    v->registry = r;
+    v->reader = record;
+    return SEMY_NO_ERROR;
+}
+
+SEMY_API void semy_registry_detach(semy_registry_reader_t *reader)
+{
+    if (reader == NULL)
+    {
+        return;
+    }
+
+    struct registryReaderView *v = (struct registryReaderView *)reader->buf;
+    if (v->reader == NULL)
+    {
+        return;
+    }
+
+    atomic_store(&v->reader->active, 0);
+    atomic_store(&v->reader->attached, false);
+    memset(reader, 0, sizeof(reader[0]));
+}
+
+// Returns the snapshot to query, marking the reader as reading it unless it's pinned.
+static const struct registrySnapshot *registry_enter(struct registryReaderView *v)
+{
+    if (v->is_pinned)
+    {
+        return v->pinned;
+    }
+    atomic_store(&v->reader->active, atomic_load(&v->registry->epoch));
+    return atomic_load(&v->registry->snapshot);
+}
+
+static void registry_exit(struct registryReaderView *v)
+{
+    if (!v->is_pinned)
+    {
+        atomic_store_explicit(&v->reader->active, 0, memory_order_release);
+    }
+}
+
+SEMY_API semy_error_t semy_registry_pin(semy_registry_reader_t *reader)
+{
+    if (reader == NULL)
+    {
+        return SEMY_INVALID_OPERATION;
+    }
+
+    struct registryReaderView *v = (struct registryReaderView *)reader->buf;
+    if (v->reader == NULL || v->is_pinned)
+    {
+        return SEMY_INVALID_OPERATION;
+    }
+
+    v->pinned = (struct registrySnapshot *)registry_enter(v);
+    v->is_pinned = true;
+    return SEMY_NO_ERROR;
+}
+
+SEMY_API semy_error_t semy_registry_unpin(semy_registry_reader_t *reader)
+{
+    if (reader == NULL)
+    {
+        return SEMY_INVALID_OPERATION;
+    }
+
+    struct registryReaderView *v = (struct registryReaderView *)reader->buf;
+    if (v->reader == NULL || !v->is_pinned)
+    {
+        return SEMY_INVALID_OPERATION;
+    }
+
+    v->is_pinned = false;
+    v->pinned = NULL;
+    registry_exit(v);
+    return SEMY_NO_ERROR;
+}
+
+static const struct registrySet *registry_find(const struct registrySnapshot *snapshot, const char *name)
+{
+    if (snapshot == NULL)
+    {
+        return NULL;
+    }
+
+    size_t low = 0;
+    size_t high = snapshot->count;
+    while (low < high)
+    {
+        const size_t middle = low + ((high - low) / 2);
+        const int result = strcmp(snapshot->sets[middle]->name, name);
+        if (result == 0)
+        {
+            return snapshot->sets[middle];
+        }
+
+        if (result < 0)
+        {
+            low = middle + 1;
+        }
+        else
+        {
+            high = middle;
+        }
+    }
+    return NULL;
+}
+
+SEMY_API semy_error_t semy_registry_contains(semy_registry_reader_t *reader, const char *name, const semy_t *version, int32_t *found)
+{
+    if (reader == NULL || name == NULL || version == NULL || found == NULL)
+    {
+        return SEMY_INVALID_OPERATION;
+    }
+
+    struct registryReaderView *v = (struct registryReaderView *)reader->buf;
+    if (v->reader == NULL)
+    {
+        return SEMY_INVALID_OPERATION;
+    }
+
+    semy_error_t err = SEMY_NO_ERROR;
+    *found = 0;
+
+    const struct registrySet *set = registry_find(registry_enter(v), name);
+    if (set != NULL)
+    {
+        size_t lower = 0;
+        size_t upper = 0;
+        err = semy_index_search(&set->index, version, &lower, &upper);
+        if (err == SEMY_NO_ERROR && lower < upper)
+        {
+            *found = 1;
+        }
+    }
+
+    registry_exit(v);
+    return err;
+}
+
+SEMY_API semy_error_t semy_registry_highest(semy_registry_reader_t *reader, const char *name, const semy_t *minimum, const semy_t *limit,
+                                            semy_t *semy, size_t size, int32_t *found)
+{
+    if (reader == NULL || name == NULL || semy == NULL || found == NULL)
+    {
+        return SEMY_INVALID_OPERATION;
+    }
+
+    struct registryReaderView *v = (struct registryReaderView *)reader->buf;
+    if (v->reader == NULL)
+    {
+        return SEMY_INVALID_OPERATION;
+    }
+
+    if (size != sizeof(struct semVer) && !is_packed_size(size))
+    {
+        return SEMY_INVALID_OPERATION;
+    }
+
+    semy_error_t err = SEMY_NO_ERROR;
+    *found = 0;
+
+    const struct registrySet *set = registry_find(registry_enter(v), name);
+    if (set != NULL)
+    {
+        // The highest candidate precedes the first version not less than 'limit'.
+        size_t lower = 0;
+        size_t upper = semy_index_count(&set->index);
+        size_t ignored = 0;
+        if (minimum != NULL)
+        {
+            err = semy_index_search(&set->index, minimum, &lower, &ignored);
+        }
+
+        if (err == SEMY_NO_ERROR && limit != NULL)
+        {
+            err = semy_index_search(&set->index, limit, &upper, &ignored);
+        }
+
+        if (err == SEMY_NO_ERROR && lower < upper)
+        {
+            size_t offset = 0;
+            semy_production_t production = SEMY_PRODUCTION_NONE;
+            err = parse_layout(semy, size, semy_index_get(&set->index, upper - 1), &offset, &production);
+            if (err == SEMY_NO_ERROR)
+            {
+                *found = 1;
+            }
+        }
+    }
+
+    registry_exit(v);
+    return err;
+}
+
+#else
+
+// LCOV_EXCL_START
+SEMY_API semy_error_t semy_registry_init(semy_registry_t *registry)
+{
+    if (registry != NULL)
+    {
+        memset(registry, 0, sizeof(registry[0]));
+    }
+    return SEMY_INVALID_OPERATION;
+}
+
+SEMY_API void semy_registry_free(semy_registry_t *registry)
+{
+    (void)registry;
+}
+
+SEMY_API semy_error_t semy_registry_add(semy_registry_t *registry, const char *name, const char *version)
+{
+    (void)registry;
+    (void)name;
+    (void)version;
+    return SEMY_INVALID_OPERATION;
+}
+
+SEMY_API semy_error_t semy_registry_publish(semy_registry_t *registry)
+{
+    (void)registry;
+    return SEMY_INVALID_OPERATION;
+}
+
+SEMY_API semy_error_t semy_registry_attach(semy_registry_t *registry, semy_registry_reader_t *reader)
+{
+    (void)registry;
+    (void)reader;
+    return SEMY_INVALID_OPERATION;
+}
+
+SEMY_API void semy_registry_detach(semy_registry_reader_t *reader)
+{
+    (void)reader;
+}
+
+SEMY_API semy_error_t semy_registry_pin(semy_registry_reader_t *reader)
+{
+    (void)reader;
+    return SEMY_INVALID_OPERATION;
+}
+
+SEMY_API semy_error_t semy_registry_unpin(semy_registry_reader_t *reader)
+{
+    (void)reader;
+    return SEMY_INVALID_OPERATION;
+}
+
+SEMY_API semy_error_t semy_registry_contains(semy_registry_reader_t *reader, const char *name, const semy_t *version, int32_t *found)
+{
+    (void)reader;
+    (void)name;
+    (void)version;
+    if (found != NULL)
+    {
+        *found = 0;
+    }
+    return SEMY_INVALID_OPERATION;
+}
+
+SEMY_API semy_error_t semy_registry_highest(semy_registry_reader_t *reader, const char *name, const semy_t *minimum, const semy_t *limit,
+                                            semy_t *semy, size_t size, int32_t *found)
+{
+    (void)reader;
+    (void)name;
+    (void)minimum;
+    (void)limit;
+    (void)semy;
+    (void)size;
+    if (found != NULL)
+    {
+        *found = 0;
+    }
+    return SEMY_INVALID_OPERATION;
+}
+// LCOV_EXCL_STOP
+
+#endif
+
+// Ordered set layout. The set is a B+-tree whose leaves hold the members in order and link
+// to their neighbors, and whose internal nodes hold separators: separator i of a node is the
+// least member of child i + 1. Each member is ordered by its index key followed by the version
+// string; index keys are never a prefix of one another, so the string only orders versions
+// equal in precedence. Nodes keep the first eight bytes of each key as a big-endian integer
+// beside it, so most comparisons while searching a node don't dereference the member.
+//
+// Nodes hold at most SET_ORDER separators or members, except transiently while inserting, and
+// every node but the root holds at least SET_MIN. Inserting reserves a spare node per level
+// beforehand so a split never fails to allocate after the tree has been modified.
+#define SET_ORDER 32
+#define SET_MIN (SET_ORDER / 2)
+#define MAX_SET_KEY_LENGTH (MAX_KEY_LENGTH + MAX_VERSION_LENGTH + 1)
+
+struct setEntry
+{
+    uint64_t prefix;
+    uint16_t length;  // The length of the key, which is followed by a null byte.
+    uint16_t version; // The offset of the version string in the key.
+    uint8_t key[];
+};
+
+struct setNode
+{
+    size_t count;
+    bool leaf;
+    struct setNode *previous; // Leaf neighbors; 'next' also links spare nodes.
+    struct setNode *next;
+    uint64_t prefixes[SET_ORDER + 1];
+    struct setEntry *entries[SET_ORDER + 1];
+    struct setNode *children[SET_ORDER + 2]; // Internal nodes only.
+};
+
+struct set
+{
+    struct setNode *root;
+    struct setNode *spare;
+    size_t spare_count;
+    size_t height;
+    size_t count;
+};
+
+struct setKey
+{
+    uint64_t prefix;
+    size_t length;
+    size_t precedence; // The length of the index key.
+    uint8_t bytes[MAX_SET_KEY_LENGTH + 1];
+};
+
+static_assert(sizeof(struct set) <= sizeof(semy_set_t), "expected the set to fit");
+static_assert(MAX_SET_KEY_LENGTH <= UINT16_MAX, "expected keys to fit 16 bits");
+
+static uint64_t load_be64(const uint8_t *bytes)
+{
+    uint64_t value = 0;
+    for (int i = 0; i < 8; i++)
+    {
+        value = (value << 8) | bytes[i];
+    }
+    return value;
+}
+
+static semy_error_t set_key(const char *version, struct setKey *key)
+{
+    struct semVer sv;
+    const semy_error_t err = parse(&sv, version);
+    if (err != SEMY_NO_ERROR)
+    {
+        return err;
+    }
+
+    // Index keys are at least 13 bytes, so the prefix is always within the key.
+    const size_t slen = strlen(version);
+    key->precedence = encode_key(&sv, key->bytes);
+    memcpy(&key->bytes[key->precedence], version, slen + 1);
+    key->length = key->precedence + slen;
+    key->prefix = load_be64(key->bytes);
+    return SEMY_NO_ERROR;
+}
+
+static int set_compare(const struct setKey *key, const struct setNode *node, size_t i)
+{
+    if (key->prefix != node->prefixes[i])
+    {
+        return (key->prefix < node->prefixes[i]) ? -1 : 1;
+    }
+    const struct setEntry *entry = node->entries[i];
+    return compare_keys(key->bytes, key->length, entry->key, entry->length);
+}
+
+// Returns the number of keys in the node less than 'key' or, if 'inclusive', not greater than it.
+static size_t set_rank(const struct setNode *node, const struct setKey *key, bool inclusive)
+{
+    size_t low = 0;
+    size_t high = node->count;
+    while (low < high)
+    {
+        const size_t middle = low + ((high - low) / 2);
+        const int result = set_compare(key, node, middle);
+        if (result > 0 || (inclusive && result == 0))
+        {
+            low = middle + 1;
+        }
+        else
+        {
+            high = middle;
+        }
+    }
+    return low;
+}
+
+static void set_put(struct setNode *node, size_t i, struct setEntry *entry)
+{
+    node->entries[i] = entry;
+    node->prefixes[i] = entry->prefix;
+}
+
+// Inserts 'entry' at position 'i' and, in an internal node, 'child' to its right.
+static void set_node_insert(struct setNode *node, size_t i, struct setEntry *entry, struct setNode *child)
+{
+    const size_t moved = node->count - i;
+    memmove(&node->entries[i + 1], &node->entries[i], moved * sizeof(node->entries[0]));
+    memmove(&node->prefixes[i + 1], &node->prefixes[i], moved * sizeof(node->prefixes[0]));
+    if (!node->leaf)
+    {
+        memmove(&node->children[i + 2], &node->children[i + 1], moved * sizeof(node->children[0]));
+        node->children[i + 1] = child;
+    }
+    set_put(node, i, entry);
+    node->count += 1;
+}
+
+// Removes the entry at position 'i' and, in an internal node, the child to its right.
+static void set_node_remove(struct setNode *node, size_t i)
+{
+    const size_t moved = node->count - i - 1;
+    memmove(&node->entries[i], &node->entries[i + 1], moved * sizeof(node->entries[0]));
+    memmove(&node->prefixes[i], &node->prefixes[i + 1], moved * sizeof(node->prefixes[0]));
+    if (!node->leaf)
+    {
+        memmove(&node->children[i + 1], &node->children[i + 2], moved * sizeof(node->children[0]));
+    }
+    node->count -= 1;
+}
+
+// Appends 'count' entries of 'from', starting at 'first', to 'to' along with the children to their right.
+static void set_node_append(struct setNode *to, const struct setNode *from, size_t first, size_t count)
+{
+    memcpy(&to->entries[to->count], &from->entries[first], count * sizeof(to->entries[0]));
+    memcpy(&to->prefixes[to->count], &from->prefixes[first], count * sizeof(to->prefixes[0]));
+    if (!to->leaf)
+    {
+        memcpy(&to->children[to->count + 1], &from->children[first + 1], count * sizeof(to->children[0]));
+    }
+    to->count += count;
+}
+
+static struct setNode *set_take(struct set *s, bool leaf)
+{
+    struct setNode *node = s->spare;
+    s->spare = node->next;
+    s->spare_count -= 1;
+    memset(node, 0, offsetof(struct setNode, prefixes));
+    node->leaf = leaf;
+    return node;
+}
+
+static struct setEntry *set_first(const struct setNode *node)
+{
+    while (!node->leaf)
+    {
+        node = node->children[0];
+    }
+    return node->entries[0];
+}
+
+static void set_free_node(struct setNode *node)
+{
+    if (node->leaf)
+    {
+        for (size_t i = 0; i < node->count; i++)
+        {
+            free(node->entries[i]);
+        }
+    }
+    else
+    {
+        for (size_t i = 0; i <= node->count; i++)
+        {
+            set_free_node(node->children[i]);
+        }
+    }
+    free(node);
+}
+
+SEMY_API semy_error_t semy_set_init(semy_set_t *set)
+{
+    if (set == NULL)
+    {
+        return SEMY_INVALID_OPERATION;
+    }
+
+    memset(set, 0, sizeof(set[0]));
+    return SEMY_NO_ERROR;
+}
+
+SEMY_API void semy_set_free(semy_set_t *set)
+{
+    if (set == NULL)
+    {
+        return;
+    }
+
+    struct set *s = (struct set *)set->buf;
+    if (s->root != NULL)
+    {
+        set_free_node(s->root);
+    }
+
+    while (s->spare != NULL)
+    {
+        struct setNode *next = s->spare->next;
+        free(s->spare);
+        s->spare = next;
+    }
+    memset(set, 0, sizeof(set[0]));
+}
+
+// Inserts 'entry' into the subtree of 'node' and returns false if it's already there. If the
+// node overflows, then it's split and 'split' is populated with its new right sibling and
+// 'separator' with the least member of the sibling's subtree.
+static bool set_insert_node(struct set *s, struct setNode *node, const struct setKey *key, struct setEntry *entry,
+                            struct setNode **split, struct setEntry **separator)
+{
+    *split = NULL;
+    const size_t i = set_rank(node, key, true);
+    if (node->leaf)
+    {
+        if (i > 0 && set_compare(key, node, i - 1) == 0)
+        {
+            return false;
+        }
+        set_node_insert(node, i, entry, NULL);
+    }
+    else
+    {
+        struct setNode *child = NULL;
+        struct setEntry *child_separator = NULL;
+        if (!set_insert_node(s, node->children[i], key, entry, &child, &child_separator))
+        {
+            return false;
+        }
+
+        if (child == NULL)
+        {
+            return true;
+        }
+        set_node_insert(node, i, child_separator, child);
+    }
+
+    if (node->count <= SET_ORDER)
+    {
+        return true;
+    }
+
+    // Leaves keep the least member of the sibling whereas internal nodes move their middle
+    // separator up to their parent.
+    struct setNode *sibling = set_take(s, node->leaf);
+    const size_t middle = node->count / 2;
+    if (node->leaf)
+    {
+        set_node_append(sibling, node, middle, node->count - middle);
+        node->count = middle;
+        sibling->previous = node;
+        sibling->next = node->next;
+        if (node->next != NULL)
+        {
+            node->next->previous = sibling;
+        }
+        node->next = sibling;
+        *separator = sibling->entries[0];
+    }
+    else
+    {
+        sibling->children[0] = node->children[middle + 1];
+        set_node_append(sibling, node, middle + 1, node->count - middle - 1);
+        *separator = node->entries[middle];
+        node->count = middle;
+    }
+    *split = sibling;
+    return true;
+}
+
+SEMY_API semy_error_t semy_set_insert(semy_set_t *set, const char *version, int32_t *inserted)
+{
+    if (set == NULL || version == NULL)
+    {
+        return SEMY_INVALID_OPERATION;
+    }
+
+    struct setKey key;
+    const semy_error_t err = set_key(version, &key);
+    if (err != SEMY_NO_ERROR)
+    {
+        return err;
+    }
+
+    // Each level splits at most once and the root may need a new parent.
+    struct set *s = (struct set *)set->buf;
+    while (s->spare_count < s->height + 1)
+    {
+        struct setNode *node = malloc(sizeof(struct setNode));
+        if (node == NULL)
+        {
+            return SEMY_OUT_OF_MEMORY; // LCOV_EXCL_LINE
+        }
+        node->next = s->spare;
+        s->spare = node;
+        s->spare_count += 1;
+    }
+
+    struct setEntry *entry = malloc(sizeof(struct setEntry) + key.length + 1);
+    if (entry == NULL)
+    {
+        return SEMY_OUT_OF_MEMORY; // LCOV_EXCL_LINE
+    }
+    entry->prefix = key.prefix;
+    entry->length = (uint16_t)key.length;
+    entry->version = (uint16_t)key.precedence;
+    memcpy(entry->key, key.bytes, key.length + 1);
+
+    if (s->root == NULL)
+    {
+        s->root = set_take(s, true);
+        s->height = 1;
+    }
+
+    struct setNode *split = NULL;
+    struct setEntry *separator = NULL;
+    if (!set_insert_node(s, s->root, &key, entry, &split, &separator))
+    {
+        free(entry);
+        if (inserted != NULL)
+        {
+            *inserted = 0;
+        }
+        return SEMY_NO_ERROR;
+    }
+
+    if (split != NULL)
+    {
+        struct setNode *root = set_take(s, false);
+        root->children[0] = s->root;
+        set_node_insert(root, 0, separator, split);
+        s->root = root;
+        s->height += 1;
+    }
+
+    s->count += 1;
+    if (inserted != NULL)
+    {
+        *inserted = 1;
+    }
+    return SEMY_NO_ERROR;
+}
+
+// Refills child 'i' of 'node', which has one fewer than SET_MIN entries, by borrowing an entry
+// from a sibling that can spare one or otherwise by merging it with a sibling.
+static void set_rebalance(struct setNode *node, size_t i)
+{
+    struct setNode *child = node->children[i];
+    struct setNode *left = (i > 0) ? node->children[i - 1] : NULL;
+    struct setNode *right = (i < node->count) ? node->children[i + 1] : NULL;
+
+    if (left != NULL && left->count > SET_MIN)
+    {
+        if (child->leaf)
+        {
+            set_node_insert(child, 0, left->entries[left->count - 1], NULL);
+        }
+        else
+        {
+            // The separator comes down in front of the child and the left's last goes up.
+            set_node_insert(child, 0, node->entries[i - 1], child->children[0]);
+            child->children[0] = left->children[left->count];
+        }
+        set_put(node, i - 1, child->leaf ? child->entries[0] : left->entries[left->count - 1]);
+        left->count -= 1;
+        return;
+    }
+
+    if (right != NULL && right->count > SET_MIN)
+    {
+        if (child->leaf)
+        {
+            set_node_append(child, right, 0, 1);
+            set_node_remove(right, 0);
+            set_put(node, i, right->entries[0]);
+        }
+        else
+        {
+            // The separator comes down after the child and the right's first goes up.
+            set_node_insert(child, child->count, node->entries[i], right->children[0]);
+            set_put(node, i, right->entries[0]);
+            struct setNode *first = right->children[1];
+            set_node_remove(right, 0);
+            right->children[0] = first;
+        }
+        return;
+    }
+
+    // Merge the right one of the pair into the left one.
+    const size_t j = (left != NULL) ? i - 1 : i;
+    left = node->children[j];
+    right = node->children[j + 1];
+    if (left->leaf)
+    {
+        left->next = right->next;
+        if (right->next != NULL)
+        {
+            right->next->previous = left;
+        }
+    }
+    else
+    {
+        set_node_insert(left, left->count, node->entries[j], right->children[0]);
+    }
+    set_node_append(left, right, 0, right->count);
+    set_node_remove(node, j);
+    free(right);
+}
+
+// Erases the member with 'key' from the subtree of 'node' and returns it or null if it's not there.
+static struct setEntry *set_erase_node(struct setNode *node, const struct setKey *key)
+{
+    const size_t i = set_rank(node, key, true);
+    if (node->leaf)
+    {
+        if (i == 0 || set_compare(key, node, i - 1) != 0)
+        {
+            return NULL;
+        }
+
+        struct setEntry *entry = node->entries[i - 1];
+        set_node_remove(node, i - 1);
+        return entry;
+    }
+
+    struct setEntry *entry = set_erase_node(node->children[i], key);
+    if (entry == NULL)
+    {
+        return NULL;
+    }
+
+    // The erased member is a separator if it was the least of its subtree. It's replaced
+    // before rebalancing might move the separator into a child.
+    if (i > 0 && node->entries[i - 1] == entry)
+    {
+        set_put(node, i - 1, set_first(node->children[i]));
+    }
+
+    if (node->children[i]->count < SET_MIN)
+    {
+        set_rebalance(node, i);
+    }
+    return entry;
+}
+
+SEMY_API semy_error_t semy_set_erase(semy_set_t *set, const char *version, int32_t *erased)
+{
+    if (set == NULL || version == NULL)
+    {
+        return SEMY_INVALID_OPERATION;
+    }
+
+    struct setKey key;
+    const semy_error_t err = set_key(version, &key);
+    if (err != SEMY_NO_ERROR)
+    {
+        return err;
+    }
+
+    struct set *s = (struct set *)set->buf;
+    struct setEntry *entry = (s->root == NULL) ? NULL : set_erase_node(s->root, &key);
+    if (erased != NULL)
+    {
+        *erased = (entry != NULL) ? 1 : 0;
+    }
+
+    if (entry == NULL)
+    {
+        return SEMY_NO_ERROR;
+    }
+    free(entry);
+    s->count -= 1;
+
+    // The tree shrinks from the root once it has a single child or no members.
+    if (!s->root->leaf && s->root->count == 0)
+    {
+        struct setNode *root = s->root;
+        s->root = root->children[0];
+        s->height -= 1;
+        free(root);
+    }
+    else if (s->root->count == 0)
+    {
+        free(s->root);
+        s->root = NULL;
+        s->height = 0;
+    }
+    return SEMY_NO_ERROR;
+}
+
+SEMY_API size_t semy_set_count(const semy_set_t *set)
+{
+    if (set == NULL)
+    {
+        return 0;
+    }
+    return ((const struct set *)set->buf)->count;
+}
+
+static const char *set_member(const struct setEntry *entry)
+{
+    return (const char *)&entry->key[entry->version];
+}
+
+// Returns the leaf where 'key' belongs and populates 'position' with the number of its members
+// less than 'key' or, if 'inclusive', not greater than it. Returns null if the set is empty.
+static const struct setNode *set_locate(const struct set *s, const struct setKey *key, bool inclusive, size_t *position)
+{
+    const struct setNode *node = s->root;
+    if (node == NULL)
+    {
+        return NULL;
+    }
+
+    while (!node->leaf)
+    {
+        node = node->children[set_rank(node, key, true)];
+    }
+    *position = set_rank(node, key, inclusive);
+    return node;
+}
+
+// Returns the member at 'position' of 'node', following the leaf links past the end of it.
+static const struct setEntry *set_at(const struct setNode *node, size_t position)
+{
+    if (node != NULL && position == node->count)
+    {
+        node = node->next;
+        position = 0;
+    }
+    return (node != NULL) ? node->entries[position] : NULL;
+}
+
+static semy_error_t set_query(const semy_set_t *set, const char *version, const char **member, struct setKey *key)
+{
+    if (set == NULL || member == NULL)
+    {
+        return SEMY_INVALID_OPERATION;
+    }
+
+    *member = NULL;
+    if (version == NULL)
+    {
+        return SEMY_NO_ERROR;
+    }
+    return set_key(version, key);
+}
+
+SEMY_API semy_error_t semy_set_find(const semy_set_t *set, const char *version, const char **member)
+{
+    if (version == NULL)
+    {
+        return SEMY_INVALID_OPERATION;
+    }
+
+    struct setKey key;
+    const semy_error_t err = set_query(set, version, member, &key);
+    if (err != SEMY_NO_ERROR)
+    {
+        return err;
+    }
+
+    // The first member equal in precedence is the first whose key starts with the index key.
+    size_t position = 0;
+    key.length = key.precedence;
+    const struct setNode *node = set_locate((const struct set *)set->buf, &key, false, &position);
+    const struct setEntry *entry = set_at(node, position);
+    if (entry != NULL && entry->version == key.precedence && memcmp(entry->key, key.bytes, key.precedence) == 0)
+    {
+        *member = set_member(entry);
+    }
+    return SEMY_NO_ERROR;
+}
+
+SEMY_API semy_error_t semy_set_predecessor(const semy_set_t *set, const char *version, const char **member)
+{
+    struct setKey key;
+    const semy_error_t err = set_query(set, version, member, &key);
+    if (err != SEMY_NO_ERROR)
+    {
+        return err;
+    }
+
+    const struct set *s = (const struct set *)set->buf;
+    const struct setNode *node = s->root;
+    size_t position = 0;
+    if (version == NULL)
+    {
+        // The last member is at the end of the rightmost leaf.
+        while (node != NULL && !node->leaf)
+        {
+            node = node->children[node->count];
+        }
+        position = (node != NULL) ? node->count : 0;
+    }
+    else
+    {
+        node = set_locate(s, &key, false, &position);
+    }
+
+    if (node != NULL && position == 0)
+    {
+        node = node->previous;
+        position = (node != NULL) ? node->count : 0;
+    }
+
+    if (node != NULL)
+    {
+        *member = set_member(node->entries[position - 1]);
+    }
+    return SEMY_NO_ERROR;
+}
+
+SEMY_API semy_error_t semy_set_successor(const semy_set_t *set, const char *version, const char **member)
+{
+    struct setKey key;
+    const semy_error_t err = set_query(set, version, member, &key);
+    if (err != SEMY_NO_ERROR)
+    {
+        return err;
+    }
+
+    const struct set *s = (const struct set *)set->buf;
+    const struct setEntry *entry = NULL;
+    if (version == NULL)
+    {
+        entry = (s->root != NULL) ? set_first(s->root) : NULL;
+    }
+    else
+    {
+        size_t position = 0;
+        const struct setNode *node = set_locate(s, &key, true, &position);
+        entry = set_at(node, position);
+    }
+
+    if (entry != NULL)
+    {
+        *member = set_member(entry);
+    }
+    return SEMY_NO_ERROR;
+}
+
+// Binary encoding. Unsigned integers are variable-length: seven bits per byte, least
+// significant first, with the high bit set on every byte but the last.
+//
+//   core:        the major, minor, and patch versions.
+//   identifiers: the pre-release identifier count shifted left once, with the low bit
+//                set if build metadata follows.
+//   pre-release: for each identifier, a numeric value shifted left once with the low bit
+//                set or the length of an alphanumeric identifier shifted left once followed
+//                by its characters.
+//   build:       if present, the build identifier count followed by the length and
+//                characters of each identifier.
+#define MAX_VARINT_LENGTH 10
+
+static size_t put_varint(uint8_t *out, size_t offset, uint64_t value)
+{
+    while (value >= 0x80)
+    {
+        if (out != NULL)
+        {
+            out[offset] = (uint8_t)(value | 0x80);
+        }
+        offset += 1;
+        value >>= 7;
+    }
+
+    if (out != NULL)
+    {
+        out[offset] = (uint8_t)value;
+    }
+    return offset + 1;
+}
+
+static size_t put_bytes(uint8_t *out, size_t offset, const char *s, size_t slen)
+{
+    if (out != NULL)
+    {
+        memcpy(&out[offset], s, slen);
+    }
+    return offset + slen;
+}
+
+// Encodes a version into 'out' and returns its length. If 'out' is null, then only the
+// length is computed.
+static size_t encode(const struct packedView *view, uint8_t *out)
+{
+    size_t offset = 0;
+    for (int32_t i = 0; i < VERSION_CORE_COUNT; i++)
+    {
+        offset = put_varint(out, offset, (uint64_t)view->versions[i]);
+    }
+
+    const uint64_t has_build = (view->build_metadata_count > 0);
+    offset = put_varint(out, offset, ((uint64_t)view->pre_release_count << 1) | has_build);
+
+    const char *s = view->strings;
+    for (int32_t i = 0; i < view->pre_release_count; i++)
+    {
+        const size_t slen = strlen(s);
+        if (is_numeric(s))
+        {
+            // Numeric identifiers were validated to fit 32 bits when they were parsed.
+            int32_t value = 0;
+            str2int(s, slen, &value);
+            offset = put_varint(out, offset, ((uint64_t)value << 1) | 1);
+        }
+        else
+        {
+            offset = put_varint(out, offset, (uint64_t)slen << 1);
+            offset = put_bytes(out, offset, s, slen);
+        }
+        s += slen + 1;
+    }
+
+    if (has_build)
+    {
+        offset = put_varint(out, offset, (uint64_t)view->build_metadata_count);
+        for (int32_t i = 0; i < view->build_metadata_count; i++)
+        {
+            const size_t slen = strlen(s);
+            offset = put_varint(out, offset, (uint64_t)slen);
+            offset = put_bytes(out, offset, s, slen);
+            s += slen + 1;
+        }
+    }
+    return offset;
+}
+
+SEMY_API semy_error_t semy_encode(const semy_t *semy, void *buffer, size_t *size)
+{
+    if (semy == NULL || size == NULL)
+    {
+        return SEMY_INVALID_OPERATION;
+    }
+
+    const struct packedView view = packed_view(semy);
+    const size_t required = encode(&view, NULL);
+    if (buffer == NULL)
+    {
+        *size = required;
+        return SEMY_NO_ERROR;
+    }
+
+    if (*size < required)
+    {
+        *size = required;
+        return SEMY_INVALID_OPERATION;
+    }
+
+    *size = encode(&view, (uint8_t *)buffer);
+    return SEMY_NO_ERROR;
+}
+
+// Reads a variable-length integer no greater than 'maximum'. Overlong encodings, those ending
+// in a zero byte after a continuation byte, and encodings beyond 64 bits are malformed so
+// every integer has exactly one encoding.
+static semy_error_t get_varint(const uint8_t *data, size_t length, size_t *offset, uint64_t maximum, uint64_t *value)
+{
+    uint64_t result = 0;
+    for (size_t i = 0; i < MAX_VARINT_LENGTH; i++)
+    {
+        if (*offset >= length)
+        {
+            return SEMY_BAD_SYNTAX;
+        }
+
+        const uint8_t byte = data[*offset];
+        *offset += 1;
+        result |= (uint64_t)(byte & 0x7F) << (7 * i);
+        if ((byte & 0x80) == 0)
+        {
+            if ((i > 0 && byte == 0) || (i == MAX_VARINT_LENGTH - 1 && byte > 1))
+            {
+                return SEMY_BAD_SYNTAX;
+            }
+            if (result > maximum)
+            {
+                return SEMY_LIMITS_EXCEEDED;
+            }
+            *value = result;
+            return SEMY_NO_ERROR;
+        }
+    }
+    return SEMY_BAD_SYNTAX;
+}
+
+// Reads the 'count' characters of an identifier and verifies they're all identifier
+// characters and, for alphanumeric identifiers, that at least one isn't a digit.
+static semy_error_t get_identifier(const uint8_t *data, size_t length, size_t *offset, uint64_t count, bool is_alnum, const char **s)
+{
+    if (count == 0 || count > length - *offset)
+    {
+        return SEMY_BAD_SYNTAX;
+    }
+
+    const char *characters = (const char *)&data[*offset];
+    bool has_non_digit = false;
+    for (size_t i = 0; i < count; i++)
+    {
+        if (is_non_digit(characters[i]))
+        {
+            has_non_digit = true;
+        }
+        else if (!is_digit(characters[i]))
+        {
+            return SEMY_BAD_SYNTAX;
+        }
+    }
+
+    if (is_alnum && !has_non_digit)
+    {
+        return SEMY_BAD_SYNTAX;
+    }
+
+    *offset += (size_t)count;
+    *s = characters;
+    return SEMY_NO_ERROR;
+}
+
+// Adds a decoded identifier to the full layout or, if 'packed' isn't null, to a packed layout
+// whose strings end at 'end'.
+static semy_error_t add_decoded(struct semVer *full, struct semVerCompact *packed, char **strings, const char *end,
+                                bool pre_release, bool is_alnum, const char *s, size_t slen)
+{
+    if (packed != NULL)
+    {
+        uint8_t *count = pre_release ? &packed->pre_release_count : &packed->build_metadata_count;
+        return append_packed(count, strings, end, s, slen);
+    }
+
+    if ((size_t)(MAX_VERSION_LENGTH - full->chars_allocated) <= slen)
+    {
+        return SEMY_LIMITS_EXCEEDED;
+    }
+    return pre_release ? add_pre_release_identifier(full, is_alnum, s, slen) : add_build_metadata(full, s, slen);
+}
+
+SEMY_API semy_error_t semy_decode(semy_t *semy, size_t size, const void *data, size_t *length)
+{
+    if (semy == NULL || data == NULL || length == NULL)
+    {
+        return SEMY_INVALID_OPERATION;
+    }
+
+    struct semVer *full = NULL;
+    struct semVerCompact *packed = NULL;
+    int32_t *versions = NULL;
+    char *strings = NULL;
+    const char *end = NULL;
+    if (size == sizeof(struct semVer))
+    {
+        full = (struct semVer *)semy->buf;
+        memset(full, 0, sizeof(full[0]));
+        versions = full->versions;
+    }
+    else if (is_packed_size(size))
+    {
+        packed = (struct semVerCompact *)semy->buf;
+        memset(packed, 0, offsetof(struct semVerCompact, strings));
+        packed->layout = -(int32_t)size;
+        versions = packed->versions;
+        strings = packed->strings;
+        end = (const char *)packed + size;
+    }
+    else
+    {
+        return SEMY_INVALID_OPERATION;
+    }
+
+    const uint8_t *bytes = (const uint8_t *)data;
+    size_t offset = 0;
+    uint64_t value = 0;
+    semy_error_t err = SEMY_NO_ERROR;
+    for (int32_t i = 0; i < VERSION_CORE_COUNT; i++)
+    {
+        err = get_varint(bytes, *length, &offset, INT32_MAX, &value);
+        if (err != SEMY_NO_ERROR)
+        {
+            return err;
+        }
+        versions[i] = (int32_t)value;
+    }
+
+    err = get_varint(bytes, *length, &offset, UINT64_MAX, &value);
+    if (err != SEMY_NO_ERROR)
+    {
+        return err;
+    }
+    const uint64_t pre_release_count = value >> 1;
+    const bool has_build = (value & 1) != 0;
+
+    for (uint64_t i = 0; i < pre_release_count; i++)
+    {
+        char digits[16];
+        const char *s = NULL;
+        size_t slen = 0;
+        err = get_varint(bytes, *length, &offset, UINT64_MAX, &value);
+        if (err != SEMY_NO_ERROR)
+        {
+            return err;
+        }
+
+        const bool is_alnum = (value & 1) == 0;
+        value >>= 1;
+        if (is_alnum)
+        {
+            err = get_identifier(bytes, *length, &offset, value, true, &s);
+            slen = (size_t)value;
+        }
+        else if (value > INT32_MAX)
+        {
+            err = SEMY_LIMITS_EXCEEDED;
+        }
+        else
+        {
+            // Format the digits backwards from the end of the buffer.
+            size_t start = sizeof(digits);
+            do
+            {
+                digits[--start] = (char)('0' + (value % 10));
+                value /= 10;
+            } while (value > 0);
+            s = &digits[start];
+            slen = sizeof(digits) - start;
+        }
+
+        if (err == SEMY_NO_ERROR)
+        {
+            err = add_decoded(full, packed, &strings, end, true, is_alnum, s, slen);
+        }
+
+        if (err != SEMY_NO_ERROR)
+        {
+            return err;
+        }
+    }
+
+    if (has_build)
+    {
+        uint64_t build_metadata_count = 0;
+        err = get_varint(bytes, *length, &offset, UINT64_MAX, &build_metadata_count);
+        if (err == SEMY_NO_ERROR && build_metadata_count == 0)
+        {
+            err = SEMY_BAD_SYNTAX;
+        }
+
+        for (uint64_t i = 0; err == SEMY_NO_ERROR && i < build_metadata_count; i++)
+        {
+            const char *s = NULL;
+            err = get_varint(bytes, *length, &offset, UINT64_MAX, &value);
+            if (err == SEMY_NO_ERROR)
+            {
+                err = get_identifier(bytes, *length, &offset, value, false, &s);
+            }
+
+            if (err == SEMY_NO_ERROR)
+            {
+                err = add_decoded(full, packed, &strings, end, false, false, s, (size_t)value);
+            }
+        }
+
+        if (err != SEMY_NO_ERROR)
+        {
+            return err;
+        }
+    }
+
+    *length = offset;
+    return SEMY_NO_ERROR;
+}
+
+SEMY_API semy_error_t semy_stats_get(semy_stats_t *out)
+{
+    if (out == NULL)
+    {
+        return SEMY_INVALID_OPERATION;
+    }
+
+#if defined(SEMY_STATS)
+    *out = stats;
+    return SEMY_NO_ERROR;
+#else
+    memset(out, 0, sizeof(out[0]));
+    return SEMY_INVALID_OPERATION;
+#endif
+}
+
+SEMY_API void semy_stats_reset(void)
+{
+#if defined(SEMY_STATS)
+    memset(&stats, 0, sizeof(stats));
+#endif
+}
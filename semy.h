@@ -34,6 +34,7 @@ typedef enum semy_error
     SEMY_INVALID_OPERATION,         // The API was misused (e.g. null was passed where non-null was expected).
     SEMY_BAD_SYNTAX,                // The semantic version string is invalid.
     SEMY_LIMITS_EXCEEDED,           // An implementation limit was hit (e.g. integer overflow, too many build identifiers).
+    SEMY_OUT_OF_MEMORY,             // Memory could not be allocated.
     SEMY_FORCE_32_BIT = 0x7FFFFFFF, // PRIVATE: Do not touch!
 } semy_error_t;
 
@@ -42,10 +43,55 @@ typedef struct semy
     char buf[512]; // PRIVATE: Do not touch!
 } semy_t;
 
+// Compact alternatives to 'semy_t' for versions with few, short identifiers. They're
+// passed to the functions of this library cast to 'semy_t' and the size of the structure
+// given to 'semy_parse' selects the layout. Each stores the pre-release and build
+// identifiers, null terminated, in 14 and 46 bytes respectively.
+typedef struct semy_compact32
+{
+    int32_t buf[8]; // PRIVATE: Do not touch!
+} semy_compact32_t;
+
+typedef struct semy_compact64
+{
+    int32_t buf[16]; // PRIVATE: Do not touch!
+} semy_compact64_t;
+
+// Versions longer than 200 characters or with more than 25 pre-release or build identifiers
+// exceed the limits of 'semy_t'. They can be parsed into an extended layout instead, which
+// is a caller-allocated buffer of any size larger than 'semy_t', aligned for 'int32_t'.
+// It stores up to 255 pre-release and 255 build identifiers in 'size' - 18 bytes. They need
+// at most one byte per character of the version beyond its first five, so
+// SEMY_EXTENDED_SIZE(length) bytes holds any version of 'length' characters.
+#define SEMY_EXTENDED_SIZE(length) ((length) + 14 > 512 ? (((length) + 14 + 3) & ~(size_t)3) : 516)
+
 // This function parses the 'version' string and populates the 'semy' structure with the results.
-// The 'size' parameter must be equal to the sizeof the 'semy_t' structure.
+// The 'size' parameter must be equal to the sizeof the 'semy_t', 'semy_compact32_t', or
+// 'semy_compact64_t' structure or the size of an extended layout. If the identifiers of a valid
+// version do not fit a compact or extended layout, then SEMY_LIMITS_EXCEEDED is returned and
+// the version can be parsed into a larger structure instead.
 SEMY_API semy_error_t semy_parse(semy_t *semy, size_t size, const char *version);
 
+// The productions of the Semantic Versioning grammar that 'semy_parse_diagnose' attributes errors to.
+typedef enum semy_production
+{
+    SEMY_PRODUCTION_NONE,                      // The error isn't attributable to a production.
+    SEMY_PRODUCTION_VERSION_CORE,              // The major, minor, and patch versions.
+    SEMY_PRODUCTION_PRE_RELEASE,               // The pre-release identifiers.
+    SEMY_PRODUCTION_BUILD,                     // The build identifiers.
+    SEMY_PRODUCTION_FORCE_32_BIT = 0x7FFFFFFF, // PRIVATE: Do not touch!
+} semy_production_t;
+
+// This function parses like 'semy_parse' and also populates 'offset' with the byte offset
+// in 'version' where parsing failed and 'production' with the production being parsed there.
+// Characters that follow a valid version are attributed to the last production parsed, e.g.
+// "1.0.0-rc_1" fails at offset 8 in SEMY_PRODUCTION_PRE_RELEASE. An identifier that overflows
+// or exceeds a limit is reported at its first character and a version longer than 'semy_t'
+// accepts is reported at the first character beyond the limit. If the version is parsed, or
+// it's valid but doesn't fit the layout, 'offset' is its length and 'production' is
+// SEMY_PRODUCTION_NONE.
+SEMY_API semy_error_t semy_parse_diagnose(semy_t *semy, size_t size, const char *version, size_t *offset, semy_production_t *production);
+
 // The function populates the 'result' with either -1, 0, or 1 depending on if v1 < v2, v1 = v2, v1 > v2.
 SEMY_API semy_error_t semy_compare(const semy_t *v1, const semy_t *v2, int32_t *result);
 
@@ -62,4 +108,281 @@ SEMY_API int32_t semy_get_build_count(const semy_t *semy);
 SEMY_API const char *semy_get_pre_release(const semy_t *semy, int32_t index);
 SEMY_API const char *semy_get_build(const semy_t *semy, int32_t index);
 
+// An index is an immutable, sorted collection of semantic versions stored in a single
+// contiguous buffer that can be written to disk and memory mapped. Versions are ordered
+// by precedence; versions that differ only by build metadata keep their input order.
+typedef struct semy_index
+{
+    uint64_t buf[6]; // PRIVATE: Do not touch!
+} semy_index_t;
+
+// This function builds an index of 'count' semantic versions into 'buffer'. If 'lengths' is
+// null, then the versions must be null terminated; otherwise 'lengths[i]' is the length
+// of 'versions[i]'. If 'buffer' is null, then 'size' is populated with the required size;
+// otherwise 'size' must point to the size of 'buffer' which must be aligned to 8 bytes.
+SEMY_API semy_error_t semy_index_build(const char *const *versions, const size_t *lengths, size_t count, void *buffer, size_t *size);
+
+// This function opens an index built by 'semy_index_build' without copying or decoding it.
+// The 'data' must remain valid and unmodified for as long as the index is used.
+SEMY_API semy_error_t semy_index_open(semy_index_t *index, const void *data, size_t size);
+
+// This function returns the number of versions in the index or zero if 'index' is null.
+SEMY_API size_t semy_index_count(const semy_index_t *index);
+
+// This function returns the version at 'position' in ascending order or null if 'index' is
+// null or 'position' is out-of-bounds. The pointer belongs to the data of the index.
+SEMY_API const char *semy_index_get(const semy_index_t *index, size_t position);
+
+// This function populates 'lower' with the position of the first version that is not less
+// than 'version' and 'upper' with the position of the first version greater than 'version'.
+// Versions in [lower, upper) are equal to 'version' in precedence.
+// SEMY_LIMITS_EXCEEDED is returned if 'version' is an extended layout beyond the limits of 'semy_t'.
+SEMY_API semy_error_t semy_index_search(const semy_index_t *index, const semy_t *version, size_t *lower, size_t *upper);
+
+// An arena stores many parsed versions for a fraction of the memory of an array of 'semy_t'.
+// The version core of each version is kept in one array and its identifiers are packed into
+// shared slabs, so each version costs 24 bytes plus the length of its identifiers. Versions
+// are referred to by their position in the order they were added.
+typedef struct semy_arena
+{
+    uint64_t buf[6]; // PRIVATE: Do not touch!
+} semy_arena_t;
+
+// This function initializes an empty arena. It allocates nothing until a version is added.
+SEMY_API semy_error_t semy_arena_init(semy_arena_t *arena);
+
+// This function initializes an empty arena that interns alphanumeric pre-release identifiers:
+// each distinct identifier is stored once and versions refer to it by a 32-bit id. After
+// 'semy_arena_rank' the ids are ranked in ASCII order so 'semy_arena_compare' compares
+// identifiers as integers rather than strings.
+SEMY_API semy_error_t semy_arena_init_interned(semy_arena_t *arena);
+
+// This function ranks the identifiers interned since it was last called. Identifiers that
+// aren't ranked yet are still compared correctly, but by their text.
+SEMY_API semy_error_t semy_arena_rank(semy_arena_t *arena);
+
+// This function returns the number of distinct identifiers interned by the arena
+// or zero if 'arena' is null or doesn't intern identifiers.
+SEMY_API size_t semy_arena_identifier_count(const semy_arena_t *arena);
+
+// This function releases the memory of every version in the arena and leaves it empty.
+// An interned arena keeps interning identifiers if it's reused.
+SEMY_API void semy_arena_free(semy_arena_t *arena);
+
+// This function parses the 'version' string and appends it to the arena. If 'position' is
+// non-null, then it's populated with the position of the version. Nothing is appended on error.
+SEMY_API semy_error_t semy_arena_parse(semy_arena_t *arena, const char *version, size_t *position);
+
+// This function returns the number of versions in the arena or zero if 'arena' is null.
+SEMY_API size_t semy_arena_count(const semy_arena_t *arena);
+
+// This function copies the version at 'position' into 'semy' whose 'size' selects its layout as
+// it does for 'semy_parse'. SEMY_LIMITS_EXCEEDED is returned if it does not fit a compact layout.
+SEMY_API semy_error_t semy_arena_get(const semy_arena_t *arena, size_t position, semy_t *semy, size_t size);
+
+// The function populates the 'result' with either -1, 0, or 1 depending on if the version at
+// position 'a' is less than, equal to, or greater than the version at position 'b'.
+SEMY_API semy_error_t semy_arena_compare(const semy_arena_t *arena, size_t a, size_t b, int32_t *result);
+
+// A column store keeps the properties of many versions in separate contiguous arrays so
+// scans only read the properties they test: one array each for the major, minor, and
+// patch versions, a bitmap of the versions with pre-release identifiers, and the packed
+// identifier strings. Versions are referred to by their position in the order they were added.
+typedef struct semy_columns
+{
+    uint64_t buf[12]; // PRIVATE: Do not touch!
+} semy_columns_t;
+
+typedef enum semy_field
+{
+    SEMY_FIELD_MAJOR,
+    SEMY_FIELD_MINOR,
+    SEMY_FIELD_PATCH,
+    SEMY_FIELD_PRE_RELEASE, // 1 if the version has pre-release identifiers and 0 otherwise.
+    SEMY_FIELD_FORCE_32_BIT = 0x7FFFFFFF, // PRIVATE: Do not touch!
+} semy_field_t;
+
+typedef enum semy_operator
+{
+    SEMY_EQ,
+    SEMY_NE,
+    SEMY_LT,
+    SEMY_LE,
+    SEMY_GT,
+    SEMY_GE,
+    SEMY_OPERATOR_FORCE_32_BIT = 0x7FFFFFFF, // PRIVATE: Do not touch!
+} semy_operator_t;
+
+// A predicate is satisfied if 'field' compares to 'value' as 'op' specifies (e.g. major < 7).
+typedef struct semy_predicate
+{
+    semy_field_t field;
+    semy_operator_t op;
+    int32_t value;
+} semy_predicate_t;
+
+// This function initializes an empty column store. It allocates nothing until a version is added.
+SEMY_API semy_error_t semy_columns_init(semy_columns_t *columns);
+
+// This function releases the memory of every version in the column store and leaves it empty.
+SEMY_API void semy_columns_free(semy_columns_t *columns);
+
+// This function appends a parsed version in any layout to the column store.
+SEMY_API semy_error_t semy_columns_append(semy_columns_t *columns, const semy_t *version);
+
+// This function parses 'count' versions into the column store. If 'lengths' is null, then the
+// versions must be null terminated; otherwise 'lengths[i]' is the length of 'versions[i]'.
+// Parsing stops at the first malformed version and 'parsed', if non-null, is populated with
+// the number of versions appended.
+SEMY_API semy_error_t semy_columns_parse(semy_columns_t *columns, const char *const *versions, const size_t *lengths, size_t count, size_t *parsed);
+
+// This function returns the number of versions in the column store or zero if 'columns' is null.
+SEMY_API size_t semy_columns_count(const semy_columns_t *columns);
+
+// These functions return the major, minor, or patch column or the pre-release bitmap, where
+// bit (i % 64) of word (i / 64) is version i, or null if 'columns' is null or 'field' isn't a
+// column. The arrays belong to the column store and are invalidated when a version is added.
+SEMY_API const int32_t *semy_columns_core(const semy_columns_t *columns, semy_field_t field);
+SEMY_API const uint64_t *semy_columns_pre_release(const semy_columns_t *columns);
+
+// This function copies the version at 'position' into 'semy' whose 'size' selects its layout as
+// it does for 'semy_parse'. SEMY_LIMITS_EXCEEDED is returned if it does not fit the layout.
+SEMY_API semy_error_t semy_columns_get(const semy_columns_t *columns, size_t position, semy_t *semy, size_t size);
+
+// This function tests every version against all 'count' predicates and sets bit (i % 64) of
+// 'matches[i / 64]' if version i satisfies them all. The 'matches' array must have room for
+// one word per 64 versions, rounded up; bits past the last version are cleared.
+SEMY_API semy_error_t semy_columns_scan(const semy_columns_t *columns, const semy_predicate_t *predicates, size_t count, uint64_t *matches);
+
+// A registry maps package names to sets of versions that many threads query while one thread
+// adds to it. Queries never lock or wait: they read an immutable snapshot of the registry and
+// the writer publishes its additions in batches by swapping in a new snapshot. A snapshot is
+// freed once no reader can still be reading it. The registry requires C11 atomics; without
+// them every function returns SEMY_INVALID_OPERATION.
+typedef struct semy_registry
+{
+    uint64_t buf[4]; // PRIVATE: Do not touch!
+} semy_registry_t;
+
+// A reader is the handle through which one thread queries a registry. Each querying thread
+// attaches its own reader; a reader must not be used by two threads at once.
+typedef struct semy_registry_reader
+{
+    uint64_t buf[4]; // PRIVATE: Do not touch!
+} semy_registry_reader_t;
+
+// This function initializes an empty registry.
+SEMY_API semy_error_t semy_registry_init(semy_registry_t *registry);
+
+// This function releases the memory of the registry and its readers. No reader may be
+// querying the registry and none may be used afterwards.
+SEMY_API void semy_registry_free(semy_registry_t *registry);
+
+// This function parses 'version' and stages it for addition to the set of versions of the
+// package 'name'. Staged versions aren't visible to readers until 'semy_registry_publish'.
+// Only one thread may add to and publish a registry at a time.
+SEMY_API semy_error_t semy_registry_add(semy_registry_t *registry, const char *name, const char *version);
+
+// This function publishes every staged version in a new snapshot and frees the snapshots no
+// reader can still be reading. Sets of packages without staged versions are shared with the
+// previous snapshot rather than copied. A version identical to one already in its set is
+// ignored. Nothing is published, and the versions stay staged, on error.
+SEMY_API semy_error_t semy_registry_publish(semy_registry_t *registry);
+
+// These functions attach a reader to the registry and detach it. Detached readers are reused
+// by later attachments and are only freed with the registry.
+SEMY_API semy_error_t semy_registry_attach(semy_registry_t *registry, semy_registry_reader_t *reader);
+SEMY_API void semy_registry_detach(semy_registry_reader_t *reader);
+
+// These functions pin the snapshot the reader queries and unpin it. Queries between them see
+// the same snapshot, so several packages can be queried consistently, and skip the bookkeeping
+// each query does otherwise. A pinned snapshot isn't freed, so readers should unpin promptly.
+SEMY_API semy_error_t semy_registry_pin(semy_registry_reader_t *reader);
+SEMY_API semy_error_t semy_registry_unpin(semy_registry_reader_t *reader);
+
+// This function populates 'found' with 1 if the package 'name' has a version equal in
+// precedence to 'version' and 0 otherwise.
+SEMY_API semy_error_t semy_registry_contains(semy_registry_reader_t *reader, const char *name, const semy_t *version, int32_t *found);
+
+// This function finds the highest version of the package 'name' that is not less than 'minimum'
+// and less than 'limit', either of which may be null to leave the range unbounded. If one is
+// found, then 'found' is populated with 1 and the version is copied into 'semy' whose 'size'
+// selects its layout as it does for 'semy_parse'; otherwise 'found' is populated with 0. For
+// example, a 'minimum' of 1.2.0 and a 'limit' of 2.0.0-0 select the highest version from
+// 1.2.0 up to, but excluding, the pre-releases of 2.0.0.
+SEMY_API semy_error_t semy_registry_highest(semy_registry_reader_t *reader, const char *name, const semy_t *minimum, const semy_t *limit,
+                                            semy_t *semy, size_t size, int32_t *found);
+
+// An ordered set keeps versions sorted as they're inserted and erased so they never need to be
+// sorted again. Members are ordered by precedence, as 'semy_compare' orders them, and versions
+// equal in precedence by their build metadata in ASCII order, with the version without build
+// metadata first, so versions differing only by build metadata are distinct members. The set is
+// a B+-tree, so inserting, erasing, and finding a member costs O(log n). Pointers to members
+// belong to the set and are valid until the member is erased.
+typedef struct semy_set
+{
+    uint64_t buf[6]; // PRIVATE: Do not touch!
+} semy_set_t;
+
+// This function initializes an empty set. It allocates nothing until a version is inserted.
+SEMY_API semy_error_t semy_set_init(semy_set_t *set);
+
+// This function releases the memory of every member of the set and leaves it empty.
+SEMY_API void semy_set_free(semy_set_t *set);
+
+// This function parses 'version' and inserts it into the set. If 'inserted' is non-null, then
+// it's populated with 1 if the version was inserted or 0 if the set already had it.
+SEMY_API semy_error_t semy_set_insert(semy_set_t *set, const char *version, int32_t *inserted);
+
+// This function erases the member identical to 'version'. If 'erased' is non-null, then it's
+// populated with 1 if the member was erased or 0 if the set didn't have it.
+SEMY_API semy_error_t semy_set_erase(semy_set_t *set, const char *version, int32_t *erased);
+
+// This function returns the number of members of the set or zero if 'set' is null.
+SEMY_API size_t semy_set_count(const semy_set_t *set);
+
+// This function populates 'member' with the first member equal in precedence to 'version' or
+// null if there isn't one. Later members equal in precedence are found with 'semy_set_successor'.
+SEMY_API semy_error_t semy_set_find(const semy_set_t *set, const char *version, const char **member);
+
+// These functions populate 'member' with the greatest member ordered before 'version' or the
+// least member ordered after it, or null if there isn't one. If 'version' is null, then they
+// find the last and first member respectively, so the set can be iterated in either direction.
+SEMY_API semy_error_t semy_set_predecessor(const semy_set_t *set, const char *version, const char **member);
+SEMY_API semy_error_t semy_set_successor(const semy_set_t *set, const char *version, const char **member);
+
+// This function encodes a parsed version in any layout into a portable binary form that is
+// about as long as the version string. If 'buffer' is null, then 'size' is populated with the
+// required size; otherwise 'size' must point to the size of 'buffer' and is populated with
+// the number of bytes written.
+SEMY_API semy_error_t semy_encode(const semy_t *semy, void *buffer, size_t *size);
+
+// This function decodes a version encoded by 'semy_encode' into 'semy' whose 'size' selects
+// its layout as it does for 'semy_parse'. The 'length' must point to the number of bytes
+// available in 'data' and is populated with the number of bytes decoded, so encoded
+// versions can be stored one after another. SEMY_BAD_SYNTAX is returned if the data is
+// truncated or malformed, including data that isn't exactly what 'semy_encode' produces, so
+// each version has a single encoding.
+SEMY_API semy_error_t semy_decode(semy_t *semy, size_t size, const void *data, size_t *length);
+
+// Statistics on how the calling thread has used the library since it started or last called
+// 'semy_stats_reset'. They're only counted if the library is compiled with SEMY_STATS defined.
+typedef struct semy_stats
+{
+    uint64_t parses;                                // Calls to 'semy_parse'.
+    uint64_t parse_results[SEMY_OUT_OF_MEMORY + 1]; // Calls to 'semy_parse' by the 'semy_error_t' returned.
+    uint64_t parsed_bytes;                          // Bytes read by 'semy_parse': up to the error if one occurred.
+    uint64_t compares;                              // Successful calls to 'semy_compare'.
+    uint64_t core_decided;                          // Compares decided by the major, minor, or patch version.
+    uint64_t pre_release_decided;                   // Compares decided by the pre-release identifiers.
+} semy_stats_t;
+
+// This function populates 'stats' with the statistics of the calling thread. Each thread counts
+// separately, without synchronization, so totals for a process are the sum over its threads.
+// SEMY_INVALID_OPERATION is returned, and 'stats' is zeroed, if statistics aren't compiled in.
+SEMY_API semy_error_t semy_stats_get(semy_stats_t *stats);
+
+// This function zeroes the statistics of the calling thread.
+SEMY_API void semy_stats_reset(void);
+
 #endif
@@ -0,0 +1,275 @@
+// SPDX-License-Identifier: MIT
+/*
+ * Semy - a Semantic Versioning 2.0.0 processor.
+ * See https://semver.org/.
+ *
+ * Copyright (c) 2025-2026 Henry G. Stratmann III
+ * Copyright (c) 2025-2026 Semy Contributors
+ *
+ * This file is part of Semy, distributed under the MIT License.
+ * For full terms see the included LICENSE file.
+ */
+
+#include "semy.h"
+#include "test_utils.h"
+#include <stdio.h>
+#include <string.h>
+
+static const char *versions[] = {
+    "2.0.0",
+    "1.0.0-alpha.beta",
+    "1.0.0+build.2",
+    "1.0.0-beta.11",
+    "1.0.0-alpha",
+    "1.0.0-rc.1",
+    "1.0.0-beta",
+    "1.0.0+build.1",
+    "1.0.0-alpha.1",
+    "1.0.0-beta.2",
+    "1.0.0-alphabet",
+    "1.0.0-0",
+    "1.0.0-a-b",
+    "0.9.10",
+    "0.10.9",
+    "2147483647.2147483647.2147483647",
+    "1.0.0",
+    "1.0.0-x.7.z.92+exp.sha.5114f85.20130313144700",
+};
+
+// Every test runs against a plain arena and an interned arena.
+static void init(semy_arena_t *arena)
+{
+    if (TEST_ITERATION == 0)
+    {
+        ASSERT_EQ((int)SEMY_NO_ERROR, semy_arena_init(arena));
+    }
+    else
+    {
+        ASSERT_EQ((int)SEMY_NO_ERROR, semy_arena_init_interned(arena));
+    }
+}
+
+TEST(arena, parse_and_get, .iterations=2)
+{
+    semy_arena_t arena;
+    init(&arena);
+    ASSERT_EQ(0, semy_arena_count(&arena));
+
+    for (size_t i = 0; i < COUNT_OF(versions); i++)
+    {
+        size_t position = 99;
+        ASSERT_EQ((int)SEMY_NO_ERROR, semy_arena_parse(&arena, versions[i], &position));
+        ASSERT_EQ(i, position);
+    }
+    ASSERT_EQ(COUNT_OF(versions), semy_arena_count(&arena));
+
+    for (size_t i = 0; i < COUNT_OF(versions); i++)
+    {
+        semy_t semver;
+        char output[1024] = {0};
+        ASSERT_EQ((int)SEMY_NO_ERROR, semy_arena_get(&arena, i, &semver, sizeof(semver)));
+        format_version(&semver, output);
+        ASSERT_STR_EQ(versions[i], output);
+    }
+
+    semy_arena_free(&arena);
+    ASSERT_EQ(0, semy_arena_count(&arena));
+}
+
+// Verify the arena compares versions like semy_compare() for every pair.
+static void agrees_with_compare(const semy_arena_t *arena)
+{
+    for (size_t i = 0; i < COUNT_OF(versions); i++)
+    {
+        for (size_t j = 0; j < COUNT_OF(versions); j++)
+        {
+            semy_t a = {0};
+            semy_t b = {0};
+            int32_t expected = -99;
+            int32_t result = -99;
+            ASSERT_EQ((int)SEMY_NO_ERROR, semy_parse(&a, sizeof(a), versions[i]));
+            ASSERT_EQ((int)SEMY_NO_ERROR, semy_parse(&b, sizeof(b), versions[j]));
+            ASSERT_EQ((int)SEMY_NO_ERROR, semy_compare(&a, &b, &expected));
+            ASSERT_EQ((int)SEMY_NO_ERROR, semy_arena_compare(arena, i, j, &result));
+            ASSERT_EQ(expected, result, "unexpected compare result for '%s' and '%s'", versions[i], versions[j]);
+        }
+    }
+}
+
+TEST(arena, agrees_with_compare, .iterations=2)
+{
+    semy_arena_t arena;
+    init(&arena);
+
+    // Rank the identifiers of the first half only so ranked identifiers are
+    // compared with those interned after ranking as well as with each other.
+    for (size_t i = 0; i < COUNT_OF(versions); i++)
+    {
+        ASSERT_EQ((int)SEMY_NO_ERROR, semy_arena_parse(&arena, versions[i], NULL));
+        if (i == COUNT_OF(versions) / 2)
+        {
+            ASSERT_EQ((int)SEMY_NO_ERROR, semy_arena_rank(&arena));
+        }
+    }
+    agrees_with_compare(&arena);
+
+    ASSERT_EQ((int)SEMY_NO_ERROR, semy_arena_rank(&arena));
+    ASSERT_EQ((int)SEMY_NO_ERROR, semy_arena_rank(&arena));
+    agrees_with_compare(&arena);
+
+    semy_arena_free(&arena);
+}
+
+TEST(arena, interned_identifiers)
+{
+    semy_arena_t arena;
+    char version[64];
+    ASSERT_EQ((int)SEMY_NO_ERROR, semy_arena_init_interned(&arena));
+
+    // Each alphanumeric pre-release identifier is stored once however often it occurs.
+    static const char *names[] = {"alpha", "beta", "rc", "SNAPSHOT", "dev", "alpha-1", "x"};
+    for (int i = 0; i < 1000; i++)
+    {
+        sprintf(version, "1.%d.0-%s.%d.%s+%s", i, names[i % COUNT_OF(names)], i, names[(i + 1) % COUNT_OF(names)], names[i % 3]);
+        ASSERT_EQ((int)SEMY_NO_ERROR, semy_arena_parse(&arena, version, NULL));
+    }
+    ASSERT_EQ(COUNT_OF(names), semy_arena_identifier_count(&arena));
+    ASSERT_EQ((int)SEMY_NO_ERROR, semy_arena_rank(&arena));
+
+    semy_t semver;
+    char output[1024] = {0};
+    ASSERT_EQ((int)SEMY_NO_ERROR, semy_arena_get(&arena, 3, &semver, sizeof(semver)));
+    format_version(&semver, output);
+    ASSERT_STR_EQ("1.3.0-SNAPSHOT.3.dev+alpha", output);
+
+    // Uppercase letters precede lowercase letters in ASCII order.
+    int32_t result = 0;
+    ASSERT_EQ((int)SEMY_NO_ERROR, semy_arena_parse(&arena, "1.0.0-SNAPSHOT", NULL));
+    ASSERT_EQ((int)SEMY_NO_ERROR, semy_arena_parse(&arena, "1.0.0-alpha", NULL));
+    ASSERT_EQ((int)SEMY_NO_ERROR, semy_arena_compare(&arena, 1000, 1001, &result));
+    ASSERT_EQ(-1, result);
+
+    // Enough distinct identifiers to grow the intern table several times.
+    for (int i = 0; i < 200; i++)
+    {
+        sprintf(version, "2.0.0-tag%d", i);
+        ASSERT_EQ((int)SEMY_NO_ERROR, semy_arena_parse(&arena, version, NULL));
+    }
+    ASSERT_EQ(COUNT_OF(names) + 200, semy_arena_identifier_count(&arena));
+    ASSERT_EQ((int)SEMY_NO_ERROR, semy_arena_rank(&arena));
+
+    // Identifiers are compared lexically: "tag10" precedes "tag9".
+    ASSERT_EQ((int)SEMY_NO_ERROR, semy_arena_compare(&arena, 1002 + 10, 1002 + 9, &result));
+    ASSERT_EQ(-1, result);
+
+    semy_arena_free(&arena);
+    ASSERT_EQ(0, semy_arena_identifier_count(&arena));
+
+    // A freed arena still interns identifiers when it's reused.
+    ASSERT_EQ((int)SEMY_NO_ERROR, semy_arena_parse(&arena, "1.0.0-beta", NULL));
+    ASSERT_EQ((int)SEMY_NO_ERROR, semy_arena_parse(&arena, "1.0.0-alpha.beta", NULL));
+    ASSERT_EQ(2, semy_arena_identifier_count(&arena));
+    ASSERT_EQ((int)SEMY_NO_ERROR, semy_arena_rank(&arena));
+    ASSERT_EQ((int)SEMY_NO_ERROR, semy_arena_compare(&arena, 0, 1, &result));
+    ASSERT_EQ(1, result);
+
+    semy_arena_free(&arena);
+}
+
+TEST(arena, get_compact, .iterations=2)
+{
+    semy_arena_t arena;
+    semy_compact32_t compact = {0};
+    char output[1024] = {0};
+
+    init(&arena);
+    ASSERT_EQ((int)SEMY_NO_ERROR, semy_arena_parse(&arena, "1.2.3-rc.1+build", NULL));
+    ASSERT_EQ((int)SEMY_NO_ERROR, semy_arena_parse(&arena, "1.2.3-release-candidate.1+build", NULL));
+
+    ASSERT_EQ((int)SEMY_NO_ERROR, semy_arena_get(&arena, 0, (semy_t *)&compact, sizeof(compact)));
+    format_version((const semy_t *)&compact, output);
+    ASSERT_STR_EQ("1.2.3-rc.1+build", output);
+
+    // The identifiers of the second version do not fit the compact layout.
+    ASSERT_EQ((int)SEMY_LIMITS_EXCEEDED, semy_arena_get(&arena, 1, (semy_t *)&compact, sizeof(compact)));
+    ASSERT_EQ((int)SEMY_INVALID_OPERATION, semy_arena_get(&arena, 0, (semy_t *)&compact, sizeof(compact) - 1));
+
+    semy_arena_free(&arena);
+}
+
+// Enough versions to fill several slabs and grow the entries several times.
+TEST(arena, many_versions, .iterations=2)
+{
+    semy_arena_t arena;
+    init(&arena);
+
+    char version[256];
+    for (int i = 0; i < 20000; i++)
+    {
+        sprintf(version, "%d.0.0-alpha.%d+build.aaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaa", i % 7, i);
+        ASSERT_EQ((int)SEMY_NO_ERROR, semy_arena_parse(&arena, version, NULL));
+    }
+    ASSERT_EQ(20000, semy_arena_count(&arena));
+
+    for (int i = 0; i < 20000; i += 997)
+    {
+        semy_t semver;
+        char output[1024] = {0};
+        sprintf(version, "%d.0.0-alpha.%d+build.aaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaa", i % 7, i);
+        ASSERT_EQ((int)SEMY_NO_ERROR, semy_arena_get(&arena, (size_t)i, &semver, sizeof(semver)));
+        format_version(&semver, output);
+        ASSERT_STR_EQ(version, output);
+    }
+
+    int32_t result = 0;
+    ASSERT_EQ((int)SEMY_NO_ERROR, semy_arena_compare(&arena, 7, 19999, &result));
+    ASSERT_EQ(-1, result);
+
+    semy_arena_free(&arena);
+}
+
+TEST(arena, invalid_versions, .iterations=2)
+{
+    semy_arena_t arena;
+    init(&arena);
+
+    // Nothing is appended for a malformed version.
+    ASSERT_EQ((int)SEMY_BAD_SYNTAX, semy_arena_parse(&arena, "1.0", NULL));
+    ASSERT_EQ((int)SEMY_LIMITS_EXCEEDED, semy_arena_parse(&arena, "2147483648.0.0", NULL));
+    ASSERT_EQ(0, semy_arena_count(&arena));
+
+    semy_arena_free(&arena);
+}
+
+TEST(arena, illegal_arguments)
+{
+    semy_arena_t arena;
+    semy_t semver;
+    int32_t result;
+
+    ASSERT_EQ((int)SEMY_INVALID_OPERATION, semy_arena_init(NULL));
+    ASSERT_EQ((int)SEMY_INVALID_OPERATION, semy_arena_init_interned(NULL));
+    ASSERT_EQ((int)SEMY_INVALID_OPERATION, semy_arena_rank(NULL));
+    ASSERT_EQ(0, semy_arena_identifier_count(NULL));
+    ASSERT_EQ((int)SEMY_NO_ERROR, semy_arena_init(&arena));
+    ASSERT_EQ((int)SEMY_INVALID_OPERATION, semy_arena_parse(NULL, "1.0.0", NULL));
+    ASSERT_EQ((int)SEMY_INVALID_OPERATION, semy_arena_parse(&arena, NULL, NULL));
+    ASSERT_EQ((int)SEMY_NO_ERROR, semy_arena_parse(&arena, "1.0.0", NULL));
+
+    // Ranking an arena that doesn't intern identifiers does nothing.
+    ASSERT_EQ((int)SEMY_NO_ERROR, semy_arena_rank(&arena));
+    ASSERT_EQ(0, semy_arena_identifier_count(&arena));
+    ASSERT_EQ(0, semy_arena_count(NULL));
+
+    ASSERT_EQ((int)SEMY_INVALID_OPERATION, semy_arena_get(NULL, 0, &semver, sizeof(semver)));
+    ASSERT_EQ((int)SEMY_INVALID_OPERATION, semy_arena_get(&arena, 0, NULL, sizeof(semver)));
+    ASSERT_EQ((int)SEMY_INVALID_OPERATION, semy_arena_get(&arena, 1, &semver, sizeof(semver)));
+
+    ASSERT_EQ((int)SEMY_INVALID_OPERATION, semy_arena_compare(NULL, 0, 0, &result));
+    ASSERT_EQ((int)SEMY_INVALID_OPERATION, semy_arena_compare(&arena, 0, 0, NULL));
+    ASSERT_EQ((int)SEMY_INVALID_OPERATION, semy_arena_compare(&arena, 1, 0, &result));
+    ASSERT_EQ((int)SEMY_INVALID_OPERATION, semy_arena_compare(&arena, 0, 1, &result));
+
+    semy_arena_free(NULL);
+    semy_arena_free(&arena);
+}
@@ -13,6 +13,8 @@
 #define UNIT_TESTING
 #include "test_utils.h"
 #include <stdlib.h>
+#include <stdio.h>
+#include <stdint.h>
 
 static const struct CommandLineTestCase test_cases[] = {
     {
@@ -112,9 +114,173 @@ static const struct CommandLineTestCase test_cases[] = {
         "",
         "error: invalid format: 'yaml'\n",
     },
+    {
+        {"semy", "--decompose=ndjson", "1.2.3", "1.2.3-alpha.1+build.20120313144700", "-"},
+        0,
+        "{\"raw\":\"1.2.3\",\"major\":1,\"minor\":2,\"patch\":3,\"preRelease\":[],\"buildMetadata\":[]}\n"
+        "{\"raw\":\"1.2.3-alpha.1+build.20120313144700\",\"major\":1,\"minor\":2,\"patch\":3,\"preRelease\":[\"alpha\",\"1\"],\"buildMetadata\":[\"build\",\"20120313144700\"]}\n"
+        "{\"raw\":\"10.20.30+exp\",\"major\":10,\"minor\":20,\"patch\":30,\"preRelease\":[],\"buildMetadata\":[\"exp\"]}\n",
+        "",
+        "10.20.30+exp\n",
+    },
+    {
+        {"semy", "-dtsv", "1.2.3", "1.2.3-alpha.1+build.20120313144700", "-"},
+        0,
+        "1.2.3\t1\t2\t3\t\t\n"
+        "1.2.3-alpha.1+build.20120313144700\t1\t2\t3\talpha.1\tbuild.20120313144700\n"
+        "2147483647.0.0-rc\t2147483647\t0\t0\trc\t\n",
+        "",
+        "2147483647.0.0-rc\n",
+    },
+    {
+        {"semy", "-dtsv", "1.2.3", "1.2", "2.0.0"},
+        1,
+        "1.2.3\t1\t2\t3\t\t\n",
+        "error: invalid semantic version\n",
+    },
+    {
+        {"semy", "-dndjson"},
+        0,
+        "",
+        "",
+    },
 };
 
 TEST(semy, cli, .iterations=COUNT_OF(test_cases))
 {
     run_cli_test(&test_cases[TEST_ITERATION]);
 }
+
+// Verify output larger than the output buffer is written in full.
+TEST(semy, cli_bulk)
+{
+    const int count = 5000;
+    char *in = calloc((size_t)count, 32);
+    char *out = calloc((size_t)count, 32);
+    ASSERT_NONNULL(in);
+    ASSERT_NONNULL(out);
+
+    size_t in_length = 0;
+    size_t out_length = 0;
+    for (int i = 0; i < count; i++)
+    {
+        in_length += (size_t)sprintf(&in[in_length], "%d.0.%d-rc\n", i, i);
+        out_length += (size_t)sprintf(&out[out_length], "%d.0.%d-rc\t%d\t0\t%d\trc\t\n", i, i, i, i);
+    }
+
+    const struct CommandLineTestCase test_case = {
+        {"semy", "-dtsv", "-"},
+        0,
+        out,
+        "",
+        in,
+    };
+    run_cli_test(&test_case);
+
+    free(in);
+    free(out);
+}
+
+static uint32_t read_u32(const uint8_t *bytes)
+{
+    return (uint32_t)bytes[0] | ((uint32_t)bytes[1] << 8) | ((uint32_t)bytes[2] << 16) | ((uint32_t)bytes[3] << 24);
+}
+
+static uint64_t read_u64(const uint8_t *bytes)
+{
+    return (uint64_t)read_u32(bytes) | ((uint64_t)read_u32(bytes + 4) << 32);
+}
+
+TEST(semy, cli_columnar)
+{
+    const struct CommandLineTestCase test_case = {
+        {"semy", "-dcolumnar", "1.2.3-alpha.1+build.5", "1.2", "-"},
+        0,
+        NULL,
+        NULL,
+        "2147483647.0.9-rc\n",
+    };
+
+    const char *out = NULL;
+    size_t length = 0;
+    ASSERT_EQ(0, run_cli_capture(&test_case, &out, &length));
+
+    const uint8_t *bytes = (const uint8_t *)out;
+    ASSERT_GE(length, 104);
+    ASSERT_MEM_EQ("SEMYCOL1", bytes, 8);
+    ASSERT_EQ(1, read_u32(&bytes[8]));
+    ASSERT_EQ(10, read_u32(&bytes[12]));
+    ASSERT_EQ(3, read_u64(&bytes[16]));
+
+    // Locate each column which begins on an 8-byte boundary.
+    const uint8_t *columns[10];
+    uint64_t lengths[10];
+    size_t offset = 104;
+    for (int i = 0; i < 10; i++)
+    {
+        lengths[i] = read_u64(&bytes[24 + i * 8]);
+        columns[i] = &bytes[offset];
+        offset += (size_t)((lengths[i] + 7) / 8 * 8);
+    }
+    ASSERT_EQ(offset, length);
+
+    // Validity bitmap.
+    ASSERT_EQ(1, lengths[0]);
+    ASSERT_EQ(0x5, columns[0][0]);
+
+    // Major, minor, and patch.
+    ASSERT_EQ(12, lengths[1]);
+    ASSERT_EQ(1, read_u32(&columns[1][0]));
+    ASSERT_EQ(0, read_u32(&columns[1][4]));
+    ASSERT_EQ(2147483647, read_u32(&columns[1][8]));
+    ASSERT_EQ(2, read_u32(&columns[2][0]));
+    ASSERT_EQ(3, read_u32(&columns[3][0]));
+    ASSERT_EQ(9, read_u32(&columns[3][8]));
+
+    // Pre-release identifiers: "alpha", "1" for the first row and "rc" for the last.
+    ASSERT_EQ(16, lengths[4]);
+    ASSERT_EQ(0, read_u32(&columns[4][0]));
+    ASSERT_EQ(2, read_u32(&columns[4][4]));
+    ASSERT_EQ(2, read_u32(&columns[4][8]));
+    ASSERT_EQ(3, read_u32(&columns[4][12]));
+    ASSERT_EQ(16, lengths[5]);
+    ASSERT_EQ(0, read_u32(&columns[5][0]));
+    ASSERT_EQ(5, read_u32(&columns[5][4]));
+    ASSERT_EQ(6, read_u32(&columns[5][8]));
+    ASSERT_EQ(8, read_u32(&columns[5][12]));
+    ASSERT_EQ(8, lengths[6]);
+    ASSERT_MEM_EQ("alpha1rc", columns[6], 8);
+
+    // Build metadata identifiers: "build", "5" for the first row.
+    ASSERT_EQ(16, lengths[7]);
+    ASSERT_EQ(2, read_u32(&columns[7][4]));
+    ASSERT_EQ(2, read_u32(&columns[7][12]));
+    ASSERT_EQ(12, lengths[8]);
+    ASSERT_EQ(6, read_u32(&columns[8][8]));
+    ASSERT_EQ(6, lengths[9]);
+    ASSERT_MEM_EQ("build5", columns[9], 6);
+}
+
+// The output is binary so only the header up to its first null byte is compared
+// here. This test exists to verify allocation failures are handled.
+TEST(semy, cli_columnar_allocations)
+{
+    char *in = calloc(2000, 32);
+    ASSERT_NONNULL(in);
+
+    size_t length = 0;
+    for (int i = 0; i < 2000; i++)
+    {
+        length += (size_t)sprintf(&in[length], "%d.0.0-rc.%d+b\n", i, i);
+    }
+
+    const struct CommandLineTestCase test_case = {
+        {"semy", "-dcolumnar", "-"},
+        0,
+        "SEMYCOL1\x01",
+        "",
+        in,
+    };
+    run_cli_test(&test_case);
+    free(in);
+}
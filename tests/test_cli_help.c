@@ -18,9 +18,20 @@ static const char *const help_message =
     "Usage:\n"
     "\n"
     "  semver --compare <version1> <version2>\n"
-    "  semver --decompose=<format> <version>\n"
+    "  semver --decompose=<format> [-j <threads>] <version>...\n"
     "  semver --sort <version>...\n"
-    "  semver --validate <version>...\n"
+    "  semver --validate [-j <threads>] <version>...\n"
+    "  semver --report [-m] [-j <threads>] <version>...\n"
+    "  semver --build-index <file> <version>...\n"
+    "  semver --query-index <file> <version> [<version>]\n"
+    "  semver --serve [<socket>]\n"
+    "  semver --stats <command>\n"
+    "\n"
+    "With --decompose, --sort, --validate, --report, and --build-index, a <version>\n"
+    "of '-' reads versions from stdin and '-f <file>' reads them from a file, one\n"
+    "per line. Leading '-k <field>' and '-t <char>' options select the version\n"
+    "from a field of each line, delimited by 'char' (default: tab), and --sort and\n"
+    "--report print the whole line.\n"
     "\n"
     "Options:\n"
     "\n"
@@ -29,20 +40,58 @@ static const char *const help_message =
     "       Compare semantic versions 'v1' and 'v2' and print -1, 0, 1 depending\n"
     "       on if v1 < v2, v1 = v2, v1 > v2 (respectively).\n"
     "\n"
-    "  -d<format> <version>\n"
-    "  -decompose=<format> <version>\n"
-    "       Decompose a semantic version into its identifiers.\n"
+    "  -d<format> [-j <threads>] <version>...\n"
+    "  -decompose=<format> [-j <threads>] <version>...\n"
+    "       Decompose semantic versions into their identifiers. The 'json' and\n"
+    "       'xml' formats accept exactly one version. The 'ndjson' and 'tsv'\n"
+    "       formats accept any number of versions and print one per line.\n"
+    "       The 'columnar' format writes binary column arrays (see semy(1)).\n"
+    "       With -j, the 'ndjson' and 'tsv' formats read the input on one thread,\n"
+    "       parse it on 'threads' threads, and print it on another.\n"
     "\n"
     "  -s <versions>...\n"
     "  --sort <versions>...\n"
     "       Sort semantic versions and print them in ascending order on their\n"
     "       own line to stdout.\n"
     "\n"
-    "  -v <versions>...\n"
-    "  --validate <versions>...\n"
+    "  -v [-j <threads>] <versions>...\n"
+    "  --validate [-j <threads>] <versions>...\n"
     "       Validate one or more semantic versions. If any semantic version is\n"
+    "       invalid, the exit status will be 1. With -j, the input is read on\n"
+    "       one thread and validated on 'threads' threads.\n"
+    "\n"
+    "  -r [-m] [-j <threads>] <versions>...\n"
+    "  --report [-m] [-j <threads>] <versions>...\n"
+    "       Validate every semantic version using 'threads' threads (default: one\n"
+    "       per processor) and print the source, line number, byte offset, status\n"
+    "       ('ok', 'bad-syntax', or 'limits-exceeded'), error position in the line,\n"
+    "       and text of each version, tab separated, in input order. With -m only\n"
+    "       the malformed versions are printed. If any semantic version is\n"
     "       invalid, the exit status will be 1.\n"
     "\n"
+    "  --build-index <file> <versions>...\n"
+    "       Write an index of the semantic versions, sorted by precedence, to\n"
+    "       'file'. The index is memory mapped by --query-index without parsing.\n"
+    "\n"
+    "  --query-index <file> <version1> [<version2>]\n"
+    "       Print the indexed versions equal in precedence to 'version1', or\n"
+    "       those from 'version1' to 'version2' inclusive, in ascending order.\n"
+    "\n"
+    "  --serve [<socket>]\n"
+    "       Answer requests, one per line, read from stdin or from clients of the\n"
+    "       Unix domain socket 'socket'. The requests are 'compare <v1> <v2>',\n"
+    "       'validate <version>...', 'satisfies <version> <comparator>...',\n"
+    "       'sort <version>...', and 'quit'. Each is answered on a single line\n"
+    "       with the exit status then the output or error of the equivalent\n"
+    "       command (see semy(1)). Each client of the socket is served on its\n"
+    "       own thread.\n"
+    "\n"
+    "  --stats <command>\n"
+    "       Run the command, e.g. '--sort -f <file>', then print the versions\n"
+    "       parsed, bytes read, seconds spent reading the input, parsing (summed\n"
+    "       over threads), sorting, and writing the output, peak memory, and\n"
+    "       versions parsed per second to stderr.\n"
+    "\n"
     "Exit status:\n"
     "  0  if OK,\n"
     "  1  if one or more semantic versions are malformed,\n"
@@ -0,0 +1,247 @@
+// SPDX-License-Identifier: MIT
+/*
+ * Semy - a Semantic Versioning 2.0.0 processor.
+ * See https://semver.org/.
+ *
+ * Copyright (c) 2025-2026 Henry G. Stratmann III
+ * Copyright (c) 2025-2026 Semy Contributors
+ *
+ * This file is part of Semy, distributed under the MIT License.
+ * For full terms see the included LICENSE file.
+ */
+
+#define UNIT_TESTING
+#include "semy.h"
+#include "test_utils.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+static const struct CommandLineTestCase test_cases[] = {
+    {
+        {"semy", "--build-index"},
+        2,
+        "",
+        "error: expected an index file name\n",
+    },
+    {
+        {"semy", "--build-index", "test_cli_index.idx", "1.0.0", "1.0"},
+        1,
+        "",
+        "error: invalid semantic version\n",
+    },
+    {
+        {"semy", "--build-index", "does-not-exist/test_cli_index.idx", "1.0.0"},
+        3,
+        "",
+        "error: cannot write file 'does-not-exist/test_cli_index.idx'\n",
+    },
+    {
+        {"semy", "--query-index", "test_cli_index.idx"},
+        2,
+        "",
+        "error: expected an index file name followed by one or two versions\n",
+    },
+    {
+        {"semy", "--query-index", "test_cli_index.idx", "1.0.0", "2.0.0", "3.0.0"},
+        2,
+        "",
+        "error: expected an index file name followed by one or two versions\n",
+    },
+    {
+        {"semy", "--query-index", "does-not-exist.idx", "1.0.0"},
+        3,
+        "",
+        "error: cannot open file 'does-not-exist.idx'\n",
+    },
+};
+
+TEST(semy, cli, .iterations=COUNT_OF(test_cases))
+{
+    run_cli_test(&test_cases[TEST_ITERATION]);
+}
+
+// Only one command-line test may run per test so the index is built by the library.
+static void build_index(void)
+{
+    const char *versions[] = {"2.0.0", "1.0.0-rc.1", "1.0.0+a", "1.0.0-beta.11", "1.0.0-beta.2", "1.0.0+b"};
+    uint64_t buffer[64] = {0};
+    size_t size = sizeof(buffer);
+    ASSERT_EQ((int)SEMY_NO_ERROR, semy_index_build(versions, NULL, COUNT_OF(versions), buffer, &size));
+    write_binary_file("test_cli_index.idx", buffer, size);
+}
+
+TEST(semy, cli_build_index)
+{
+    const struct CommandLineTestCase test_case = {
+        {"semy", "--build-index", "test_cli_index.idx", "2.0.0", "-", "1.0.0+b"},
+        0,
+        "",
+        "",
+        "1.0.0-rc.1\n1.0.0+a\n\n1.0.0-beta.11\r\n1.0.0-beta.2\n",
+    };
+    run_cli_test(&test_case);
+
+    // Verify the index matches one built by the library.
+    FILE *file = fopen("test_cli_index.idx", "rb");
+    ASSERT_NONNULL(file);
+    uint8_t actual[512] = {0};
+    const size_t length = fread(actual, 1, sizeof(actual), file);
+    fclose(file);
+
+    build_index();
+    file = fopen("test_cli_index.idx", "rb");
+    ASSERT_NONNULL(file);
+    uint8_t expected[512] = {0};
+    ASSERT_EQ(length, fread(expected, 1, sizeof(expected), file));
+    fclose(file);
+
+    ASSERT_MEM_EQ(expected, actual, length);
+    remove("test_cli_index.idx");
+}
+
+TEST(semy, cli_query_equal)
+{
+    build_index();
+
+    const struct CommandLineTestCase test_case = {
+        {"semy", "--query-index", "test_cli_index.idx", "1.0.0"},
+        0,
+        "1.0.0+a\n"
+        "1.0.0+b\n",
+        "",
+    };
+    run_cli_test(&test_case);
+    remove("test_cli_index.idx");
+}
+
+TEST(semy, cli_query_range)
+{
+    build_index();
+
+    const struct CommandLineTestCase test_case = {
+        {"semy", "--query-index", "test_cli_index.idx", "1.0.0-beta", "1.0.0-rc.1"},
+        0,
+        "1.0.0-beta.2\n"
+        "1.0.0-beta.11\n"
+        "1.0.0-rc.1\n",
+        "",
+    };
+    run_cli_test(&test_case);
+    remove("test_cli_index.idx");
+}
+
+TEST(semy, cli_query_missing)
+{
+    build_index();
+
+    const struct CommandLineTestCase test_case = {
+        {"semy", "--query-index", "test_cli_index.idx", "3.0.0"},
+        0,
+        "",
+        "",
+    };
+    run_cli_test(&test_case);
+    remove("test_cli_index.idx");
+}
+
+TEST(semy, cli_query_invalid_version)
+{
+    build_index();
+
+    const struct CommandLineTestCase test_case = {
+        {"semy", "--query-index", "test_cli_index.idx", "1.0.0", "2.0"},
+        1,
+        "",
+        "error: invalid semantic version\n",
+    };
+    run_cli_test(&test_case);
+    remove("test_cli_index.idx");
+}
+
+TEST(semy, cli_query_not_an_index)
+{
+    write_file("test_cli_index.idx", "1.0.0\n");
+
+    const struct CommandLineTestCase test_case = {
+        {"semy", "--query-index", "test_cli_index.idx", "1.0.0"},
+        3,
+        "",
+        "error: invalid index file 'test_cli_index.idx'\n",
+    };
+    run_cli_test(&test_case);
+    remove("test_cli_index.idx");
+}
+
+TEST(semy, cli_query_empty_file)
+{
+    write_file("test_cli_index.idx", "");
+
+    const struct CommandLineTestCase test_case = {
+        {"semy", "--query-index", "test_cli_index.idx", "1.0.0"},
+        3,
+        "",
+        "error: invalid index file 'test_cli_index.idx'\n",
+    };
+    run_cli_test(&test_case);
+    remove("test_cli_index.idx");
+}
+
+// Writes an index of two versions with the offset at 'corrupt' of its entry table changed.
+static void write_corrupt_index(size_t corrupt, uint8_t value)
+{
+    const char *versions[] = {"1.0.0", "2.0.0"};
+    uint64_t buffer[16] = {0};
+    size_t size = sizeof(buffer);
+    ASSERT_EQ((int)SEMY_NO_ERROR, semy_index_build(versions, NULL, 2, buffer, &size));
+    ((uint8_t *)buffer)[32 + corrupt] = value;
+    write_binary_file("test_cli_index.idx", buffer, size);
+}
+
+TEST(semy, cli_query_corrupt_key)
+{
+    write_corrupt_index(0, 0xFF);
+
+    const struct CommandLineTestCase test_case = {
+        {"semy", "--query-index", "test_cli_index.idx", "1.0.0"},
+        3,
+        "",
+        "error: invalid index file\n",
+    };
+    run_cli_test(&test_case);
+    remove("test_cli_index.idx");
+}
+
+TEST(semy, cli_query_corrupt_string)
+{
+    write_corrupt_index(8, 0xFF);
+
+    const struct CommandLineTestCase test_case = {
+        {"semy", "--query-index", "test_cli_index.idx", "1.0.0"},
+        3,
+        "",
+        "error: invalid index file\n",
+    };
+    run_cli_test(&test_case);
+    remove("test_cli_index.idx");
+}
+
+TEST(semy, cli_build_index_many)
+{
+    char in[4096] = {0};
+    size_t length = 0;
+    for (int i = 0; i < 200; i++)
+    {
+        length += (size_t)sprintf(&in[length], "1.0.%d\n", 199 - i);
+    }
+
+    const struct CommandLineTestCase test_case = {
+        {"semy", "--build-index", "test_cli_index.idx", "-"},
+        0,
+        "",
+        "",
+        in,
+    };
+    run_cli_test(&test_case);
+    remove("test_cli_index.idx");
+}
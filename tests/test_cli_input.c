@@ -0,0 +1,286 @@
+// SPDX-License-Identifier: MIT
+/*
+ * Semy - a Semantic Versioning 2.0.0 processor.
+ * See https://semver.org/.
+ *
+ * Copyright (c) 2025-2026 Henry G. Stratmann III
+ * Copyright (c) 2025-2026 Semy Contributors
+ *
+ * This file is part of Semy, distributed under the MIT License.
+ * For full terms see the included LICENSE file.
+ */
+
+#define UNIT_TESTING
+#include "test_utils.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+
+static const struct CommandLineTestCase test_cases[] = {
+    {
+        {"semy", "--validate", "-"},
+        0,
+        "",
+        "",
+        "1.0.0\n2.0.0-rc.1\n",
+    },
+    {
+        {"semy", "-v", "1.0.0", "-"},
+        1,
+        "",
+        "error: invalid semantic version\n",
+        "1.0.0\n1.0\n2.0.0\n",
+    },
+    {
+        {"semy", "-v", "-"},
+        0,
+        "",
+        "",
+        "",
+    },
+    {
+        {"semy", "-s", "3.0.0", "-"},
+        0,
+        "1.0.0\n"
+        "2.0.0\n"
+        "3.0.0\n",
+        "",
+        "2.0.0\r\n\n1.0.0",
+    },
+    {
+        {"semy", "-s", "-", "-"},
+        0,
+        "1.0.0-alpha\n"
+        "1.0.0\n",
+        "",
+        "1.0.0\n1.0.0-alpha\n",
+    },
+    {
+        {"semy", "-s", "-"},
+        1,
+        "",
+        "error: invalid semantic version\n",
+        "1.0.0\n1.0.0.0\n",
+    },
+    {
+        {"semy", "-djson", "-"},
+        0,
+        "{\n"
+        "    \"raw\": \"1.2.3\",\n"
+        "    \"major\": 1,\n"
+        "    \"minor\": 2,\n"
+        "    \"patch\": 3,\n"
+        "    \"preRelease\": [],\n"
+        "    \"buildMetadata\": []\n"
+        "}\n",
+        "",
+        "1.2.3\n",
+    },
+    {
+        {"semy", "-djson", "-"},
+        2,
+        "",
+        "error: expected exactly one version string\n",
+        "1.2.3\n4.5.6\n",
+    },
+    {
+        {"semy", "-djson", "-"},
+        1,
+        "",
+        "error: invalid semantic version\n",
+        "1.2\n",
+    },
+    {
+        {"semy", "-v", "-f"},
+        2,
+        "",
+        "error: expected a file name after '-f'\n",
+    },
+    {
+        {"semy", "-s", "-f", "does-not-exist.txt"},
+        3,
+        "",
+        "error: cannot open file 'does-not-exist.txt'\n",
+    },
+    {
+        {"semy", "-djson", "-f", "does-not-exist.txt"},
+        3,
+        "",
+        "error: cannot open file 'does-not-exist.txt'\n",
+    },
+};
+
+TEST(semy, cli, .iterations=COUNT_OF(test_cases))
+{
+    run_cli_test(&test_cases[TEST_ITERATION]);
+}
+
+TEST(semy, cli_sort_file)
+{
+    write_file("test_cli_input.txt", "2.0.0\n1.0.0-beta\n\n1.0.0-alpha.1\r\n1.0.0");
+
+    const struct CommandLineTestCase test_case = {
+        {"semy", "-s", "-f", "test_cli_input.txt", "0.1.0"},
+        0,
+        "0.1.0\n"
+        "1.0.0-alpha.1\n"
+        "1.0.0-beta\n"
+        "1.0.0\n"
+        "2.0.0\n",
+        "",
+    };
+    run_cli_test(&test_case);
+    remove("test_cli_input.txt");
+}
+
+TEST(semy, cli_validate_file)
+{
+    write_file("test_cli_input.txt", "1.0.0\n2.0.0\n1.0.0-\n");
+
+    const struct CommandLineTestCase test_case = {
+        {"semy", "-v", "-f", "test_cli_input.txt", "-f", "test_cli_input.txt"},
+        1,
+        "",
+        "error: invalid semantic version\n",
+    };
+    run_cli_test(&test_case);
+    remove("test_cli_input.txt");
+}
+
+TEST(semy, cli_validate_files)
+{
+    write_file("test_cli_input.txt", "1.0.0\n2.0.0\n");
+
+    const struct CommandLineTestCase test_case = {
+        {"semy", "-v", "-f", "test_cli_input.txt", "-f", "test_cli_input.txt"},
+        0,
+        "",
+        "",
+    };
+    run_cli_test(&test_case);
+    remove("test_cli_input.txt");
+}
+
+TEST(semy, cli_validate_empty_file)
+{
+    write_file("test_cli_input.txt", "");
+
+    const struct CommandLineTestCase test_case = {
+        {"semy", "-v", "-f", "test_cli_input.txt"},
+        0,
+        "",
+        "",
+    };
+    run_cli_test(&test_case);
+    remove("test_cli_input.txt");
+}
+
+TEST(semy, cli_validate_embedded_null)
+{
+    write_binary_file("test_cli_input.txt", "1.0.0\0abc\n", 10);
+
+    const struct CommandLineTestCase test_case = {
+        {"semy", "-v", "-f", "test_cli_input.txt"},
+        1,
+        "",
+        "error: invalid semantic version\n",
+    };
+    run_cli_test(&test_case);
+    remove("test_cli_input.txt");
+}
+
+TEST(semy, cli_decompose_file)
+{
+    write_file("test_cli_input.txt", "1.2.3-beta\n");
+
+    const struct CommandLineTestCase test_case = {
+        {"semy", "-dxml", "-f", "test_cli_input.txt"},
+        0,
+        "<?xml version=\"1.0\" encoding=\"utf-8\"?>\n"
+        "<semver>\n"
+        "    <raw>1.2.3-beta</raw>\n"
+        "    <major>1</major>\n"
+        "    <minor>2</minor>\n"
+        "    <patch>3</patch>\n"
+        "    <preRelease>\n"
+        "        <identifier>beta</identifier>\n"
+        "    </preRelease>\n"
+        "    <buildMetadata></buildMetadata>\n"
+        "</semver>\n",
+        "",
+    };
+    run_cli_test(&test_case);
+    remove("test_cli_input.txt");
+}
+
+static char *generate_versions(int count, bool descending)
+{
+    char *versions = calloc((size_t)count, 16);
+    ASSERT_NONNULL(versions);
+
+    size_t length = 0;
+    for (int i = 0; i < count; i++)
+    {
+        const int patch = descending ? count - i - 1 : i;
+        length += (size_t)sprintf(&versions[length], "1.0.%d\n", patch);
+    }
+    return versions;
+}
+
+// Verify lines are split correctly across read blocks when they must be retained.
+TEST(semy, cli_sort_many_blocks)
+{
+    char *in = generate_versions(20000, true);
+    char *out = generate_versions(20000, false);
+
+    const struct CommandLineTestCase test_case = {
+        {"semy", "-s", "-"},
+        0,
+        out,
+        "",
+        in,
+    };
+    run_cli_test(&test_case);
+
+    free(in);
+    free(out);
+}
+
+// Verify lines are split correctly across read blocks when they are streamed.
+TEST(semy, cli_validate_many_blocks)
+{
+    char *in = generate_versions(20000, true);
+
+    const struct CommandLineTestCase test_case = {
+        {"semy", "-v", "-"},
+        0,
+        "",
+        "",
+        in,
+    };
+    run_cli_test(&test_case);
+
+    free(in);
+}
+
+// Verify a line larger than a read block is handled.
+TEST(semy, cli_line_exceeds_block)
+{
+    const size_t length = 100 * 1024;
+    char *in = calloc(length + 16, 1);
+    ASSERT_NONNULL(in);
+    strcpy(in, "1.0.0\n1.0.0-");
+    memset(&in[strlen(in)], 'a', length);
+
+    const struct CommandLineTestCase test_case = {
+        {"semy", "-v", "-"},
+        3,
+        "",
+        "error: semantic version is too complex for this implementation\n",
+        in,
+    };
+    run_cli_test(&test_case);
+
+    free(in);
+}
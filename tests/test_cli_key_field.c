@@ -0,0 +1,176 @@
+// SPDX-License-Identifier: MIT
+/*
+ * Semy - a Semantic Versioning 2.0.0 processor.
+ * See https://semver.org/.
+ *
+ * Copyright (c) 2025-2026 Henry G. Stratmann III
+ * Copyright (c) 2025-2026 Semy Contributors
+ *
+ * This file is part of Semy, distributed under the MIT License.
+ * For full terms see the included LICENSE file.
+ */
+
+#define UNIT_TESTING
+#include "test_utils.h"
+#include <stdio.h>
+#include <stdlib.h>
+
+static const struct CommandLineTestCase test_cases[] = {
+    {
+        {"semy", "-s", "-k", "2", "-"},
+        0,
+        "b\t1.0.0-alpha.1\t2024\n"
+        "c\t1.0.0-alpha.beta\t2025\n"
+        "a\t1.0.0\t2023\n"
+        "d\t2.0.0\n",
+        "",
+        "a\t1.0.0\t2023\n"
+        "d\t2.0.0\n"
+        "c\t1.0.0-alpha.beta\t2025\n"
+        "b\t1.0.0-alpha.1\t2024\n",
+    },
+    {
+        {"semy", "-s", "-t", ",", "-k", "3", "-"},
+        0,
+        "x,y,0.1.0\n"
+        "x,y,0.2.0,z\n",
+        "",
+        "x,y,0.2.0,z\nx,y,0.1.0\r\n",
+    },
+    {
+        {"semy", "-s", "-k", "3", "-"},
+        1,
+        "",
+        "error: invalid semantic version\n",
+        "a\t1.0.0\t2.0.0\nb\t1.0.0\n",
+    },
+    {
+        {"semy", "-v", "-k", "2", "-t", ";", "pkg;1.0.0;x", "-"},
+        0,
+        "",
+        "",
+        "pkg;2.0.0-rc.1\n",
+    },
+    {
+        {"semy", "-v", "-k", "1", "-"},
+        1,
+        "",
+        "error: invalid semantic version\n",
+        "1.0.0\t2.0.0\n1.0\t2.0.0\n",
+    },
+    {
+        {"semy", "-r", "-k", "2", "-t", ",", "-j", "2", "-"},
+        1,
+        "-\t1\t0\tbad-syntax\t5\ta,1.0,b\n"
+        "-\t2\t8\tok\t7\tc,1.0.0\n"
+        "-\t3\t16\tbad-syntax\t1\td\n",
+        "",
+        "a,1.0,b\nc,1.0.0\nd\n",
+    },
+    {
+        {"semy", "-dtsv", "-k", "2", "-"},
+        0,
+        "1.2.3-rc.1\t1\t2\t3\trc.1\t\n",
+        "",
+        "pkg\t1.2.3-rc.1\t2025-01-01\n",
+    },
+    {
+        {"semy", "-djson", "-k", "2", "-"},
+        0,
+        "{\n"
+        "    \"raw\": \"1.2.3\",\n"
+        "    \"major\": 1,\n"
+        "    \"minor\": 2,\n"
+        "    \"patch\": 3,\n"
+        "    \"preRelease\": [],\n"
+        "    \"buildMetadata\": []\n"
+        "}\n",
+        "",
+        "pkg\t1.2.3\n",
+    },
+    {
+        {"semy", "-s", "-k"},
+        2,
+        "",
+        "error: expected a field number after '-k'\n",
+    },
+    {
+        {"semy", "-v", "-k", "0", "1.0.0"},
+        2,
+        "",
+        "error: expected a field number after '-k'\n",
+    },
+    {
+        {"semy", "-dtsv", "-k", "two", "1.0.0"},
+        2,
+        "",
+        "error: expected a field number after '-k'\n",
+    },
+    {
+        {"semy", "-r", "-t"},
+        2,
+        "",
+        "error: expected a single character delimiter after '-t'\n",
+    },
+    {
+        {"semy", "--build-index", "-t", "ab", "test.idx"},
+        2,
+        "",
+        "error: expected a single character delimiter after '-t'\n",
+    },
+    {
+        {"semy", "-s", "-t", "\n", "1.0.0"},
+        2,
+        "",
+        "error: expected a single character delimiter after '-t'\n",
+    },
+};
+
+TEST(semy, cli, .iterations=COUNT_OF(test_cases))
+{
+    run_cli_test(&test_cases[TEST_ITERATION]);
+}
+
+TEST(semy, cli_key_field_index)
+{
+    const struct CommandLineTestCase test_case = {
+        {"semy", "--build-index", "-k", "2", "test_cli_key_field.idx", "-"},
+        0,
+        "",
+        "",
+        "a\t2.0.0\nb\t1.0.0\n",
+    };
+    run_cli_test(&test_case);
+    remove("test_cli_key_field.idx");
+}
+
+TEST(semy, cli_key_field_columnar)
+{
+    const struct CommandLineTestCase test_case = {
+        {"semy", "-dcolumnar", "-k", "2", "-"},
+        0,
+        NULL,
+        NULL,
+        "a\t2.0.0\nb\t1.0\n",
+    };
+
+    const char *out = NULL;
+    size_t length = 0;
+    ASSERT_EQ(0, run_cli_capture(&test_case, &out, &length));
+    ASSERT_GE(length, 104);
+
+    // The first version is valid and the second is null.
+    ASSERT_EQ(2, out[16]);
+    ASSERT_EQ(1, out[104]);
+}
+
+TEST(semy, cli_key_field_columnar_option)
+{
+    const struct CommandLineTestCase test_case = {
+        {"semy", "-dcolumnar", "-k", "x"},
+        2,
+        "",
+        "error: expected a field number after '-k'\n",
+    };
+    run_cli_test(&test_case);
+}
@@ -21,9 +21,20 @@ static const struct CommandLineTestCase test_cases[] = {
         "Usage:\n"
         "\n"
         "  semver --compare <version1> <version2>\n"
-        "  semver --decompose=<format> <version>\n"
+        "  semver --decompose=<format> [-j <threads>] <version>...\n"
         "  semver --sort <version>...\n"
-        "  semver --validate <version>...\n"
+        "  semver --validate [-j <threads>] <version>...\n"
+        "  semver --report [-m] [-j <threads>] <version>...\n"
+        "  semver --build-index <file> <version>...\n"
+        "  semver --query-index <file> <version> [<version>]\n"
+        "  semver --serve [<socket>]\n"
+        "  semver --stats <command>\n"
+        "\n"
+        "With --decompose, --sort, --validate, --report, and --build-index, a <version>\n"
+        "of '-' reads versions from stdin and '-f <file>' reads them from a file, one\n"
+        "per line. Leading '-k <field>' and '-t <char>' options select the version\n"
+        "from a field of each line, delimited by 'char' (default: tab), and --sort and\n"
+        "--report print the whole line.\n"
         "\n"
         "Run 'semver --help' for more information.\n",
         "",
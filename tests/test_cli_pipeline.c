@@ -0,0 +1,274 @@
+// SPDX-License-Identifier: MIT
+/*
+ * Semy - a Semantic Versioning 2.0.0 processor.
+ * See https://semver.org/.
+ *
+ * Copyright (c) 2025-2026 Henry G. Stratmann III
+ * Copyright (c) 2025-2026 Semy Contributors
+ *
+ * This file is part of Semy, distributed under the MIT License.
+ * For full terms see the included LICENSE file.
+ */
+
+#define _POSIX_C_SOURCE 200809L
+#define UNIT_TESTING
+#include "test_utils.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <pthread.h>
+#include <sys/stat.h>
+
+static const struct CommandLineTestCase test_cases[] = {
+    {
+        {"semy", "-v", "-j", "2", "1.0.0", "2.0.0-rc.1"},
+        0,
+        "",
+        "",
+    },
+    {
+        {"semy", "-v", "-j", "1", "1.0.0", "-", "1.0"},
+        1,
+        "",
+        "error: invalid semantic version\n",
+        "2.0.0\n1.0\n",
+    },
+    {
+        {"semy", "-v", "-j", "2", ""},
+        1,
+        "",
+        "error: invalid semantic version\n",
+    },
+    {
+        {"semy", "-v", "-j", "2", "-"},
+        3,
+        "",
+        "error: semantic version is too complex for this implementation\n",
+        "2147483648.0.0\n",
+    },
+    {
+        {"semy", "-dndjson", "-j", "2", "1.2.3-beta", "2.0.0+exp.sha.5114f85"},
+        0,
+        "{\"raw\":\"1.2.3-beta\",\"major\":1,\"minor\":2,\"patch\":3,\"preRelease\":[\"beta\"],\"buildMetadata\":[]}\n"
+        "{\"raw\":\"2.0.0+exp.sha.5114f85\",\"major\":2,\"minor\":0,\"patch\":0,\"preRelease\":[],\"buildMetadata\":[\"exp\",\"sha\",\"5114f85\"]}\n",
+        "",
+    },
+    {
+        {"semy", "-dtsv", "-j", "3", "1.0.0", "-", "4.0.0"},
+        0,
+        "1.0.0\t1\t0\t0\t\t\n"
+        "2.0.0\t2\t0\t0\t\t\n"
+        "3.0.0-rc.1\t3\t0\t0\trc.1\t\n"
+        "4.0.0\t4\t0\t0\t\t\n",
+        "",
+        "2.0.0\n\n3.0.0-rc.1\r\n",
+    },
+    {
+        {"semy", "-dtsv", "-j", "2", "-", "3.0.0"},
+        1,
+        "1.0.0\t1\t0\t0\t\t\n",
+        "error: invalid semantic version\n",
+        "1.0.0\n2.0\n",
+    },
+    {
+        {"semy", "-dtsv", "-k", "2", "-j", "2", "-"},
+        0,
+        "1.0.0\t1\t0\t0\t\t\n"
+        "2.0.0\t2\t0\t0\t\t\n",
+        "",
+        "left-pad\t1.0.0\nright-pad\t2.0.0",
+    },
+    {
+        {"semy", "-v", "-j", "2", "-f"},
+        2,
+        "",
+        "error: expected a file name after '-f'\n",
+    },
+    {
+        {"semy", "-dtsv", "-j", "2", "1.0.0", "-f", "does-not-exist.txt"},
+        3,
+        "1.0.0\t1\t0\t0\t\t\n",
+        "error: cannot open file 'does-not-exist.txt'\n",
+    },
+    {
+        {"semy", "-djson", "-j", "2", "1.0.0"},
+        2,
+        "",
+        "error: the '-j' option requires the 'ndjson' or 'tsv' format\n",
+    },
+    {
+        {"semy", "-v", "-j", "0", "1.0.0"},
+        2,
+        "",
+        "error: expected a thread count between 1 and 256 after '-j'\n",
+    },
+    {
+        {"semy", "-dtsv", "-j"},
+        2,
+        "",
+        "error: expected a thread count between 1 and 256 after '-j'\n",
+    },
+    {
+        {"semy", "--stats", "-v", "-j", "2", "-"},
+        0,
+        "",
+        "items: 2\n"
+        "bytes read: 12\n"
+        "read time: 0.000000 s\n"
+        "parse time: 0.000000 s\n"
+        "sort time: 0.000000 s\n"
+        "output time: 0.000000 s\n"
+        "total time: 0.000000 s\n"
+        "peak memory: 1024 KiB\n"
+        "items per second: 0\n",
+        "1.0.0\n2.0.0\n",
+    },
+};
+
+TEST(semy, cli, .iterations=COUNT_OF(test_cases))
+{
+    run_cli_test(&test_cases[TEST_ITERATION]);
+}
+
+// Generates enough versions to fill many batches along with their decomposition. If 'malformed'
+// is non-negative, the version on that line is malformed and the decomposition stops there.
+static void generate_versions(int malformed, char **in, char **out)
+{
+    const int count = 200000;
+    size_t in_length = 0;
+    size_t out_length = 0;
+
+    *in = calloc((size_t)count, 16);
+    *out = calloc((size_t)count, 32);
+    ASSERT_NONNULL(*in);
+    ASSERT_NONNULL(*out);
+
+    for (int i = 0; i < count; i++)
+    {
+        if (i == malformed)
+        {
+            in_length += (size_t)sprintf(&(*in)[in_length], "%d.0\n", i);
+            break;
+        }
+        in_length += (size_t)sprintf(&(*in)[in_length], "%d.0.0\n", i);
+        out_length += (size_t)sprintf(&(*out)[out_length], "%d.0.0\t%d\t0\t0\t\t\n", i, i);
+    }
+}
+
+TEST(semy, cli_pipeline_batches)
+{
+    char *in = NULL;
+    char *out = NULL;
+    generate_versions(-1, &in, &out);
+
+    const struct CommandLineTestCase test_case = {
+        {"semy", "-dtsv", "-j", "4", "-"},
+        0,
+        out,
+        "",
+        in,
+    };
+    run_cli_test(&test_case);
+
+    free(in);
+    free(out);
+}
+
+// Verify the output stops at the first malformed version even though later batches are read.
+TEST(semy, cli_pipeline_stops)
+{
+    char *in = NULL;
+    char *out = NULL;
+    generate_versions(30000, &in, &out);
+
+    const struct CommandLineTestCase test_case = {
+        {"semy", "-dtsv", "-j", "2", "-", "-"},
+        1,
+        out,
+        "error: invalid semantic version\n",
+        in,
+    };
+    run_cli_test(&test_case);
+
+    free(in);
+    free(out);
+}
+
+// Verify the last line of a file lacking a trailing newline isn't joined with what follows.
+TEST(semy, cli_pipeline_files)
+{
+    write_file("test_cli_pipeline.txt", "1.0.0\n2.0.0");
+
+    const struct CommandLineTestCase test_case = {
+        {"semy", "-dtsv", "-j", "2", "-f", "test_cli_pipeline.txt", "-f", "test_cli_pipeline.txt"},
+        0,
+        "1.0.0\t1\t0\t0\t\t\n"
+        "2.0.0\t2\t0\t0\t\t\n"
+        "1.0.0\t1\t0\t0\t\t\n"
+        "2.0.0\t2\t0\t0\t\t\n",
+        "",
+    };
+    run_cli_test(&test_case);
+    remove("test_cli_pipeline.txt");
+}
+
+// Verify a line larger than a batch is handled.
+TEST(semy, cli_pipeline_line_exceeds_batch)
+{
+    const size_t length = 1024 * 1024;
+    char *in = calloc(length + 16, 1);
+    ASSERT_NONNULL(in);
+    strcpy(in, "1.0.0\n1.0.0-");
+    memset(&in[strlen(in)], 'a', length);
+
+    const struct CommandLineTestCase test_case = {
+        {"semy", "-v", "-j", "2", "-"},
+        3,
+        "",
+        "error: semantic version is too complex for this implementation\n",
+        in,
+    };
+    run_cli_test(&test_case);
+
+    free(in);
+}
+
+// Writes to the FIFO after a delay long enough for the waiting threads to sleep.
+static void *write_fifo(void *path)
+{
+    FILE *file = fopen(path, "wb");
+    if (file != NULL)
+    {
+        const struct timespec delay = {0, 100 * 1000 * 1000};
+        nanosleep(&delay, NULL);
+        fputs("1.0.0\n2.0.0\n", file);
+        fclose(file);
+    }
+    return NULL;
+}
+
+// Verify threads waiting on slow input sleep and are woken once it arrives.
+TEST(semy, cli_pipeline_slow_input)
+{
+    remove("test_cli_pipeline.fifo");
+    ASSERT_EQ(0, mkfifo("test_cli_pipeline.fifo", 0600));
+
+    pthread_t writer;
+    ASSERT_EQ(0, pthread_create(&writer, NULL, write_fifo, "test_cli_pipeline.fifo"));
+
+    const char *out = NULL;
+    size_t length = 0;
+    const struct CommandLineTestCase test_case = {
+        {"semy", "-dtsv", "-j", "2", "-f", "test_cli_pipeline.fifo"},
+        0,
+        "",
+        "",
+    };
+    ASSERT_EQ(0, run_cli_capture(&test_case, &out, &length));
+    ASSERT_EQ(0, pthread_join(writer, NULL));
+    remove("test_cli_pipeline.fifo");
+
+    ASSERT_STR_EQ("1.0.0\t1\t0\t0\t\t\n"
+                  "2.0.0\t2\t0\t0\t\t\n", out);
+}
@@ -0,0 +1,261 @@
+// SPDX-License-Identifier: MIT
+/*
+ * Semy - a Semantic Versioning 2.0.0 processor.
+ * See https://semver.org/.
+ *
+ * Copyright (c) 2025-2026 Henry G. Stratmann III
+ * Copyright (c) 2025-2026 Semy Contributors
+ *
+ * This file is part of Semy, distributed under the MIT License.
+ * For full terms see the included LICENSE file.
+ */
+
+#define UNIT_TESTING
+#include "test_utils.h"
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+static const struct CommandLineTestCase test_cases[] = {
+    {
+        {"semy", "--report", "1.0.0", "2.0.0-rc.1"},
+        0,
+        "arg\t1\t0\tok\t5\t1.0.0\n"
+        "arg\t2\t0\tok\t10\t2.0.0-rc.1\n",
+        "",
+    },
+    {
+        {"semy", "--report", "-m", "1.0.0", "2.0.0-rc.1"},
+        0,
+        "",
+        "",
+    },
+    {
+        {"semy", "-r", "1.0.0", "1.0", "-"},
+        1,
+        "arg\t1\t0\tok\t5\t1.0.0\n"
+        "arg\t2\t0\tbad-syntax\t3\t1.0\n"
+        "-\t1\t0\tok\t5\t1.0.0\n"
+        "-\t2\t6\tbad-syntax\t3\t1.0\n"
+        "-\t4\t11\tbad-syntax\t6\t2.0.0-\n"
+        "-\t5\t19\tok\t5\t3.0.0\n"
+        "-\t6\t25\tlimits-exceeded\t0\t2147483648.0.0\n",
+        "",
+        "1.0.0\n1.0\n\n2.0.0-\r\n3.0.0\n2147483648.0.0",
+    },
+    {
+        {"semy", "-r", "-m", "1.0.0", "1.0", "-"},
+        1,
+        "arg\t2\t0\tbad-syntax\t3\t1.0\n"
+        "-\t2\t6\tbad-syntax\t3\t1.0\n"
+        "-\t4\t11\tbad-syntax\t6\t2.0.0-\n"
+        "-\t6\t25\tlimits-exceeded\t0\t2147483648.0.0\n",
+        "",
+        "1.0.0\n1.0\n\n2.0.0-\r\n3.0.0\n2147483648.0.0",
+    },
+    {
+        {"semy", "-r", "-j", "1", "-m", "-", "x"},
+        1,
+        "-\t1\t0\tbad-syntax\t1\t1\n"
+        "arg\t1\t0\tbad-syntax\t0\tx\n",
+        "",
+        "1\n",
+    },
+    {
+        {"semy", "-r", "-k", "2", "-"},
+        1,
+        "-\t1\t0\tbad-syntax\t4\tx\t1.x\n"
+        "-\t2\t6\tok\t7\ty\t1.0.0\n",
+        "",
+        "x\t1.x\ny\t1.0.0\n",
+    },
+    {
+        {"semy", "-r", "-"},
+        0,
+        "",
+        "",
+        "",
+    },
+    {
+        {"semy", "-r", "-j"},
+        2,
+        "",
+        "error: expected a thread count between 1 and 256 after '-j'\n",
+    },
+    {
+        {"semy", "-r", "-j", "0", "1.0.0"},
+        2,
+        "",
+        "error: expected a thread count between 1 and 256 after '-j'\n",
+    },
+    {
+        {"semy", "-r", "-j", "257", "1.0.0"},
+        2,
+        "",
+        "error: expected a thread count between 1 and 256 after '-j'\n",
+    },
+    {
+        {"semy", "-r", "-j", "4x", "1.0.0"},
+        2,
+        "",
+        "error: expected a thread count between 1 and 256 after '-j'\n",
+    },
+    {
+        {"semy", "-r", "-f"},
+        2,
+        "",
+        "error: expected a file name after '-f'\n",
+    },
+    {
+        {"semy", "-r", "-f", "does-not-exist.txt"},
+        3,
+        "",
+        "error: cannot open file 'does-not-exist.txt'\n",
+    },
+};
+
+TEST(semy, cli, .iterations=COUNT_OF(test_cases))
+{
+    run_cli_test(&test_cases[TEST_ITERATION]);
+}
+
+// Generates input where most versions are malformed so chunks fill with failures
+// along with the report expected for it, which lists only the malformed versions
+// if 'malformed_only' is true.
+static void generate_report(const char *source, bool malformed_only, char **in, char **out)
+{
+    const int count = 5000;
+    *in = calloc((size_t)count, 32);
+    *out = calloc((size_t)count, 64);
+    ASSERT_NONNULL(*in);
+    ASSERT_NONNULL(*out);
+
+    size_t in_length = 0;
+    size_t out_length = 0;
+    for (int i = 0; i < count; i++)
+    {
+        const size_t offset = in_length;
+        if (i % 10 == 0)
+        {
+            const int length = sprintf(&(*in)[in_length], "1.0.%d\n", i);
+            in_length += (size_t)length;
+            if (!malformed_only)
+            {
+                out_length += (size_t)sprintf(&(*out)[out_length], "%s\t%d\t%zu\tok\t%d\t1.0.%d\n", source, i + 1, offset, length - 1, i);
+            }
+        }
+        else if (i % 10 == 1)
+        {
+            in_length += (size_t)sprintf(&(*in)[in_length], "\n");
+        }
+        else
+        {
+            const int length = sprintf(&(*in)[in_length], "1.%d\n", i);
+            in_length += (size_t)length;
+            out_length += (size_t)sprintf(&(*out)[out_length], "%s\t%d\t%zu\tbad-syntax\t%d\t1.%d\n", source, i + 1, offset, length - 1, i);
+        }
+    }
+}
+
+TEST(semy, cli_report_threads)
+{
+    char *in = NULL;
+    char *out = NULL;
+    generate_report("-", false, &in, &out);
+
+    const struct CommandLineTestCase test_case = {
+        {"semy", "-r", "-j", "4", "-"},
+        1,
+        out,
+        "",
+        in,
+    };
+    run_cli_test(&test_case);
+
+    free(in);
+    free(out);
+}
+
+TEST(semy, cli_report_file)
+{
+    char *in = NULL;
+    char *out = NULL;
+    generate_report("test_cli_report.txt", true, &in, &out);
+    write_file("test_cli_report.txt", in);
+
+    const struct CommandLineTestCase test_case = {
+        {"semy", "-r", "-m", "-j", "3", "-f", "test_cli_report.txt"},
+        1,
+        out,
+        "",
+    };
+    run_cli_test(&test_case);
+    remove("test_cli_report.txt");
+
+    free(in);
+    free(out);
+}
+
+TEST(semy, cli_report_empty_file)
+{
+    write_file("test_cli_report.txt", "");
+
+    const struct CommandLineTestCase test_case = {
+        {"semy", "-r", "-f", "test_cli_report.txt"},
+        0,
+        "",
+        "",
+    };
+    run_cli_test(&test_case);
+    remove("test_cli_report.txt");
+}
+
+// Verify an embedded null character is reported where it is unless an error precedes it.
+TEST(semy, cli_report_embedded_null)
+{
+    write_binary_file("test_cli_report.txt", "1.0.0\0abc\n1.x\0\n", 15);
+
+    const struct CommandLineTestCase test_case = {
+        {"semy", "-r", "-m", "-f", "test_cli_report.txt"},
+        1,
+        NULL,
+        NULL,
+    };
+
+    // The output includes null characters so it's compared as binary data.
+    const char *out = NULL;
+    size_t length = 0;
+    ASSERT_EQ(1, run_cli_capture(&test_case, &out, &length));
+    ASSERT_EQ((size_t)90, length);
+    ASSERT_EQ(0, memcmp(out, "test_cli_report.txt\t1\t0\tbad-syntax\t5\t1.0.0\0abc\n"
+                             "test_cli_report.txt\t2\t10\tbad-syntax\t2\t1.x\0\n", length));
+    remove("test_cli_report.txt");
+}
+
+// Verify a line larger than a batch is handled.
+TEST(semy, cli_report_line_exceeds_batch)
+{
+    const size_t length = 5 * 1024 * 1024;
+    char *in = calloc(length + 16, 1);
+    char *out = calloc(length + 64, 1);
+    ASSERT_NONNULL(in);
+    ASSERT_NONNULL(out);
+    strcpy(in, "1.0.0\n1.0.0-");
+    memset(&in[strlen(in)], 'a', length);
+    strcpy(out, "-\t1\t0\tok\t5\t1.0.0\n-\t2\t6\tlimits-exceeded\t200\t");
+    strcat(out, &in[6]);
+    strcat(out, "\n");
+
+    const struct CommandLineTestCase test_case = {
+        {"semy", "-r", "-"},
+        1,
+        out,
+        "",
+        in,
+    };
+    run_cli_test(&test_case);
+
+    free(in);
+    free(out);
+}
@@ -0,0 +1,203 @@
+// SPDX-License-Identifier: MIT
+/*
+ * Semy - a Semantic Versioning 2.0.0 processor.
+ * See https://semver.org/.
+ *
+ * Copyright (c) 2025-2026 Henry G. Stratmann III
+ * Copyright (c) 2025-2026 Semy Contributors
+ *
+ * This file is part of Semy, distributed under the MIT License.
+ * For full terms see the included LICENSE file.
+ */
+
+#define UNIT_TESTING
+#include "../semy-cli.c"
+#include "test_utils.h"
+#include <stdio.h>
+#include <stdlib.h>
+
+static const struct CommandLineTestCase test_cases[] = {
+    {
+        {"semy", "--serve"},
+        0,
+        "0 -1\n"
+        "0 0\n"
+        "0 1\n",
+        "",
+        "compare 1.0.0 2.0.0\n"
+        "compare\t1.0.0+a  1.0.0+b\n"
+        "compare 1.0.0 1.0.0-rc.1\r\n",
+    },
+    {
+        {"semy", "--serve"},
+        0,
+        "2 error: expected exactly two version strings\n"
+        "2 error: expected exactly two version strings\n"
+        "1 error: invalid semantic version\n"
+        "1 error: invalid semantic version\n",
+        "",
+        "compare 1.0.0\n"
+        "compare 1.0.0 2.0.0 3.0.0\n"
+        "compare 1.0 2.0.0\n"
+        "compare 1.0.0 2.0\n",
+    },
+    {
+        {"semy", "--serve"},
+        0,
+        "0\n"
+        "0\n"
+        "1 error: invalid semantic version\n"
+        "3 error: semantic version is too complex for this implementation\n",
+        "",
+        "validate 1.0.0 2.0.0-alpha+build\n"
+        "validate\n"
+        "validate 1.0.0 01.0.0 2.0\n"
+        "validate 1.0.0-1.2.3.4.5.6.7.8.9.10.11.12.13.14.15.16.17.18.19.20.21.22.23.24.25.26\n",
+    },
+    {
+        {"semy", "--serve"},
+        0,
+        "0 true\n"
+        "0 false\n"
+        "0 true\n"
+        "0 false\n"
+        "0 true\n"
+        "0 false\n"
+        "0 true\n"
+        "0 true\n",
+        "",
+        "satisfies 1.2.3 >=1.0.0 <2.0.0\n"
+        "satisfies 2.0.0 >=1.0.0 <2.0.0\n"
+        "satisfies 2.0.0-rc.1 <2.0.0 >1.0.0\n"
+        "satisfies 1.0.0 >1.0.0\n"
+        "satisfies 1.0.0 <=1.0.0\n"
+        "satisfies 1.0.0 =1.0.1\n"
+        "satisfies 1.0.0+a 1.0.0+b\n"
+        "satisfies 1.0.0 =1.0.0\n",
+    },
+    {
+        {"semy", "--serve"},
+        0,
+        "2 error: expected a version followed by one or more comparators\n"
+        "1 error: invalid semantic version\n"
+        "1 error: invalid comparator\n"
+        "1 error: invalid comparator\n"
+        "1 error: invalid semantic version\n",
+        "",
+        "satisfies 1.0.0\n"
+        "satisfies 1.0 >=1.0.0\n"
+        "satisfies 1.0.0 =<1.0.0\n"
+        "satisfies 1.0.0 >>>1.0.0\n"
+        "satisfies 1.0.0 >=\n",
+    },
+    {
+        {"semy", "--serve"},
+        0,
+        "0 1.0.0-alpha 1.0.0-alpha.1 1.0.0-alpha.beta 1.0.0-beta 1.0.0 2.0.0\n"
+        "0\n"
+        "1 error: invalid semantic version\n",
+        "",
+        "sort 2.0.0 1.0.0-beta 1.0.0 1.0.0-alpha.beta 1.0.0-alpha.1 1.0.0-alpha\n"
+        "sort\n"
+        "sort 1.0.0 1.0\n",
+    },
+    {
+        {"semy", "--serve"},
+        0,
+        "2 error: invalid request 'frobnicate'\n"
+        "0\n",
+        "",
+        "frobnicate 1.0.0\n"
+        "   \t \n"
+        "\n"
+        "validate 1.0.0\n"
+        "quit\n"
+        "validate 1.0\n",
+    },
+    {
+        {"semy", "--serve", "a", "b"},
+        2,
+        "",
+        "error: expected at most one socket path\n",
+    },
+};
+
+TEST(semy, cli, .iterations=COUNT_OF(test_cases))
+{
+    run_cli_test(&test_cases[TEST_ITERATION]);
+}
+
+TEST(semy, cli_serve_sort_many)
+{
+    static char in[64 * 1024];
+    static char out[64 * 1024];
+    size_t in_length = 0;
+    size_t out_length = 0;
+
+    // Enough versions to grow the reused sort keys several times.
+    in_length += (size_t)sprintf(&in[in_length], "sort");
+    out_length += (size_t)sprintf(&out[out_length], "0");
+    for (int i = 299; i >= 0; i--)
+    {
+        in_length += (size_t)sprintf(&in[in_length], " %d.0.0", i);
+    }
+    for (int i = 0; i < 300; i++)
+    {
+        out_length += (size_t)sprintf(&out[out_length], " %d.0.0", i);
+    }
+    sprintf(&in[in_length], "\nsort 1.0.0\n");
+    sprintf(&out[out_length], "\n0 1.0.0\n");
+
+    const struct CommandLineTestCase test_case = {
+        {"semy", "--serve"},
+        0,
+        out,
+        "",
+        in,
+    };
+    run_cli_test(&test_case);
+}
+
+#if defined(HAVE_POSIX_IO)
+static const struct
+{
+    const char *requests;
+    const char *answers;
+} pipelined[] = {
+    {"compare 1.0.0 2.0.0\nquit\n", "0 -1\n"},
+    {"validate 1.0.0\nvalidate 1.0\nquit\n", "0\n1 error: invalid semantic version\n"},
+    {"validate 1.0.0\nvalidate 1.0\n", "0\n1 error: invalid semantic version\n"},
+};
+
+// Verify a socket client is given every answer when it quits, or its input ends, after
+// pipelining requests. Unlike stdin, nothing flushes the answers after the stream is served.
+TEST(semy, cli_serve_stream_pipelined, .iterations=COUNT_OF(pipelined))
+{
+    const char *requests = pipelined[TEST_ITERATION].requests;
+    int client[2];
+    ASSERT_EQ(0, socketpair(AF_UNIX, SOCK_STREAM, 0, client));
+    ASSERT_EQ((ssize_t)strlen(requests), write(client[0], requests, strlen(requests)));
+    shutdown(client[0], SHUT_WR);
+
+    FILE *stream = fdopen(client[1], "rb");
+    ASSERT_NONNULL(stream);
+    output.fd = client[1];
+    output.length = 0;
+    output.failed = false;
+
+    struct server server = {0};
+    ASSERT_EQ(EXIT_SUCCESS, serve_stream(&server, stream));
+    fclose(stream);
+    free(server.keys);
+
+    char answers[256] = {0};
+    size_t length = 0;
+    ssize_t count;
+    while ((count = read(client[0], &answers[length], sizeof(answers) - 1 - length)) > 0)
+    {
+        length += (size_t)count;
+    }
+    close(client[0]);
+    ASSERT_STR_EQ(pipelined[TEST_ITERATION].answers, answers);
+}
+#endif
@@ -40,6 +40,15 @@ static const struct CommandLineTestCase test_cases[] = {
         "1.0.0\n",
         "",
     },
+    {
+        {"semy", "-s", "1.0.0-alpha.2", "1.0.0-alphabet", "1.0.0-alpha.1", "1.0.0-alpha"},
+        0,
+        "1.0.0-alpha\n"
+        "1.0.0-alpha.1\n"
+        "1.0.0-alpha.2\n"
+        "1.0.0-alphabet\n",
+        "",
+    },
     {
         {"semy", "-s", "2.0.0", "2.0.0beta", "2.0.1"},
         1,
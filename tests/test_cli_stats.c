@@ -0,0 +1,100 @@
+// SPDX-License-Identifier: MIT
+/*
+ * Semy - a Semantic Versioning 2.0.0 processor.
+ * See https://semver.org/.
+ *
+ * Copyright (c) 2025-2026 Henry G. Stratmann III
+ * Copyright (c) 2025-2026 Semy Contributors
+ *
+ * This file is part of Semy, distributed under the MIT License.
+ * For full terms see the included LICENSE file.
+ */
+
+#define UNIT_TESTING
+#include "test_utils.h"
+#include <stdlib.h>
+
+static const struct CommandLineTestCase test_cases[] = {
+    {
+        {"semy", "--stats", "-s", "2.0.0", "1.0.0-rc.1", "1.0.0"},
+        0,
+        "1.0.0-rc.1\n"
+        "1.0.0\n"
+        "2.0.0\n",
+        "items: 3\n"
+        "bytes read: 20\n"
+        "read time: 0.000000 s\n"
+        "parse time: 0.000000 s\n"
+        "sort time: 0.000000 s\n"
+        "output time: 0.000000 s\n"
+        "total time: 0.000000 s\n"
+        "peak memory: 1024 KiB\n"
+        "items per second: 0\n",
+    },
+    {
+        {"semy", "--stats", "-v", "-"},
+        0,
+        "",
+        "items: 2\n"
+        "bytes read: 12\n"
+        "read time: 0.000000 s\n"
+        "parse time: 0.000000 s\n"
+        "sort time: 0.000000 s\n"
+        "output time: 0.000000 s\n"
+        "total time: 0.000000 s\n"
+        "peak memory: 1024 KiB\n"
+        "items per second: 0\n",
+        "1.0.0\n2.0.0\n",
+    },
+    {
+        {"semy", "--stats", "-r", "-"},
+        1,
+        "-\t1\t0\tok\t5\t1.0.0\n"
+        "-\t2\t6\tbad-syntax\t3\t1.0\n"
+        "-\t3\t10\tok\t5\t2.0.0\n",
+        "items: 3\n"
+        "bytes read: 16\n"
+        "read time: 0.000000 s\n"
+        "parse time: 0.000000 s\n"
+        "sort time: 0.000000 s\n"
+        "output time: 0.000000 s\n"
+        "total time: 0.000000 s\n"
+        "peak memory: 1024 KiB\n"
+        "items per second: 0\n",
+        "1.0.0\n1.0\n2.0.0\n",
+    },
+    {
+        {"semy", "--stats", "-c", "1.0.0", "2.0.0"},
+        0,
+        "-1\n",
+        "items: 2\n"
+        "bytes read: 0\n"
+        "read time: 0.000000 s\n"
+        "parse time: 0.000000 s\n"
+        "sort time: 0.000000 s\n"
+        "output time: 0.000000 s\n"
+        "total time: 0.000000 s\n"
+        "peak memory: 1024 KiB\n"
+        "items per second: 0\n",
+    },
+    {
+        {"semy", "--stats", "--unknown"},
+        2,
+        "",
+        "error: invalid argument '--unknown'\n"
+        "items: 0\n"
+        "bytes read: 0\n"
+        "read time: 0.000000 s\n"
+        "parse time: 0.000000 s\n"
+        "sort time: 0.000000 s\n"
+        "output time: 0.000000 s\n"
+        "total time: 0.000000 s\n"
+        "peak memory: 1024 KiB\n"
+        "items per second: 0\n",
+    },
+};
+
+TEST(semy, cli, .iterations=COUNT_OF(test_cases))
+{
+    run_cli_test(&test_cases[TEST_ITERATION]);
+}
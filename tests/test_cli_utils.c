@@ -17,12 +17,14 @@
 struct StringBuf
 {
     int length;
-    char buffer[1024 * 16];
+    char buffer[1024 * 1024 * 8];
 };
 
 static struct StringBuf captured_stdout;
 static struct StringBuf captured_stderr;
 
+static const char *fake_stdin;
+
 static int allowed_allocations;
 
 static void my_fprintf(FILE *stream, const char *format, ...)
@@ -52,6 +54,22 @@ static void my_fprintf(FILE *stream, const char *format, ...)
     va_end(copy);
 }
 
+static bool my_writev(int fd, struct iovec *iov, int count)
+{
+    struct StringBuf *sb = (fd == 1) ? &captured_stdout : &captured_stderr;
+    for (int i = 0; i < count; i++)
+    {
+        if (sb->length + iov[i].iov_len >= COUNT_OF(sb->buffer))
+        {
+            fprintf(stderr, "error: writev() buffer lacks space");
+            exit(EXIT_FAILURE);
+        }
+        memcpy(&sb->buffer[sb->length], iov[i].iov_base, iov[i].iov_len);
+        sb->length += (int)iov[i].iov_len;
+    }
+    return true;
+}
+
 static void *my_calloc(size_t count, size_t size)
 {
     if (allowed_allocations > 0)
@@ -62,6 +80,34 @@ static void *my_calloc(size_t count, size_t size)
     return NULL;
 }
 
+static size_t my_fread(void *buffer, size_t size, FILE *stream)
+{
+    if (stream != stdin)
+    {
+        return fread(buffer, 1, size, stream);
+    }
+
+    size_t count = strlen(fake_stdin);
+    if (count > size)
+    {
+        count = size;
+    }
+    memcpy(buffer, fake_stdin, count);
+    fake_stdin += count;
+    return count;
+}
+
+// Statistics are reported with a fixed clock and peak memory so they're reproducible.
+static double my_clock(void)
+{
+    return 0.0;
+}
+
+static uint64_t my_peak_memory(void)
+{
+    return 1024;
+}
+
 TEST_SETUP(semy)
 {
     memset(&captured_stdout, 0, sizeof(captured_stdout));
@@ -70,6 +116,7 @@ TEST_SETUP(semy)
 
 static void std_test(const struct CommandLineTestCase *test_case, const char *test_name, int argc, char **argv)
 {
+    fake_stdin = test_case->in ? test_case->in : "";
     const int exit_code = cli_main(argc, argv);
     EXPECT_EQ(test_case->exit_code, exit_code, "unexpected exit code: %s", test_name);
 
@@ -84,6 +131,9 @@ static void oom_test(const struct CommandLineTestCase *test_case, const char *te
     for (int i = 0; i < 100; i++)
     {
         allowed_allocations = i;
+        fake_stdin = test_case->in ? test_case->in : "";
+        memset(&captured_stdout, 0, sizeof(captured_stdout));
+        memset(&captured_stderr, 0, sizeof(captured_stderr));
         if (cli_main(argc, argv) != EXIT_OUT_OF_MEMORY)
         {
             return;
@@ -95,6 +145,11 @@ static void oom_test(const struct CommandLineTestCase *test_case, const char *te
 void run_cli_test(const struct CommandLineTestCase *test_case)
 {
     FAKE(cli_fprintf, my_fprintf);
+    FAKE(cli_fread, my_fread);
+    FAKE(cli_fread_available, my_fread);
+    FAKE(cli_writev, my_writev);
+    FAKE(cli_clock, my_clock);
+    FAKE(cli_peak_memory, my_peak_memory);
 
     char cmd[1024] = {0};
 
@@ -112,3 +167,38 @@ void run_cli_test(const struct CommandLineTestCase *test_case)
     std_test(test_case, cmd, argc, (char **)test_case->argv);
     oom_test(test_case, cmd, argc, (char **)test_case->argv);
 }
+
+void write_binary_file(const char *path, const void *content, size_t size)
+{
+    FILE *file = fopen(path, "wb");
+    ASSERT_NONNULL(file);
+    fwrite(content, 1, size, file);
+    fclose(file);
+}
+
+void write_file(const char *path, const char *content)
+{
+    write_binary_file(path, content, strlen(content));
+}
+
+int run_cli_capture(const struct CommandLineTestCase *test_case, const char **out, size_t *length)
+{
+    FAKE(cli_fprintf, my_fprintf);
+    FAKE(cli_fread, my_fread);
+    FAKE(cli_fread_available, my_fread);
+    FAKE(cli_writev, my_writev);
+    FAKE(cli_clock, my_clock);
+    FAKE(cli_peak_memory, my_peak_memory);
+
+    int argc = 0;
+    while (test_case->argv[argc])
+    {
+        argc += 1;
+    }
+
+    fake_stdin = test_case->in ? test_case->in : "";
+    const int exit_code = cli_main(argc, (char **)test_case->argv);
+    *out = captured_stdout.buffer;
+    *length = (size_t)captured_stdout.length;
+    return exit_code;
+}
@@ -0,0 +1,240 @@
+// SPDX-License-Identifier: MIT
+/*
+ * Semy - a Semantic Versioning 2.0.0 processor.
+ * See https://semver.org/.
+ *
+ * Copyright (c) 2025-2026 Henry G. Stratmann III
+ * Copyright (c) 2025-2026 Semy Contributors
+ *
+ * This file is part of Semy, distributed under the MIT License.
+ * For full terms see the included LICENSE file.
+ */
+
+#include "semy.h"
+#include "test_utils.h"
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+static const char *versions[] = {
+    "2.0.0",
+    "1.0.0-alpha.beta",
+    "1.0.0+build.2",
+    "3.6.1-rc.1",
+    "3.7.0",
+    "3.0.0-x.7.z.92+exp.sha.5114f85.20130313144700",
+    "0.9.10",
+    "2147483647.2147483647.2147483647",
+};
+
+TEST(columns, parse_and_get)
+{
+    semy_columns_t columns;
+    size_t parsed = 99;
+    ASSERT_EQ((int)SEMY_NO_ERROR, semy_columns_init(&columns));
+    ASSERT_EQ((int)SEMY_NO_ERROR, semy_columns_parse(&columns, versions, NULL, COUNT_OF(versions), &parsed));
+    ASSERT_EQ(COUNT_OF(versions), parsed);
+    ASSERT_EQ(COUNT_OF(versions), semy_columns_count(&columns));
+
+    for (size_t i = 0; i < COUNT_OF(versions); i++)
+    {
+        semy_t semver;
+        char output[1024] = {0};
+        ASSERT_EQ((int)SEMY_NO_ERROR, semy_columns_get(&columns, i, &semver, sizeof(semver)));
+        format_version(&semver, output);
+        ASSERT_STR_EQ(versions[i], output);
+    }
+
+    // The columns are plain arrays.
+    const int32_t *minor = semy_columns_core(&columns, SEMY_FIELD_MINOR);
+    ASSERT_EQ(6, minor[3]);
+    ASSERT_EQ(7, minor[4]);
+    ASSERT_EQ(0x2A, semy_columns_pre_release(&columns)[0]);
+
+    semy_columns_free(&columns);
+    ASSERT_EQ(0, semy_columns_count(&columns));
+}
+
+TEST(columns, append)
+{
+    semy_columns_t columns;
+    semy_t full;
+    semy_compact32_t compact;
+    char output[1024] = {0};
+
+    ASSERT_EQ((int)SEMY_NO_ERROR, semy_columns_init(&columns));
+    ASSERT_EQ((int)SEMY_NO_ERROR, semy_parse(&full, sizeof(full), "1.2.3-beta+exp"));
+    ASSERT_EQ((int)SEMY_NO_ERROR, semy_parse((semy_t *)&compact, sizeof(compact), "4.5.6-rc.1"));
+    ASSERT_EQ((int)SEMY_NO_ERROR, semy_columns_append(&columns, &full));
+    ASSERT_EQ((int)SEMY_NO_ERROR, semy_columns_append(&columns, (const semy_t *)&compact));
+
+    ASSERT_EQ((int)SEMY_NO_ERROR, semy_columns_get(&columns, 1, (semy_t *)&compact, sizeof(compact)));
+    format_version((const semy_t *)&compact, output);
+    ASSERT_STR_EQ("4.5.6-rc.1", output);
+
+    ASSERT_EQ((int)SEMY_NO_ERROR, semy_columns_get(&columns, 0, &full, sizeof(full)));
+    format_version(&full, output);
+    ASSERT_STR_EQ("1.2.3-beta+exp", output);
+
+    // Versions beyond the limits of 'semy_t' are kept and copied out to extended layouts.
+    char input[64] = "7.0.0-a";
+    for (size_t i = 7; i + 2 < sizeof(input); i += 2)
+    {
+        memcpy(&input[i], ".a", 2);
+    }
+    semy_t *extended = malloc(SEMY_EXTENDED_SIZE(sizeof(input)));
+    ASSERT_NONNULL(extended);
+    ASSERT_EQ((int)SEMY_NO_ERROR, semy_parse(extended, SEMY_EXTENDED_SIZE(sizeof(input)), input));
+    ASSERT_EQ((int)SEMY_NO_ERROR, semy_columns_append(&columns, extended));
+    ASSERT_EQ((int)SEMY_LIMITS_EXCEEDED, semy_columns_get(&columns, 2, &full, sizeof(full)));
+    ASSERT_EQ((int)SEMY_NO_ERROR, semy_columns_get(&columns, 2, extended, SEMY_EXTENDED_SIZE(sizeof(input))));
+    format_version(extended, output);
+    ASSERT_STR_EQ(input, output);
+    free(extended);
+
+    semy_columns_free(&columns);
+}
+
+TEST(columns, scan)
+{
+    semy_columns_t columns;
+    uint64_t matches[1] = {UINT64_MAX};
+    ASSERT_EQ((int)SEMY_NO_ERROR, semy_columns_init(&columns));
+    ASSERT_EQ((int)SEMY_NO_ERROR, semy_columns_parse(&columns, versions, NULL, COUNT_OF(versions), NULL));
+
+    // major == 3 && minor < 7
+    const semy_predicate_t filter[] = {
+        {SEMY_FIELD_MAJOR, SEMY_EQ, 3},
+        {SEMY_FIELD_MINOR, SEMY_LT, 7},
+    };
+    ASSERT_EQ((int)SEMY_NO_ERROR, semy_columns_scan(&columns, filter, COUNT_OF(filter), matches));
+    ASSERT_EQ(0x28, matches[0]);
+
+    // Versions without pre-release identifiers.
+    const semy_predicate_t normal[] = {{SEMY_FIELD_PRE_RELEASE, SEMY_EQ, 0}};
+    ASSERT_EQ((int)SEMY_NO_ERROR, semy_columns_scan(&columns, normal, COUNT_OF(normal), matches));
+    ASSERT_EQ(0xD5, matches[0]);
+
+    const semy_predicate_t pre_release[] = {
+        {SEMY_FIELD_PRE_RELEASE, SEMY_GT, 0},
+        {SEMY_FIELD_PRE_RELEASE, SEMY_LE, 1},
+        {SEMY_FIELD_PRE_RELEASE, SEMY_LT, 2},
+    };
+    ASSERT_EQ((int)SEMY_NO_ERROR, semy_columns_scan(&columns, pre_release, COUNT_OF(pre_release), matches));
+    ASSERT_EQ(0x2A, matches[0]);
+
+    // Every version matches when there are no predicates.
+    ASSERT_EQ((int)SEMY_NO_ERROR, semy_columns_scan(&columns, NULL, 0, matches));
+    ASSERT_EQ(0xFF, matches[0]);
+
+    const semy_predicate_t operators[] = {
+        {SEMY_FIELD_PATCH, SEMY_NE, 0},
+        {SEMY_FIELD_PATCH, SEMY_LE, 10},
+        {SEMY_FIELD_MINOR, SEMY_GT, 0},
+        {SEMY_FIELD_MAJOR, SEMY_GE, 0},
+        {SEMY_FIELD_PRE_RELEASE, SEMY_GE, 0},
+    };
+    ASSERT_EQ((int)SEMY_NO_ERROR, semy_columns_scan(&columns, operators, COUNT_OF(operators), matches));
+    ASSERT_EQ(0x48, matches[0]);
+
+    semy_columns_free(&columns);
+}
+
+// Verify scans agree with testing each version individually across many blocks.
+TEST(columns, scan_many)
+{
+    enum { COUNT = 5000 };
+    static char strings[COUNT][32];
+    static const char *pointers[COUNT];
+    static uint64_t matches[(COUNT + 63) / 64];
+
+    for (int i = 0; i < COUNT; i++)
+    {
+        sprintf(strings[i], "%d.%d.%d%s", i % 5, (i / 5) % 11, i % 3, (i % 7 == 0) ? "-rc.1" : "");
+        pointers[i] = strings[i];
+    }
+
+    semy_columns_t columns;
+    ASSERT_EQ((int)SEMY_NO_ERROR, semy_columns_init(&columns));
+    ASSERT_EQ((int)SEMY_NO_ERROR, semy_columns_parse(&columns, pointers, NULL, COUNT, NULL));
+
+    const semy_predicate_t filter[] = {
+        {SEMY_FIELD_MAJOR, SEMY_EQ, 3},
+        {SEMY_FIELD_MINOR, SEMY_LT, 7},
+        {SEMY_FIELD_PRE_RELEASE, SEMY_NE, 1},
+    };
+    memset(matches, 0xFF, sizeof(matches));
+    ASSERT_EQ((int)SEMY_NO_ERROR, semy_columns_scan(&columns, filter, COUNT_OF(filter), matches));
+
+    for (int i = 0; i < COUNT; i++)
+    {
+        const bool expected = (i % 5 == 3) && ((i / 5) % 11 < 7) && (i % 7 != 0);
+        const bool actual = (matches[i / 64] >> (i % 64)) & 1;
+        ASSERT_EQ(expected, actual, "unexpected match for: %s", strings[i]);
+    }
+
+    // Bits past the last version are cleared.
+    ASSERT_EQ(0, matches[COUNT / 64] >> (COUNT % 64));
+
+    semy_columns_free(&columns);
+}
+
+TEST(columns, parse_invalid_versions)
+{
+    static const char *const strings[] = {"1.0.0", "2.0.0-rc.1", "1.0", "3.0.0"};
+    static const size_t lengths[] = {5, 6, 3, 5};
+    semy_columns_t columns;
+    size_t parsed = 99;
+
+    ASSERT_EQ((int)SEMY_NO_ERROR, semy_columns_init(&columns));
+
+    // Versions before the malformed one are appended.
+    ASSERT_EQ((int)SEMY_BAD_SYNTAX, semy_columns_parse(&columns, strings, NULL, COUNT_OF(strings), &parsed));
+    ASSERT_EQ(2, parsed);
+
+    // With lengths, the second version is truncated to "2.0.0-".
+    ASSERT_EQ((int)SEMY_BAD_SYNTAX, semy_columns_parse(&columns, strings, lengths, COUNT_OF(strings), &parsed));
+    ASSERT_EQ(1, parsed);
+    ASSERT_EQ(3, semy_columns_count(&columns));
+
+    semy_columns_free(&columns);
+}
+
+TEST(columns, illegal_arguments)
+{
+    semy_columns_t columns;
+    semy_t semver = {0};
+    uint64_t matches[1];
+
+    ASSERT_EQ((int)SEMY_INVALID_OPERATION, semy_columns_init(NULL));
+    ASSERT_EQ((int)SEMY_NO_ERROR, semy_columns_init(&columns));
+    ASSERT_EQ((int)SEMY_NO_ERROR, semy_parse(&semver, sizeof(semver), "1.0.0"));
+
+    ASSERT_EQ((int)SEMY_INVALID_OPERATION, semy_columns_append(NULL, &semver));
+    ASSERT_EQ((int)SEMY_INVALID_OPERATION, semy_columns_append(&columns, NULL));
+    ASSERT_EQ((int)SEMY_INVALID_OPERATION, semy_columns_parse(NULL, NULL, NULL, 0, NULL));
+    ASSERT_EQ((int)SEMY_INVALID_OPERATION, semy_columns_parse(&columns, NULL, NULL, 1, NULL));
+    ASSERT_EQ((int)SEMY_NO_ERROR, semy_columns_append(&columns, &semver));
+
+    ASSERT_EQ(0, semy_columns_count(NULL));
+    ASSERT_NULL(semy_columns_core(NULL, SEMY_FIELD_MAJOR));
+    ASSERT_NULL(semy_columns_core(&columns, SEMY_FIELD_PRE_RELEASE));
+    ASSERT_NULL(semy_columns_pre_release(NULL));
+
+    ASSERT_EQ((int)SEMY_INVALID_OPERATION, semy_columns_get(NULL, 0, &semver, sizeof(semver)));
+    ASSERT_EQ((int)SEMY_INVALID_OPERATION, semy_columns_get(&columns, 0, NULL, sizeof(semver)));
+    ASSERT_EQ((int)SEMY_INVALID_OPERATION, semy_columns_get(&columns, 1, &semver, sizeof(semver)));
+    ASSERT_EQ((int)SEMY_INVALID_OPERATION, semy_columns_get(&columns, 0, &semver, sizeof(semver) - 1));
+
+    const semy_predicate_t bad_field[] = {{(semy_field_t)4, SEMY_EQ, 0}};
+    const semy_predicate_t bad_operator[] = {{SEMY_FIELD_MAJOR, (semy_operator_t)6, 0}};
+    ASSERT_EQ((int)SEMY_INVALID_OPERATION, semy_columns_scan(NULL, NULL, 0, matches));
+    ASSERT_EQ((int)SEMY_INVALID_OPERATION, semy_columns_scan(&columns, NULL, 0, NULL));
+    ASSERT_EQ((int)SEMY_INVALID_OPERATION, semy_columns_scan(&columns, NULL, 1, matches));
+    ASSERT_EQ((int)SEMY_INVALID_OPERATION, semy_columns_scan(&columns, bad_field, 1, matches));
+    ASSERT_EQ((int)SEMY_INVALID_OPERATION, semy_columns_scan(&columns, bad_operator, 1, matches));
+
+    semy_columns_free(NULL);
+    semy_columns_free(&columns);
+}
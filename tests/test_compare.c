@@ -125,6 +125,33 @@ TEST(semver, parse, .iterations=COUNT_OF(test_cases))
     ASSERT_EQ(test_case->compare_result, result, "unexpected compare result for '%s' and '%s'", test_case->LHS, test_case->RHS);
 }
 
+// Verify compact layouts compare like the full layout, including against it.
+TEST(semver, compact, .iterations=COUNT_OF(test_cases))
+{
+    const struct TestCase *test_case = &test_cases[TEST_ITERATION];
+    semy_compact64_t v1 = {0};
+    semy_compact64_t v2 = {0};
+    semy_t full = {0};
+    int32_t result = -99;
+
+    if (semy_parse((semy_t *)&v1, sizeof(v1), test_case->LHS) != SEMY_NO_ERROR ||
+        semy_parse((semy_t *)&v2, sizeof(v2), test_case->RHS) != SEMY_NO_ERROR)
+    {
+        return; // The identifiers do not fit.
+    }
+
+    ASSERT_EQ((int)SEMY_NO_ERROR, semy_compare((const semy_t *)&v1, (const semy_t *)&v2, &result));
+    ASSERT_EQ(test_case->compare_result, result, "unexpected compare result for '%s' and '%s'", test_case->LHS, test_case->RHS);
+
+    ASSERT_EQ((int)SEMY_NO_ERROR, semy_parse(&full, sizeof(full), test_case->RHS));
+    ASSERT_EQ((int)SEMY_NO_ERROR, semy_compare((const semy_t *)&v1, &full, &result));
+    ASSERT_EQ(test_case->compare_result, result, "unexpected compare result for '%s' and '%s'", test_case->LHS, test_case->RHS);
+
+    ASSERT_EQ((int)SEMY_NO_ERROR, semy_parse(&full, sizeof(full), test_case->LHS));
+    ASSERT_EQ((int)SEMY_NO_ERROR, semy_compare(&full, (const semy_t *)&v2, &result));
+    ASSERT_EQ(test_case->compare_result, result, "unexpected compare result for '%s' and '%s'", test_case->LHS, test_case->RHS);
+}
+
 TEST(semver, null_arguments)
 {
     semy_error_t err = SEMY_NO_ERROR;
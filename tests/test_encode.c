@@ -0,0 +1,201 @@
+// SPDX-License-Identifier: MIT
+/*
+ * Semy - a Semantic Versioning 2.0.0 processor.
+ * See https://semver.org/.
+ *
+ * Copyright (c) 2025-2026 Henry G. Stratmann III
+ * Copyright (c) 2025-2026 Semy Contributors
+ *
+ * This file is part of Semy, distributed under the MIT License.
+ * For full terms see the included LICENSE file.
+ */
+
+#include "semy.h"
+#include "test_utils.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+static const char *versions[] = {
+    "0.0.0",
+    "1.2.3",
+    "1.0.0-alpha",
+    "1.0.0-alpha.1",
+    "1.0.0-0.3.7",
+    "1.0.0-x.7.z.92",
+    "1.0.0-x-y-z.--",
+    "1.0.0-1a.a1.000a",
+    "1.0.0+20130313144700",
+    "1.0.0-beta+exp.sha.5114f85",
+    "1.0.0+21AF26D3----117B344092BD",
+    "1.0.0-alpha.2147483647+0.01",
+    "2147483647.2147483647.2147483647",
+};
+
+// Verify every version survives a round trip through each layout.
+TEST(encode, round_trip, .iterations=COUNT_OF(versions))
+{
+    const char *version = versions[TEST_ITERATION];
+    semy_t semver;
+    semy_compact64_t compact;
+    uint8_t data[256];
+    size_t size = 0;
+    char output[1024] = {0};
+
+    ASSERT_EQ((int)SEMY_NO_ERROR, semy_parse(&semver, sizeof(semver), version));
+    ASSERT_EQ((int)SEMY_NO_ERROR, semy_encode(&semver, NULL, &size));
+    ASSERT_LE(size, strlen(version), "expected the encoding to be no longer than the string: %s", version);
+
+    size = sizeof(data);
+    ASSERT_EQ((int)SEMY_NO_ERROR, semy_encode(&semver, data, &size));
+
+    // Decode into the full layout.
+    size_t length = size;
+    memset(&semver, 0xFF, sizeof(semver));
+    ASSERT_EQ((int)SEMY_NO_ERROR, semy_decode(&semver, sizeof(semver), data, &length));
+    ASSERT_EQ(size, length);
+    format_version(&semver, output);
+    ASSERT_STR_EQ(version, output);
+
+    // Decode into a compact layout and encode it again.
+    length = size;
+    ASSERT_EQ((int)SEMY_NO_ERROR, semy_decode((semy_t *)&compact, sizeof(compact), data, &length));
+    format_version((const semy_t *)&compact, output);
+    ASSERT_STR_EQ(version, output);
+
+    uint8_t again[256];
+    length = sizeof(again);
+    ASSERT_EQ((int)SEMY_NO_ERROR, semy_encode((const semy_t *)&compact, again, &length));
+    ASSERT_EQ(size, length);
+    ASSERT_MEM_EQ(data, again, size);
+
+    // Every truncation of the data is rejected.
+    for (size_t i = 0; i < size; i++)
+    {
+        length = i;
+        ASSERT_EQ((int)SEMY_BAD_SYNTAX, semy_decode(&semver, sizeof(semver), data, &length), "decoded %zu bytes of: %s", i, version);
+    }
+}
+
+// Verify encoded versions stored one after another are decoded in turn.
+TEST(encode, stream)
+{
+    uint8_t data[1024];
+    size_t size = 0;
+    for (size_t i = 0; i < COUNT_OF(versions); i++)
+    {
+        semy_t semver;
+        size_t length = sizeof(data) - size;
+        ASSERT_EQ((int)SEMY_NO_ERROR, semy_parse(&semver, sizeof(semver), versions[i]));
+        ASSERT_EQ((int)SEMY_NO_ERROR, semy_encode(&semver, &data[size], &length));
+        size += length;
+    }
+
+    size_t offset = 0;
+    for (size_t i = 0; i < COUNT_OF(versions); i++)
+    {
+        semy_t semver;
+        char output[1024] = {0};
+        size_t length = size - offset;
+        ASSERT_EQ((int)SEMY_NO_ERROR, semy_decode(&semver, sizeof(semver), &data[offset], &length));
+        format_version(&semver, output);
+        ASSERT_STR_EQ(versions[i], output);
+        offset += length;
+    }
+    ASSERT_EQ(size, offset);
+}
+
+TEST(encode, buffer_too_small)
+{
+    semy_t semver;
+    uint8_t data[4];
+    size_t size = sizeof(data);
+    ASSERT_EQ((int)SEMY_NO_ERROR, semy_parse(&semver, sizeof(semver), "1.0.0-rc.1"));
+    ASSERT_EQ((int)SEMY_INVALID_OPERATION, semy_encode(&semver, data, &size));
+    ASSERT_EQ(8, size);
+}
+
+TEST(encode, layout_limits)
+{
+    // Thirty identifiers fit an extended layout but not 'semy_t'.
+    char version[128] = "1.0.0-a";
+    for (size_t i = 7; i < 7 + (29 * 2); i += 2)
+    {
+        memcpy(&version[i], ".a", 2);
+    }
+
+    const size_t extended_size = SEMY_EXTENDED_SIZE(sizeof(version));
+    semy_t *extended = malloc(extended_size);
+    ASSERT_NONNULL(extended);
+    ASSERT_EQ((int)SEMY_NO_ERROR, semy_parse(extended, extended_size, version));
+
+    uint8_t data[256];
+    size_t size = sizeof(data);
+    ASSERT_EQ((int)SEMY_NO_ERROR, semy_encode(extended, data, &size));
+
+    semy_t semver;
+    semy_compact32_t compact;
+    size_t length = size;
+    ASSERT_EQ((int)SEMY_LIMITS_EXCEEDED, semy_decode(&semver, sizeof(semver), data, &length));
+    length = size;
+    ASSERT_EQ((int)SEMY_LIMITS_EXCEEDED, semy_decode((semy_t *)&compact, sizeof(compact), data, &length));
+
+    char output[1024] = {0};
+    length = size;
+    memset(extended, 0, extended_size);
+    ASSERT_EQ((int)SEMY_NO_ERROR, semy_decode(extended, extended_size, data, &length));
+    format_version(extended, output);
+    ASSERT_STR_EQ(version, output);
+    free(extended);
+
+    // Identifiers longer than 'semy_t' holds are rejected too.
+    const uint8_t long_identifier[] = {1, 0, 0, 1, 1, 0xC8, 0x01};
+    uint8_t long_data[sizeof(long_identifier) + 200];
+    memcpy(long_data, long_identifier, sizeof(long_identifier));
+    memset(&long_data[sizeof(long_identifier)], 'a', 200);
+    length = sizeof(long_data);
+    ASSERT_EQ((int)SEMY_LIMITS_EXCEEDED, semy_decode(&semver, sizeof(semver), long_data, &length));
+}
+
+TEST(encode, malformed_data)
+{
+    static const struct {
+        uint8_t data[16];
+        size_t length;
+        semy_error_t status_code;
+    } cases[] = {
+        {{0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x00}, 11, SEMY_BAD_SYNTAX}, // Overlong integer.
+        {{0x80, 0x00, 0, 0}, 4, SEMY_BAD_SYNTAX},                                                 // Overlong encoding of zero.
+        {{1, 0, 0, 2, 0x83, 0x00}, 6, SEMY_BAD_SYNTAX},                                           // Overlong identifier tag.
+        {{1, 0, 0, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x02}, 13, SEMY_BAD_SYNTAX}, // Integer beyond 64 bits.
+        {{0x80, 0x80, 0x80, 0x80, 0x08, 0, 0, 0}, 8, SEMY_LIMITS_EXCEEDED},                       // Major of 2^31.
+        {{1, 0, 0, 2, 0x00}, 5, SEMY_BAD_SYNTAX},                                                 // Empty identifier.
+        {{1, 0, 0, 2, 0x04, '1', '2'}, 7, SEMY_BAD_SYNTAX},                                       // Alphanumeric without a non-digit.
+        {{1, 0, 0, 2, 0x04, 'a', '.'}, 7, SEMY_BAD_SYNTAX},                                       // Invalid character.
+        {{1, 0, 0, 2, 0x81, 0x80, 0x80, 0x80, 0x10}, 9, SEMY_LIMITS_EXCEEDED},                    // Numeric identifier of 2^31.
+        {{1, 0, 0, 1, 0x00}, 5, SEMY_BAD_SYNTAX},                                                 // No build identifiers.
+        {{1, 0, 0, 1, 0x01, 0x02, '0'}, 7, SEMY_BAD_SYNTAX},                                      // Build identifier longer than the data.
+        {{1, 0, 0, 1, 0x01, 0x01, '+'}, 7, SEMY_BAD_SYNTAX},                                      // Invalid build character.
+    };
+
+    for (size_t i = 0; i < COUNT_OF(cases); i++)
+    {
+        semy_t semver;
+        size_t length = cases[i].length;
+        ASSERT_EQ((int)cases[i].status_code, semy_decode(&semver, sizeof(semver), cases[i].data, &length), "case %zu", i);
+    }
+}
+
+TEST(encode, illegal_arguments)
+{
+    semy_t semver;
+    uint8_t data[16] = {1, 2, 3, 0};
+    size_t size = sizeof(data);
+    ASSERT_EQ((int)SEMY_NO_ERROR, semy_parse(&semver, sizeof(semver), "1.2.3"));
+    ASSERT_EQ((int)SEMY_INVALID_OPERATION, semy_encode(NULL, data, &size));
+    ASSERT_EQ((int)SEMY_INVALID_OPERATION, semy_encode(&semver, data, NULL));
+    ASSERT_EQ((int)SEMY_INVALID_OPERATION, semy_decode(NULL, sizeof(semver), data, &size));
+    ASSERT_EQ((int)SEMY_INVALID_OPERATION, semy_decode(&semver, sizeof(semver), NULL, &size));
+    ASSERT_EQ((int)SEMY_INVALID_OPERATION, semy_decode(&semver, sizeof(semver), data, NULL));
+    ASSERT_EQ((int)SEMY_INVALID_OPERATION, semy_decode(&semver, sizeof(semver) - 1, data, &size));
+}
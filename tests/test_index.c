@@ -0,0 +1,318 @@
+// SPDX-License-Identifier: MIT
+/*
+ * Semy - a Semantic Versioning 2.0.0 processor.
+ * See https://semver.org/.
+ *
+ * Copyright (c) 2025-2026 Henry G. Stratmann III
+ * Copyright (c) 2025-2026 Semy Contributors
+ *
+ * This file is part of Semy, distributed under the MIT License.
+ * For full terms see the included LICENSE file.
+ */
+
+#include "semy.h"
+#include "test_utils.h"
+#include <stdlib.h>
+#include <string.h>
+
+static const char *versions[] = {
+    "2.0.0",
+    "1.0.0-alpha.beta",
+    "1.0.0+build.2",
+    "1.0.0-beta.11",
+    "1.0.0-alpha",
+    "1.0.0-rc.1",
+    "1.0.0-beta",
+    "1.0.0+build.1",
+    "1.0.0-alpha.1",
+    "1.0.0-beta.2",
+    "1.0.0-alphabet",
+    "1.0.0-0",
+    "1.0.0-a-b",
+    "0.9.10",
+    "0.10.9",
+    "2147483647.2147483647.2147483647",
+    "1.0.0",
+};
+
+static const char *sorted[] = {
+    "0.9.10",
+    "0.10.9",
+    "1.0.0-0",
+    "1.0.0-a-b",
+    "1.0.0-alpha",
+    "1.0.0-alpha.1",
+    "1.0.0-alpha.beta",
+    "1.0.0-alphabet",
+    "1.0.0-beta",
+    "1.0.0-beta.2",
+    "1.0.0-beta.11",
+    "1.0.0-rc.1",
+    "1.0.0+build.2",
+    "1.0.0+build.1",
+    "1.0.0",
+    "2.0.0",
+    "2147483647.2147483647.2147483647",
+};
+
+static uint64_t *build(const char *const *strings, const size_t *lengths, size_t count, size_t *size)
+{
+    ASSERT_EQ((int)SEMY_NO_ERROR, semy_index_build(strings, lengths, count, NULL, size));
+    uint64_t *buffer = calloc(1, *size);
+    ASSERT_NONNULL(buffer);
+    ASSERT_EQ((int)SEMY_NO_ERROR, semy_index_build(strings, lengths, count, buffer, size));
+    return buffer;
+}
+
+static void search(const semy_index_t *index, const char *version, size_t *lower, size_t *upper)
+{
+    semy_t semver = {0};
+    ASSERT_EQ((int)SEMY_NO_ERROR, semy_parse(&semver, sizeof(semver), version));
+    ASSERT_EQ((int)SEMY_NO_ERROR, semy_index_search(index, &semver, lower, upper));
+}
+
+TEST(index, sorted)
+{
+    size_t size = 0;
+    uint64_t *buffer = build(versions, NULL, COUNT_OF(versions), &size);
+
+    semy_index_t index;
+    ASSERT_EQ((int)SEMY_NO_ERROR, semy_index_open(&index, buffer, size));
+    ASSERT_EQ(COUNT_OF(sorted), semy_index_count(&index));
+
+    for (size_t i = 0; i < COUNT_OF(sorted); i++)
+    {
+        ASSERT_STR_EQ(sorted[i], semy_index_get(&index, i));
+    }
+    ASSERT_NULL(semy_index_get(&index, COUNT_OF(sorted)));
+
+    free(buffer);
+}
+
+TEST(index, search)
+{
+    size_t size = 0;
+    uint64_t *buffer = build(versions, NULL, COUNT_OF(versions), &size);
+    size_t lower = 0;
+    size_t upper = 0;
+
+    semy_index_t index;
+    ASSERT_EQ((int)SEMY_NO_ERROR, semy_index_open(&index, buffer, size));
+
+    // Build metadata is ignored for precedence.
+    search(&index, "1.0.0+build.3", &lower, &upper);
+    ASSERT_EQ(12, lower);
+    ASSERT_EQ(15, upper);
+
+    search(&index, "1.0.0-beta.2", &lower, &upper);
+    ASSERT_EQ(9, lower);
+    ASSERT_EQ(10, upper);
+
+    // Versions absent from the index yield an empty range at their insertion point.
+    search(&index, "1.0.0-beta.3", &lower, &upper);
+    ASSERT_EQ(10, lower);
+    ASSERT_EQ(10, upper);
+
+    search(&index, "0.0.0", &lower, &upper);
+    ASSERT_EQ(0, lower);
+    ASSERT_EQ(0, upper);
+
+    search(&index, "3.0.0", &lower, &upper);
+    ASSERT_EQ(COUNT_OF(sorted) - 1, lower);
+    ASSERT_EQ(COUNT_OF(sorted) - 1, upper);
+
+    // Compact layouts are searched like the full layout.
+    semy_compact32_t compact = {0};
+    ASSERT_EQ((int)SEMY_NO_ERROR, semy_parse((semy_t *)&compact, sizeof(compact), "1.0.0-beta.2+x"));
+    ASSERT_EQ((int)SEMY_NO_ERROR, semy_index_search(&index, (const semy_t *)&compact, &lower, &upper));
+    ASSERT_EQ(9, lower);
+    ASSERT_EQ(10, upper);
+
+    // So are extended layouts, unless they're beyond the limits of the full layout.
+    char *extended = calloc(1, SEMY_EXTENDED_SIZE(256));
+    ASSERT_NONNULL(extended);
+    ASSERT_EQ((int)SEMY_NO_ERROR, semy_parse((semy_t *)extended, SEMY_EXTENDED_SIZE(256), "1.0.0-beta.2"));
+    ASSERT_EQ((int)SEMY_NO_ERROR, semy_index_search(&index, (const semy_t *)extended, &lower, &upper));
+    ASSERT_EQ(9, lower);
+    ASSERT_EQ(10, upper);
+
+    char long_version[256] = {0};
+    memset(long_version, 'a', sizeof(long_version) - 1);
+    memcpy(long_version, "1.0.0-", 6);
+    ASSERT_EQ((int)SEMY_NO_ERROR, semy_parse((semy_t *)extended, SEMY_EXTENDED_SIZE(256), long_version));
+    ASSERT_EQ((int)SEMY_LIMITS_EXCEEDED, semy_index_search(&index, (const semy_t *)extended, &lower, &upper));
+
+    free(extended);
+    free(buffer);
+}
+
+// Verify indexed order agrees with semy_compare() for every pair of versions.
+TEST(index, agrees_with_compare)
+{
+    for (size_t i = 0; i < COUNT_OF(versions); i++)
+    {
+        for (size_t j = 0; j < COUNT_OF(versions); j++)
+        {
+            const char *pair[] = {versions[i], versions[j]};
+            semy_t a = {0};
+            semy_t b = {0};
+            int32_t result = 0;
+            ASSERT_EQ((int)SEMY_NO_ERROR, semy_parse(&a, sizeof(a), pair[0]));
+            ASSERT_EQ((int)SEMY_NO_ERROR, semy_parse(&b, sizeof(b), pair[1]));
+            ASSERT_EQ((int)SEMY_NO_ERROR, semy_compare(&a, &b, &result));
+
+            size_t size = 0;
+            uint64_t *buffer = build(pair, NULL, 2, &size);
+            semy_index_t index;
+            ASSERT_EQ((int)SEMY_NO_ERROR, semy_index_open(&index, buffer, size));
+
+            size_t lower = 0;
+            size_t upper = 0;
+            ASSERT_EQ((int)SEMY_NO_ERROR, semy_index_search(&index, &a, &lower, &upper));
+            ASSERT_STR_EQ((result > 0) ? pair[1] : pair[0], semy_index_get(&index, 0));
+            ASSERT_EQ((result == 0) ? 2 : 1, upper - lower);
+            free(buffer);
+        }
+    }
+}
+
+TEST(index, lengths)
+{
+    const char *strings[] = {"1.0.0-rc.1junk", "0.1.0"};
+    const size_t lengths[] = {10, 5};
+    size_t size = 0;
+    uint64_t *buffer = build(strings, lengths, 2, &size);
+
+    semy_index_t index;
+    ASSERT_EQ((int)SEMY_NO_ERROR, semy_index_open(&index, buffer, size));
+    ASSERT_STR_EQ("0.1.0", semy_index_get(&index, 0));
+    ASSERT_STR_EQ("1.0.0-rc.1", semy_index_get(&index, 1));
+    free(buffer);
+}
+
+TEST(index, empty)
+{
+    size_t size = 0;
+    uint64_t *buffer = build(NULL, NULL, 0, &size);
+
+    semy_index_t index;
+    ASSERT_EQ((int)SEMY_NO_ERROR, semy_index_open(&index, buffer, size));
+    ASSERT_EQ(0, semy_index_count(&index));
+    ASSERT_NULL(semy_index_get(&index, 0));
+    free(buffer);
+}
+
+TEST(index, build_invalid_versions)
+{
+    const char *bad_syntax[] = {"1.0.0", "1.0"};
+    const char *too_long[] = {"1.0.0-aaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaa"};
+    const char *null_version[] = {"1.0.0", NULL};
+    const char *embedded_null[] = {"1.0.0\0"};
+    const size_t lengths[] = {6};
+    const size_t long_lengths[] = {201};
+    size_t size = 0;
+
+    ASSERT_EQ((int)SEMY_BAD_SYNTAX, semy_index_build(bad_syntax, NULL, 2, NULL, &size));
+    ASSERT_EQ((int)SEMY_LIMITS_EXCEEDED, semy_index_build(too_long, NULL, 1, NULL, &size));
+    ASSERT_EQ((int)SEMY_LIMITS_EXCEEDED, semy_index_build(too_long, long_lengths, 1, NULL, &size));
+    ASSERT_EQ((int)SEMY_INVALID_OPERATION, semy_index_build(null_version, NULL, 2, NULL, &size));
+    ASSERT_EQ((int)SEMY_BAD_SYNTAX, semy_index_build(embedded_null, lengths, 1, NULL, &size));
+}
+
+TEST(index, build_illegal_arguments)
+{
+    uint64_t buffer[64] = {0};
+    size_t size = 0;
+
+    ASSERT_EQ((int)SEMY_INVALID_OPERATION, semy_index_build(NULL, NULL, 1, NULL, &size));
+    ASSERT_EQ((int)SEMY_INVALID_OPERATION, semy_index_build(versions, NULL, 1, NULL, NULL));
+    ASSERT_EQ((int)SEMY_LIMITS_EXCEEDED, semy_index_build(versions, NULL, (size_t)UINT32_MAX + 1, NULL, &size));
+
+    // The buffer must be large enough.
+    size = 8;
+    ASSERT_EQ((int)SEMY_INVALID_OPERATION, semy_index_build(versions, NULL, 1, buffer, &size));
+    ASSERT_EQ(32 + 32 + 16 + 6, size);
+
+    // The buffer must be aligned.
+    size = sizeof(buffer) - 1;
+    ASSERT_EQ((int)SEMY_INVALID_OPERATION, semy_index_build(versions, NULL, 1, (char *)buffer + 1, &size));
+}
+
+TEST(index, open_illegal_arguments)
+{
+    size_t size = 0;
+    uint64_t *buffer = build(versions, NULL, 2, &size);
+    uint8_t *bytes = (uint8_t *)buffer;
+    semy_index_t index;
+
+    ASSERT_EQ((int)SEMY_INVALID_OPERATION, semy_index_open(NULL, buffer, size));
+    ASSERT_EQ((int)SEMY_INVALID_OPERATION, semy_index_open(&index, NULL, size));
+    ASSERT_EQ((int)SEMY_BAD_SYNTAX, semy_index_open(&index, buffer, 47));
+    ASSERT_EQ((int)SEMY_BAD_SYNTAX, semy_index_open(&index, buffer, size - 1));
+
+    // Corrupt each field of the header in turn.
+    const size_t fields[] = {0, 8, 9, 16, 24};
+    for (size_t i = 0; i < COUNT_OF(fields); i++)
+    {
+        bytes[fields[i]] ^= 0x40;
+        ASSERT_EQ((int)SEMY_BAD_SYNTAX, semy_index_open(&index, buffer, size));
+        bytes[fields[i]] ^= 0x40;
+    }
+
+    // Corrupt the sentinel entry.
+    bytes[32 + 32] ^= 0x01;
+    ASSERT_EQ((int)SEMY_BAD_SYNTAX, semy_index_open(&index, buffer, size));
+    bytes[32 + 32] ^= 0x01;
+
+    ASSERT_EQ((int)SEMY_NO_ERROR, semy_index_open(&index, buffer, size));
+    free(buffer);
+}
+
+TEST(index, corrupt_entries)
+{
+    size_t size = 0;
+    uint64_t *buffer = build(versions, NULL, 2, &size);
+    uint8_t *bytes = (uint8_t *)buffer;
+    semy_index_t index;
+    semy_t semver = {0};
+    size_t lower = 0;
+    size_t upper = 0;
+
+    ASSERT_EQ((int)SEMY_NO_ERROR, semy_parse(&semver, sizeof(semver), "1.0.0"));
+    ASSERT_EQ((int)SEMY_NO_ERROR, semy_index_open(&index, buffer, size));
+
+    // Point the first entry past the end of each table.
+    bytes[32] = 0xFF;
+    bytes[32 + 8] = 0xFF;
+    ASSERT_NULL(semy_index_get(&index, 0));
+    ASSERT_EQ((int)SEMY_BAD_SYNTAX, semy_index_search(&index, &semver, &lower, &upper));
+    ASSERT_NONNULL(semy_index_get(&index, 1));
+
+    // A string that isn't null terminated within its span.
+    bytes[32 + 8] = 0;
+    bytes[32 + 16 + 8] = 5;
+    ASSERT_NULL(semy_index_get(&index, 0));
+
+    free(buffer);
+}
+
+TEST(index, query_illegal_arguments)
+{
+    size_t size = 0;
+    uint64_t *buffer = build(versions, NULL, 1, &size);
+    semy_index_t index;
+    semy_t semver = {0};
+    size_t position = 0;
+
+    ASSERT_EQ((int)SEMY_NO_ERROR, semy_parse(&semver, sizeof(semver), "1.0.0"));
+    ASSERT_EQ((int)SEMY_NO_ERROR, semy_index_open(&index, buffer, size));
+
+    ASSERT_EQ(0, semy_index_count(NULL));
+    ASSERT_NULL(semy_index_get(NULL, 0));
+    ASSERT_EQ((int)SEMY_INVALID_OPERATION, semy_index_search(NULL, &semver, &position, &position));
+    ASSERT_EQ((int)SEMY_INVALID_OPERATION, semy_index_search(&index, NULL, &position, &position));
+    ASSERT_EQ((int)SEMY_INVALID_OPERATION, semy_index_search(&index, &semver, NULL, &position));
+    ASSERT_EQ((int)SEMY_INVALID_OPERATION, semy_index_search(&index, &semver, &position, NULL));
+
+    free(buffer);
+}
@@ -13,6 +13,7 @@
 #include "semy.h"
 #include "test_utils.h"
 #include <stdio.h>
+#include <stdlib.h>
 #include <string.h>
 
 static const struct TestCase {
@@ -161,38 +162,221 @@ TEST(semver, parse, .iterations=COUNT_OF(test_cases))
     }
 
     char output[1024] = {0};
-    sprintf(output, "%d.%d.%d", semy_get_major(&semver), semy_get_minor(&semver), semy_get_patch(&semver));
+    format_version(&semver, output);
+    ASSERT_STR_EQ(input, output, "incorrect version data extracted: %s", input);
+}
+
+// Verify the compact layout parses every version whose identifiers fit and reports those that don't.
+TEST(semver, parse_compact, .iterations=COUNT_OF(test_cases))
+{
+    const struct TestCase *test_case = &test_cases[TEST_ITERATION];
+    const char *input = test_case->string;
 
-    int32_t count = semy_get_pre_release_count(&semver);
-    if (count > 0)
+    semy_compact64_t semver = {0};
+    const semy_error_t err = semy_parse((semy_t *)&semver, sizeof(semver), input);
+
+    // Each identifier is stored with a null byte in place of the separator preceding it.
+    const size_t identifiers_length = strlen(input) - strcspn(input, "-+");
+    if (test_case->status_code != SEMY_NO_ERROR)
     {
-        strcat(output, "-");
-        for (int32_t i = 0; i < count; i++)
-        {
-            if (i > 0)
-            {
-                strcat(output, ".");
-            }
-            strcat(output, semy_get_pre_release(&semver, i));
-        }
+        ASSERT_EQ((int)err, test_case->status_code, "unexpected error code parsing: %s", input);
+        return;
+    }
+    else if (identifiers_length > 46)
+    {
+        ASSERT_EQ((int)err, SEMY_LIMITS_EXCEEDED, "expected the identifiers not to fit: %s", input);
+        return;
+    }
+    ASSERT_EQ((int)err, SEMY_NO_ERROR, "unexpected error code parsing: %s", input);
+
+    char output[1024] = {0};
+    format_version((const semy_t *)&semver, output);
+    ASSERT_STR_EQ(input, output, "incorrect version data extracted: %s", input);
+}
+
+TEST(semver, parse_compact32)
+{
+    semy_compact32_t semver = {0};
+    char output[1024] = {0};
+
+    // Exactly 14 bytes of identifiers fit.
+    ASSERT_EQ((int)SEMY_NO_ERROR, semy_parse((semy_t *)&semver, sizeof(semver), "1.2.3-rc.12+build.5"));
+    format_version((const semy_t *)&semver, output);
+    ASSERT_STR_EQ("1.2.3-rc.12+build.5", output);
+    ASSERT_EQ(2, semy_get_pre_release_count((const semy_t *)&semver));
+    ASSERT_STR_EQ("build", semy_get_build((const semy_t *)&semver, 0));
+    ASSERT_NULL(semy_get_build((const semy_t *)&semver, 2));
+    ASSERT_NULL(semy_get_pre_release((const semy_t *)&semver, 2));
+
+    ASSERT_EQ((int)SEMY_LIMITS_EXCEEDED, semy_parse((semy_t *)&semver, sizeof(semver), "1.2.3-rc.12+build.56"));
+    ASSERT_EQ((int)SEMY_BAD_SYNTAX, semy_parse((semy_t *)&semver, sizeof(semver), "1.2"));
+    ASSERT_EQ((int)SEMY_INVALID_OPERATION, semy_parse((semy_t *)&semver, sizeof(semver) - 1, "1.0.0"));
+}
+
+// Verify the extended layout parses every version exactly as 'semy_t' does.
+TEST(semver, parse_extended, .iterations=COUNT_OF(test_cases))
+{
+    const struct TestCase *test_case = &test_cases[TEST_ITERATION];
+    const char *input = test_case->string;
+
+    const size_t size = SEMY_EXTENDED_SIZE(strlen(input));
+    semy_t *semver = malloc(size);
+    ASSERT_NONNULL(semver);
+
+    const semy_error_t err = semy_parse(semver, size, input);
+    ASSERT_EQ((int)err, test_case->status_code, "unexpected error code parsing: %s", input);
+    if (err == SEMY_NO_ERROR)
+    {
+        char output[1024] = {0};
+        format_version(semver, output);
+        ASSERT_STR_EQ(input, output, "incorrect version data extracted: %s", input);
     }
+    free(semver);
+}
+
+TEST(semver, parse_extended_limits)
+{
+    // Versions past the limits of 'semy_t' fit an extended layout.
+    char input[1024] = {0};
+    memset(input, 'a', sizeof(input) - 1);
+    memcpy(input, "1.0.0-", 6);
 
-    count = semy_get_build_count(&semver);
-    if (count > 0)
+    semy_t *semver = malloc(SEMY_EXTENDED_SIZE(sizeof(input)));
+    ASSERT_NONNULL(semver);
+    ASSERT_EQ((int)SEMY_NO_ERROR, semy_parse(semver, SEMY_EXTENDED_SIZE(sizeof(input)), input));
+    ASSERT_EQ(1, semy_get_pre_release_count(semver));
+    ASSERT_EQ(sizeof(input) - 7, strlen(semy_get_pre_release(semver, 0)));
+
+    // They compare with versions in every other layout.
+    semy_t release;
+    int32_t result = 0;
+    ASSERT_EQ((int)SEMY_NO_ERROR, semy_parse(&release, sizeof(release), "1.0.0"));
+    ASSERT_EQ((int)SEMY_NO_ERROR, semy_compare(semver, &release, &result));
+    ASSERT_EQ(-1, result);
+
+    // But not a layout too small to hold their identifiers.
+    ASSERT_EQ((int)SEMY_LIMITS_EXCEEDED, semy_parse(semver, SEMY_EXTENDED_SIZE(0), input));
+    memcpy(input, "1.0.0+", 6);
+    ASSERT_EQ((int)SEMY_LIMITS_EXCEEDED, semy_parse(semver, SEMY_EXTENDED_SIZE(0), input));
+
+    // Up to 255 pre-release and 255 build identifiers are stored.
+    for (size_t i = 7; i < sizeof(input) - 1; i += 2)
     {
-        strcat(output, "+");
-        for (int32_t i = 0; i < count; i++)
-        {
-            if (i > 0)
-            {
-                strcat(output, ".");
-            }
-            strcat(output, semy_get_build(&semver, i));
-        }
+        input[i] = '.';
     }
+    input[5] = '-';
+    input[(255 * 2) + 5] = '+';
+    ASSERT_EQ((int)SEMY_NO_ERROR, semy_parse(semver, SEMY_EXTENDED_SIZE(sizeof(input)), input));
+    ASSERT_EQ(255, semy_get_pre_release_count(semver));
+    ASSERT_EQ(254, semy_get_build_count(semver));
+    ASSERT_STR_EQ("a", semy_get_build(semver, 253));
+
+    input[(255 * 2) + 5] = '.';
+    ASSERT_EQ((int)SEMY_LIMITS_EXCEEDED, semy_parse(semver, SEMY_EXTENDED_SIZE(sizeof(input)), input));
+    input[5] = '+';
+    ASSERT_EQ((int)SEMY_LIMITS_EXCEEDED, semy_parse(semver, SEMY_EXTENDED_SIZE(sizeof(input)), input));
+
+    // Sizes between the compact layouts and 'semy_t' select no layout.
+    ASSERT_EQ((int)SEMY_INVALID_OPERATION, semy_parse(semver, sizeof(semy_t) - 4, "1.0.0"));
+    free(semver);
+}
 
+static const struct DiagnoseCase {
+    const char *string;
+    semy_error_t status_code;
+    size_t offset;
+    semy_production_t production;
+} diagnose_cases[] = {
+    {"1.2.3", SEMY_NO_ERROR, 5, SEMY_PRODUCTION_NONE},
+    {"1.0.0-rc.1+build.5", SEMY_NO_ERROR, 18, SEMY_PRODUCTION_NONE},
+    {"", SEMY_BAD_SYNTAX, 0, SEMY_PRODUCTION_VERSION_CORE},
+    {"v1.0.0", SEMY_BAD_SYNTAX, 0, SEMY_PRODUCTION_VERSION_CORE},
+    {"1", SEMY_BAD_SYNTAX, 1, SEMY_PRODUCTION_VERSION_CORE},
+    {"1.2", SEMY_BAD_SYNTAX, 3, SEMY_PRODUCTION_VERSION_CORE},
+    {"1..3", SEMY_BAD_SYNTAX, 2, SEMY_PRODUCTION_VERSION_CORE},
+    {"01.2.3", SEMY_BAD_SYNTAX, 1, SEMY_PRODUCTION_VERSION_CORE},
+    {"1.2.3 ", SEMY_BAD_SYNTAX, 5, SEMY_PRODUCTION_VERSION_CORE},
+    {"1.2.2147483648", SEMY_LIMITS_EXCEEDED, 4, SEMY_PRODUCTION_VERSION_CORE},
+    {"1.0.0-", SEMY_BAD_SYNTAX, 6, SEMY_PRODUCTION_PRE_RELEASE},
+    {"1.0.0-rc.", SEMY_BAD_SYNTAX, 9, SEMY_PRODUCTION_PRE_RELEASE},
+    {"1.0.0-rc..1", SEMY_BAD_SYNTAX, 9, SEMY_PRODUCTION_PRE_RELEASE},
+    {"1.0.0-rc_1", SEMY_BAD_SYNTAX, 8, SEMY_PRODUCTION_PRE_RELEASE},
+    {"1.0.0-01", SEMY_BAD_SYNTAX, 7, SEMY_PRODUCTION_PRE_RELEASE},
+    {"1.0.0-rc.2147483648", SEMY_LIMITS_EXCEEDED, 9, SEMY_PRODUCTION_PRE_RELEASE},
+    {"1.0.0+", SEMY_BAD_SYNTAX, 6, SEMY_PRODUCTION_BUILD},
+    {"1.0.0-rc+build.", SEMY_BAD_SYNTAX, 15, SEMY_PRODUCTION_BUILD},
+    {"1.0.0+build+1", SEMY_BAD_SYNTAX, 11, SEMY_PRODUCTION_BUILD},
+};
 
-    ASSERT_STR_EQ(input, output, "incorrect version data extracted: %s", input);
+// Verify errors are located identically in every layout.
+TEST(semver, parse_diagnose, .iterations=COUNT_OF(diagnose_cases))
+{
+    const struct DiagnoseCase *test_case = &diagnose_cases[TEST_ITERATION];
+    const char *input = test_case->string;
+
+    const size_t sizes[] = {sizeof(semy_t), sizeof(semy_compact64_t), SEMY_EXTENDED_SIZE(strlen(input))};
+    semy_t *semver = malloc(sizes[2]);
+    ASSERT_NONNULL(semver);
+
+    for (size_t i = 0; i < COUNT_OF(sizes); i++)
+    {
+        size_t offset = 99;
+        semy_production_t production = SEMY_PRODUCTION_FORCE_32_BIT;
+        ASSERT_EQ((int)test_case->status_code, semy_parse_diagnose(semver, sizes[i], input, &offset, &production), "unexpected error code parsing: %s", input);
+        ASSERT_EQ(test_case->offset, offset, "unexpected offset parsing: %s", input);
+        ASSERT_EQ((int)test_case->production, (int)production, "unexpected production parsing: %s", input);
+    }
+    free(semver);
+}
+
+TEST(semver, parse_diagnose_limits)
+{
+    char input[1024] = {0};
+    size_t offset = 0;
+    semy_production_t production = SEMY_PRODUCTION_FORCE_32_BIT;
+    semy_compact32_t compact;
+    semy_t semver;
+
+    // Valid versions that don't fit the layout aren't attributed to a production.
+    ASSERT_EQ((int)SEMY_LIMITS_EXCEEDED, semy_parse_diagnose((semy_t *)&compact, sizeof(compact), "1.0.0-alpha.beta.gamma", &offset, &production));
+    ASSERT_EQ(22, offset);
+    ASSERT_EQ((int)SEMY_PRODUCTION_NONE, (int)production);
+
+    // Nor are versions longer than 'semy_t' accepts.
+    memset(input, 'a', sizeof(input) - 1);
+    memcpy(input, "1.0.0-", 6);
+    input[255] = '\0';
+    ASSERT_EQ((int)SEMY_LIMITS_EXCEEDED, semy_parse_diagnose(&semver, sizeof(semver), input, &offset, &production));
+    ASSERT_EQ(200, offset);
+    ASSERT_EQ((int)SEMY_PRODUCTION_NONE, (int)production);
+
+    // Too many identifiers are reported at the first one past the limit.
+    strcpy(input, "1.0.0-0.1.2.3.4.5.6.7.8.9.0.1.2.3.4.5.6.7.8.9.0.1.2.3.4.5");
+    ASSERT_EQ((int)SEMY_LIMITS_EXCEEDED, semy_parse_diagnose(&semver, sizeof(semver), input, &offset, &production));
+    ASSERT_EQ(56, offset);
+    ASSERT_EQ((int)SEMY_PRODUCTION_PRE_RELEASE, (int)production);
+
+    input[5] = '+';
+    ASSERT_EQ((int)SEMY_LIMITS_EXCEEDED, semy_parse_diagnose(&semver, sizeof(semver), input, &offset, &production));
+    ASSERT_EQ(56, offset);
+    ASSERT_EQ((int)SEMY_PRODUCTION_BUILD, (int)production);
+
+    // So are identifiers that don't fit an extended layout.
+    semy_t *extended = malloc(SEMY_EXTENDED_SIZE(0));
+    ASSERT_NONNULL(extended);
+    memset(input, 'a', sizeof(input) - 1);
+    memcpy(input, "1.0.0-rc.", 9);
+    ASSERT_EQ((int)SEMY_LIMITS_EXCEEDED, semy_parse_diagnose(extended, SEMY_EXTENDED_SIZE(0), input, &offset, &production));
+    ASSERT_EQ(9, offset);
+    ASSERT_EQ((int)SEMY_PRODUCTION_PRE_RELEASE, (int)production);
+    free(extended);
+
+    // Invalid arguments aren't parsed at all.
+    ASSERT_EQ((int)SEMY_INVALID_OPERATION, semy_parse_diagnose(&semver, sizeof(semver), NULL, &offset, &production));
+    ASSERT_EQ(0, offset);
+    ASSERT_EQ((int)SEMY_PRODUCTION_NONE, (int)production);
+    ASSERT_EQ((int)SEMY_INVALID_OPERATION, semy_parse_diagnose(&semver, sizeof(semver), "1.0.0", NULL, &production));
+    ASSERT_EQ((int)SEMY_INVALID_OPERATION, semy_parse_diagnose(&semver, sizeof(semver), "1.0.0", &offset, NULL));
 }
 
 TEST(semver, init_exceed_string_length_limit)
@@ -0,0 +1,470 @@
+// SPDX-License-Identifier: MIT
+/*
+ * Semy - a Semantic Versioning 2.0.0 processor.
+ * See https://semver.org/.
+ *
+ * Copyright (c) 2025-2026 Henry G. Stratmann III
+ * Copyright (c) 2025-2026 Semy Contributors
+ *
+ * This file is part of Semy, distributed under the MIT License.
+ * For full terms see the included LICENSE file.
+ */
+
+#include "semy.h"
+#include "test_utils.h"
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <string.h>
+
+#define READER_THREADS 4
+#define PUBLISHED_BATCHES 200
+
+static bool contains(semy_registry_reader_t *reader, const char *name, const char *version)
+{
+    semy_t semver;
+    int32_t found = -1;
+    ASSERT_EQ((int)SEMY_NO_ERROR, semy_parse(&semver, sizeof(semver), version));
+    ASSERT_EQ((int)SEMY_NO_ERROR, semy_registry_contains(reader, name, &semver, &found));
+    return found == 1;
+}
+
+// Formats the highest version of 'name' in [minimum, limit) or "none" if there isn't one.
+static void highest(semy_registry_reader_t *reader, const char *name, const char *minimum, const char *limit, char *output)
+{
+    semy_t bounds[2];
+    semy_t semver;
+    int32_t found = -1;
+
+    if (minimum != NULL)
+    {
+        ASSERT_EQ((int)SEMY_NO_ERROR, semy_parse(&bounds[0], sizeof(bounds[0]), minimum));
+    }
+
+    if (limit != NULL)
+    {
+        ASSERT_EQ((int)SEMY_NO_ERROR, semy_parse(&bounds[1], sizeof(bounds[1]), limit));
+    }
+
+    ASSERT_EQ((int)SEMY_NO_ERROR, semy_registry_highest(reader, name, (minimum != NULL) ? &bounds[0] : NULL,
+                                                        (limit != NULL) ? &bounds[1] : NULL, &semver, sizeof(semver), &found));
+    if (found == 1)
+    {
+        format_version(&semver, output);
+    }
+    else
+    {
+        ASSERT_EQ(0, found);
+        strcpy(output, "none");
+    }
+}
+
+TEST(registry, contains_and_highest)
+{
+    static const char *const releases[][2] = {
+        {"left-pad", "1.3.0"},
+        {"semy", "1.0.0-rc.1"},
+        {"left-pad", "1.10.0"},
+        {"semy", "0.9.0"},
+        {"left-pad", "2.0.0-beta.2"},
+        {"semy", "1.0.0"},
+        {"left-pad", "1.2.9+build.7"},
+    };
+
+    semy_registry_t registry;
+    semy_registry_reader_t reader;
+    char version[256];
+
+    ASSERT_EQ((int)SEMY_NO_ERROR, semy_registry_init(&registry));
+    ASSERT_EQ((int)SEMY_NO_ERROR, semy_registry_attach(&registry, &reader));
+
+    // The registry is empty until the staged versions are published.
+    for (size_t i = 0; i < COUNT_OF(releases); i++)
+    {
+        ASSERT_EQ((int)SEMY_NO_ERROR, semy_registry_add(&registry, releases[i][0], releases[i][1]));
+    }
+    ASSERT_FALSE(contains(&reader, "semy", "1.0.0"));
+    highest(&reader, "semy", NULL, NULL, version);
+    ASSERT_STR_EQ("none", version);
+
+    ASSERT_EQ((int)SEMY_NO_ERROR, semy_registry_publish(&registry));
+    for (size_t i = 0; i < COUNT_OF(releases); i++)
+    {
+        ASSERT_TRUE(contains(&reader, releases[i][0], releases[i][1]));
+    }
+
+    // Versions are matched by precedence, so build metadata is ignored.
+    ASSERT_TRUE(contains(&reader, "left-pad", "1.2.9"));
+    ASSERT_FALSE(contains(&reader, "left-pad", "1.2.8"));
+    ASSERT_FALSE(contains(&reader, "right-pad", "1.3.0"));
+
+    highest(&reader, "left-pad", NULL, NULL, version);
+    ASSERT_STR_EQ("2.0.0-beta.2", version);
+    highest(&reader, "left-pad", "1.0.0", "2.0.0-0", version);
+    ASSERT_STR_EQ("1.10.0", version);
+    highest(&reader, "left-pad", NULL, "1.3.0", version);
+    ASSERT_STR_EQ("1.2.9+build.7", version);
+    highest(&reader, "left-pad", "1.3.0", "1.3.1", version);
+    ASSERT_STR_EQ("1.3.0", version);
+    highest(&reader, "left-pad", "1.4.0", "1.10.0", version);
+    ASSERT_STR_EQ("none", version);
+    highest(&reader, "left-pad", "3.0.0", NULL, version);
+    ASSERT_STR_EQ("none", version);
+    highest(&reader, "semy", "0.1.0", "1.0.0", version);
+    ASSERT_STR_EQ("1.0.0-rc.1", version);
+    highest(&reader, "right-pad", NULL, NULL, version);
+    ASSERT_STR_EQ("none", version);
+
+    semy_registry_detach(&reader);
+    semy_registry_free(&registry);
+}
+
+TEST(registry, batches)
+{
+    semy_registry_t registry;
+    semy_registry_reader_t reader;
+    char version[256];
+
+    ASSERT_EQ((int)SEMY_NO_ERROR, semy_registry_init(&registry));
+    ASSERT_EQ((int)SEMY_NO_ERROR, semy_registry_attach(&registry, &reader));
+
+    // Publishing nothing is harmless.
+    ASSERT_EQ((int)SEMY_NO_ERROR, semy_registry_publish(&registry));
+
+    // Packages are added before, between, and after those already published.
+    static const char *const names[] = {"m", "c", "x", "a", "n", "z"};
+    for (size_t i = 0; i < COUNT_OF(names); i++)
+    {
+        char release[32];
+        sprintf(release, "1.%zu.0", i);
+        ASSERT_EQ((int)SEMY_NO_ERROR, semy_registry_add(&registry, names[i], release));
+        ASSERT_EQ((int)SEMY_NO_ERROR, semy_registry_add(&registry, "m", release));
+        ASSERT_EQ((int)SEMY_NO_ERROR, semy_registry_publish(&registry));
+    }
+
+    for (size_t i = 0; i < COUNT_OF(names); i++)
+    {
+        char release[32];
+        sprintf(release, "1.%zu.0", i);
+        ASSERT_TRUE(contains(&reader, names[i], release));
+        highest(&reader, names[i], NULL, NULL, version);
+        ASSERT_STR_EQ((i == 0) ? "1.5.0" : release, version);
+    }
+
+    // Identical versions are added once, but versions differing in build metadata are
+    // all kept in the order they were added.
+    ASSERT_EQ((int)SEMY_NO_ERROR, semy_registry_add(&registry, "b", "1.0.0+a"));
+    ASSERT_EQ((int)SEMY_NO_ERROR, semy_registry_add(&registry, "b", "1.0.0+b"));
+    ASSERT_EQ((int)SEMY_NO_ERROR, semy_registry_add(&registry, "b", "1.0.0+a"));
+    ASSERT_EQ((int)SEMY_NO_ERROR, semy_registry_publish(&registry));
+    highest(&reader, "b", NULL, NULL, version);
+    ASSERT_STR_EQ("1.0.0+b", version);
+
+    ASSERT_EQ((int)SEMY_NO_ERROR, semy_registry_add(&registry, "b", "1.0.0+b"));
+    ASSERT_EQ((int)SEMY_NO_ERROR, semy_registry_add(&registry, "b", "0.1.0"));
+    ASSERT_EQ((int)SEMY_NO_ERROR, semy_registry_publish(&registry));
+    highest(&reader, "b", NULL, NULL, version);
+    ASSERT_STR_EQ("1.0.0+b", version);
+    ASSERT_TRUE(contains(&reader, "b", "0.1.0"));
+
+    semy_registry_detach(&reader);
+    semy_registry_free(&registry);
+}
+
+TEST(registry, many_versions)
+{
+    semy_registry_t registry;
+    semy_registry_reader_t reader;
+    char version[256];
+
+    ASSERT_EQ((int)SEMY_NO_ERROR, semy_registry_init(&registry));
+    ASSERT_EQ((int)SEMY_NO_ERROR, semy_registry_attach(&registry, &reader));
+
+    for (int i = 999; i >= 0; i--)
+    {
+        char release[32];
+        sprintf(release, "%d.%d.%d", i / 100, (i / 10) % 10, i % 10);
+        ASSERT_EQ((int)SEMY_NO_ERROR, semy_registry_add(&registry, "semy", release));
+    }
+    ASSERT_EQ((int)SEMY_NO_ERROR, semy_registry_publish(&registry));
+
+    ASSERT_TRUE(contains(&reader, "semy", "0.0.0"));
+    ASSERT_TRUE(contains(&reader, "semy", "4.5.6"));
+    ASSERT_FALSE(contains(&reader, "semy", "10.0.0"));
+    highest(&reader, "semy", NULL, NULL, version);
+    ASSERT_STR_EQ("9.9.9", version);
+    highest(&reader, "semy", "4.0.0", "4.5.0", version);
+    ASSERT_STR_EQ("4.4.9", version);
+
+    semy_registry_detach(&reader);
+    semy_registry_free(&registry);
+}
+
+TEST(registry, pinned_snapshots)
+{
+    semy_registry_t registry;
+    semy_registry_reader_t pinned;
+    semy_registry_reader_t reader;
+    char version[256];
+
+    ASSERT_EQ((int)SEMY_NO_ERROR, semy_registry_init(&registry));
+    ASSERT_EQ((int)SEMY_NO_ERROR, semy_registry_attach(&registry, &pinned));
+    ASSERT_EQ((int)SEMY_NO_ERROR, semy_registry_attach(&registry, &reader));
+
+    // A reader pinned to the empty registry keeps seeing it empty.
+    ASSERT_EQ((int)SEMY_NO_ERROR, semy_registry_pin(&pinned));
+    ASSERT_EQ((int)SEMY_INVALID_OPERATION, semy_registry_pin(&pinned));
+    ASSERT_EQ((int)SEMY_NO_ERROR, semy_registry_add(&registry, "semy", "1.0.0"));
+    ASSERT_EQ((int)SEMY_NO_ERROR, semy_registry_publish(&registry));
+    ASSERT_FALSE(contains(&pinned, "semy", "1.0.0"));
+    ASSERT_TRUE(contains(&reader, "semy", "1.0.0"));
+    ASSERT_EQ((int)SEMY_NO_ERROR, semy_registry_unpin(&pinned));
+    ASSERT_EQ((int)SEMY_INVALID_OPERATION, semy_registry_unpin(&pinned));
+    ASSERT_TRUE(contains(&pinned, "semy", "1.0.0"));
+
+    // The snapshots published while a reader is pinned are kept until it unpins.
+    ASSERT_EQ((int)SEMY_NO_ERROR, semy_registry_pin(&pinned));
+    for (int i = 1; i <= 3; i++)
+    {
+        char release[32];
+        sprintf(release, "1.%d.0", i);
+        ASSERT_EQ((int)SEMY_NO_ERROR, semy_registry_add(&registry, "semy", release));
+        ASSERT_EQ((int)SEMY_NO_ERROR, semy_registry_publish(&registry));
+        highest(&pinned, "semy", NULL, NULL, version);
+        ASSERT_STR_EQ("1.0.0", version);
+        highest(&reader, "semy", NULL, NULL, version);
+        ASSERT_STR_EQ(release, version);
+    }
+    ASSERT_EQ((int)SEMY_NO_ERROR, semy_registry_unpin(&pinned));
+    ASSERT_EQ((int)SEMY_NO_ERROR, semy_registry_publish(&registry));
+    highest(&pinned, "semy", NULL, NULL, version);
+    ASSERT_STR_EQ("1.3.0", version);
+
+    // A reader detached while pinned no longer holds its snapshot.
+    ASSERT_EQ((int)SEMY_NO_ERROR, semy_registry_pin(&pinned));
+    semy_registry_detach(&pinned);
+    ASSERT_EQ((int)SEMY_NO_ERROR, semy_registry_add(&registry, "semy", "1.4.0"));
+    ASSERT_EQ((int)SEMY_NO_ERROR, semy_registry_publish(&registry));
+
+    // Detached readers are reused.
+    ASSERT_EQ((int)SEMY_NO_ERROR, semy_registry_attach(&registry, &pinned));
+    highest(&pinned, "semy", NULL, NULL, version);
+    ASSERT_STR_EQ("1.4.0", version);
+
+    semy_registry_detach(&pinned);
+    semy_registry_detach(&reader);
+    semy_registry_free(&registry);
+}
+
+TEST(registry, layouts)
+{
+    semy_registry_t registry;
+    semy_registry_reader_t reader;
+    semy_compact32_t compact;
+    semy_t semver;
+    char extended[1024];
+    int32_t found = -1;
+
+    ASSERT_EQ((int)SEMY_NO_ERROR, semy_registry_init(&registry));
+    ASSERT_EQ((int)SEMY_NO_ERROR, semy_registry_attach(&registry, &reader));
+    ASSERT_EQ((int)SEMY_NO_ERROR, semy_registry_add(&registry, "semy", "1.0.0-alpha"));
+    ASSERT_EQ((int)SEMY_NO_ERROR, semy_registry_publish(&registry));
+
+    // The bounds and the result can be any layout.
+    ASSERT_EQ((int)SEMY_NO_ERROR, semy_parse((semy_t *)&compact, sizeof(compact), "1.0.0"));
+    ASSERT_EQ((int)SEMY_NO_ERROR, semy_registry_highest(&reader, "semy", NULL, (semy_t *)&compact, (semy_t *)&compact, sizeof(compact), &found));
+    ASSERT_EQ(1, found);
+    ASSERT_STR_EQ("alpha", semy_get_pre_release((semy_t *)&compact, 0));
+    ASSERT_EQ((int)SEMY_NO_ERROR, semy_registry_contains(&reader, "semy", (semy_t *)&compact, &found));
+    ASSERT_EQ(1, found);
+
+    // A version that doesn't fit the layout isn't found.
+    ASSERT_EQ((int)SEMY_NO_ERROR, semy_registry_add(&registry, "semy", "1.0.0-very-long-identifier"));
+    ASSERT_EQ((int)SEMY_NO_ERROR, semy_registry_publish(&registry));
+    ASSERT_EQ((int)SEMY_LIMITS_EXCEEDED, semy_registry_highest(&reader, "semy", NULL, NULL, (semy_t *)&compact, sizeof(compact), &found));
+    ASSERT_EQ(0, found);
+
+    // Bounds beyond the limits of 'semy_t' aren't supported.
+    char version[300] = "1.0.0-";
+    memset(&version[6], 'a', 250);
+    version[256] = '\0';
+    ASSERT_EQ((int)SEMY_NO_ERROR, semy_parse((semy_t *)extended, sizeof(extended), version));
+    ASSERT_EQ((int)SEMY_LIMITS_EXCEEDED, semy_registry_contains(&reader, "semy", (semy_t *)extended, &found));
+    ASSERT_EQ(0, found);
+    ASSERT_EQ((int)SEMY_LIMITS_EXCEEDED, semy_registry_highest(&reader, "semy", (semy_t *)extended, NULL, &semver, sizeof(semver), &found));
+    ASSERT_EQ((int)SEMY_LIMITS_EXCEEDED, semy_registry_highest(&reader, "semy", NULL, (semy_t *)extended, &semver, sizeof(semver), &found));
+    ASSERT_EQ(0, found);
+
+    semy_registry_detach(&reader);
+    semy_registry_free(&registry);
+}
+
+struct shared
+{
+    semy_registry_t registry;
+    atomic_bool done;
+    atomic_int failures;
+};
+
+// Queries the registry until the writer is done. Versions are only ever added, so the
+// highest version never decreases and every version seen is contained by later snapshots.
+static void *query(void *argument)
+{
+    struct shared *shared = (struct shared *)argument;
+    semy_registry_reader_t reader;
+    semy_t previous;
+    semy_t latest;
+    int32_t seen = 0;
+
+    if (semy_registry_attach(&shared->registry, &reader) != SEMY_NO_ERROR)
+    {
+        atomic_fetch_add(&shared->failures, 1);
+        return NULL;
+    }
+
+    while (!atomic_load(&shared->done))
+    {
+        int32_t found = 0;
+        int32_t result = 0;
+        semy_registry_highest(&reader, "semy", NULL, NULL, &latest, sizeof(latest), &found);
+        if (found == 1 && seen == 1 && semy_compare(&previous, &latest, &result) == SEMY_NO_ERROR && result > 0)
+        {
+            atomic_fetch_add(&shared->failures, 1);
+        }
+
+        if (seen == 1)
+        {
+            semy_registry_contains(&reader, "semy", &previous, &found);
+            if (found != 1)
+            {
+                atomic_fetch_add(&shared->failures, 1);
+            }
+        }
+
+        if (found == 1)
+        {
+            previous = latest;
+            seen = 1;
+        }
+    }
+
+    semy_registry_detach(&reader);
+    return NULL;
+}
+
+TEST(registry, concurrent_readers)
+{
+    static struct shared shared;
+    pthread_t threads[READER_THREADS];
+    char version[256];
+
+    ASSERT_EQ((int)SEMY_NO_ERROR, semy_registry_init(&shared.registry));
+    atomic_init(&shared.done, false);
+    atomic_init(&shared.failures, 0);
+
+    for (int i = 0; i < READER_THREADS; i++)
+    {
+        ASSERT_EQ(0, pthread_create(&threads[i], NULL, query, &shared));
+    }
+
+    for (int i = 0; i < PUBLISHED_BATCHES; i++)
+    {
+        for (int j = 0; j < 5; j++)
+        {
+            char release[32];
+            sprintf(release, "%d.%d.0", i, j);
+            ASSERT_EQ((int)SEMY_NO_ERROR, semy_registry_add(&shared.registry, "semy", release));
+            ASSERT_EQ((int)SEMY_NO_ERROR, semy_registry_add(&shared.registry, (j % 2) ? "left-pad" : "right-pad", release));
+        }
+        ASSERT_EQ((int)SEMY_NO_ERROR, semy_registry_publish(&shared.registry));
+    }
+
+    atomic_store(&shared.done, true);
+    for (int i = 0; i < READER_THREADS; i++)
+    {
+        ASSERT_EQ(0, pthread_join(threads[i], NULL));
+    }
+    ASSERT_EQ(0, atomic_load(&shared.failures));
+
+    semy_registry_reader_t reader;
+    ASSERT_EQ((int)SEMY_NO_ERROR, semy_registry_attach(&shared.registry, &reader));
+    highest(&reader, "semy", NULL, NULL, version);
+    sprintf(&version[128], "%d.4.0", PUBLISHED_BATCHES - 1);
+    ASSERT_STR_EQ(&version[128], version);
+    semy_registry_detach(&reader);
+    semy_registry_free(&shared.registry);
+}
+
+TEST(registry, invalid_versions)
+{
+    semy_registry_t registry;
+    semy_registry_reader_t reader;
+
+    // Nothing is staged for a malformed version.
+    ASSERT_EQ((int)SEMY_NO_ERROR, semy_registry_init(&registry));
+    ASSERT_EQ((int)SEMY_NO_ERROR, semy_registry_attach(&registry, &reader));
+    ASSERT_EQ((int)SEMY_BAD_SYNTAX, semy_registry_add(&registry, "semy", "1.0"));
+    ASSERT_EQ((int)SEMY_LIMITS_EXCEEDED, semy_registry_add(&registry, "semy", "2147483648.0.0"));
+    ASSERT_EQ((int)SEMY_NO_ERROR, semy_registry_publish(&registry));
+    ASSERT_FALSE(contains(&reader, "semy", "1.0.0"));
+
+    semy_registry_detach(&reader);
+    semy_registry_free(&registry);
+}
+
+TEST(registry, illegal_arguments)
+{
+    semy_registry_t registry;
+    semy_registry_t uninitialized;
+    semy_registry_reader_t reader;
+    semy_registry_reader_t detached;
+    semy_t semver;
+    int32_t found;
+
+    memset(&uninitialized, 0, sizeof(uninitialized));
+    memset(&detached, 0, sizeof(detached));
+    ASSERT_EQ((int)SEMY_NO_ERROR, semy_parse(&semver, sizeof(semver), "1.0.0"));
+
+    ASSERT_EQ((int)SEMY_INVALID_OPERATION, semy_registry_init(NULL));
+    ASSERT_EQ((int)SEMY_NO_ERROR, semy_registry_init(&registry));
+
+    ASSERT_EQ((int)SEMY_INVALID_OPERATION, semy_registry_add(NULL, "semy", "1.0.0"));
+    ASSERT_EQ((int)SEMY_INVALID_OPERATION, semy_registry_add(&registry, NULL, "1.0.0"));
+    ASSERT_EQ((int)SEMY_INVALID_OPERATION, semy_registry_add(&registry, "", "1.0.0"));
+    ASSERT_EQ((int)SEMY_INVALID_OPERATION, semy_registry_add(&registry, "semy", NULL));
+    ASSERT_EQ((int)SEMY_INVALID_OPERATION, semy_registry_add(&uninitialized, "semy", "1.0.0"));
+
+    ASSERT_EQ((int)SEMY_INVALID_OPERATION, semy_registry_publish(NULL));
+    ASSERT_EQ((int)SEMY_INVALID_OPERATION, semy_registry_publish(&uninitialized));
+
+    ASSERT_EQ((int)SEMY_INVALID_OPERATION, semy_registry_attach(NULL, &reader));
+    ASSERT_EQ((int)SEMY_INVALID_OPERATION, semy_registry_attach(&registry, NULL));
+    ASSERT_EQ((int)SEMY_INVALID_OPERATION, semy_registry_attach(&uninitialized, &reader));
+    ASSERT_EQ((int)SEMY_NO_ERROR, semy_registry_attach(&registry, &reader));
+
+    ASSERT_EQ((int)SEMY_INVALID_OPERATION, semy_registry_pin(NULL));
+    ASSERT_EQ((int)SEMY_INVALID_OPERATION, semy_registry_pin(&detached));
+    ASSERT_EQ((int)SEMY_INVALID_OPERATION, semy_registry_unpin(NULL));
+    ASSERT_EQ((int)SEMY_INVALID_OPERATION, semy_registry_unpin(&detached));
+
+    ASSERT_EQ((int)SEMY_INVALID_OPERATION, semy_registry_contains(NULL, "semy", &semver, &found));
+    ASSERT_EQ((int)SEMY_INVALID_OPERATION, semy_registry_contains(&reader, NULL, &semver, &found));
+    ASSERT_EQ((int)SEMY_INVALID_OPERATION, semy_registry_contains(&reader, "semy", NULL, &found));
+    ASSERT_EQ((int)SEMY_INVALID_OPERATION, semy_registry_contains(&reader, "semy", &semver, NULL));
+    ASSERT_EQ((int)SEMY_INVALID_OPERATION, semy_registry_contains(&detached, "semy", &semver, &found));
+
+    ASSERT_EQ((int)SEMY_INVALID_OPERATION, semy_registry_highest(NULL, "semy", NULL, NULL, &semver, sizeof(semver), &found));
+    ASSERT_EQ((int)SEMY_INVALID_OPERATION, semy_registry_highest(&reader, NULL, NULL, NULL, &semver, sizeof(semver), &found));
+    ASSERT_EQ((int)SEMY_INVALID_OPERATION, semy_registry_highest(&reader, "semy", NULL, NULL, NULL, sizeof(semver), &found));
+    ASSERT_EQ((int)SEMY_INVALID_OPERATION, semy_registry_highest(&reader, "semy", NULL, NULL, &semver, sizeof(semver), NULL));
+    ASSERT_EQ((int)SEMY_INVALID_OPERATION, semy_registry_highest(&reader, "semy", NULL, NULL, &semver, 7, &found));
+    ASSERT_EQ((int)SEMY_INVALID_OPERATION, semy_registry_highest(&detached, "semy", NULL, NULL, &semver, sizeof(semver), &found));
+
+    semy_registry_detach(NULL);
+    semy_registry_detach(&detached);
+    semy_registry_detach(&reader);
+    semy_registry_free(NULL);
+    semy_registry_free(&uninitialized);
+    semy_registry_free(&registry);
+}
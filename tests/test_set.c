@@ -0,0 +1,331 @@
+// SPDX-License-Identifier: MIT
+/*
+ * Semy - a Semantic Versioning 2.0.0 processor.
+ * See https://semver.org/.
+ *
+ * Copyright (c) 2025-2026 Henry G. Stratmann III
+ * Copyright (c) 2025-2026 Semy Contributors
+ *
+ * This file is part of Semy, distributed under the MIT License.
+ * For full terms see the included LICENSE file.
+ */
+
+#include "semy.h"
+#include "test_utils.h"
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define RANDOM_VERSIONS 5000
+
+// Versions in ascending order, including versions equal in precedence.
+static const char *sorted[] = {
+    "0.9.10",
+    "0.10.9",
+    "1.0.0-0",
+    "1.0.0-alpha",
+    "1.0.0-alpha.1",
+    "1.0.0-alpha.beta",
+    "1.0.0-alphabet",
+    "1.0.0-beta",
+    "1.0.0-beta.2",
+    "1.0.0-beta.11",
+    "1.0.0-rc.1",
+    "1.0.0-x.7.z.92+exp.sha.5114f85.20130313144700",
+    "1.0.0",
+    "1.0.0+build.1",
+    "1.0.0+build.2",
+    "2.0.0",
+    "2147483647.2147483647.2147483647",
+};
+
+// Orders versions as the set does: by precedence and then by build metadata.
+static int compare_members(const void *a, const void *b)
+{
+    const char *x = *(const char *const *)a;
+    const char *y = *(const char *const *)b;
+    semy_t sx;
+    semy_t sy;
+    int32_t result = 0;
+
+    semy_parse(&sx, sizeof(sx), x);
+    semy_parse(&sy, sizeof(sy), y);
+    semy_compare(&sx, &sy, &result);
+    return (result != 0) ? result : strcmp(x, y);
+}
+
+// Verifies the set has exactly the 'count' sorted versions, iterating in both directions.
+static void check_members(const semy_set_t *set, const char *const *versions, size_t count)
+{
+    const char *member = NULL;
+    ASSERT_EQ(count, semy_set_count(set));
+
+    for (size_t i = 0; i < count; i++)
+    {
+        ASSERT_EQ((int)SEMY_NO_ERROR, semy_set_successor(set, member, &member));
+        ASSERT_NONNULL(member);
+        ASSERT_STR_EQ(versions[i], member);
+    }
+    ASSERT_EQ((int)SEMY_NO_ERROR, semy_set_successor(set, member, &member));
+    ASSERT_NULL(member);
+
+    for (size_t i = count; i > 0; i--)
+    {
+        ASSERT_EQ((int)SEMY_NO_ERROR, semy_set_predecessor(set, member, &member));
+        ASSERT_NONNULL(member);
+        ASSERT_STR_EQ(versions[i - 1], member);
+    }
+    ASSERT_EQ((int)SEMY_NO_ERROR, semy_set_predecessor(set, member, &member));
+    ASSERT_NULL(member);
+}
+
+static uint64_t next_random(uint64_t *state)
+{
+    // xorshift64
+    uint64_t x = *state;
+    x ^= x << 13;
+    x ^= x >> 7;
+    x ^= x << 17;
+    *state = x;
+    return x;
+}
+
+static void random_version(uint64_t *state, char *version)
+{
+    static const char *const pre_releases[] = {"", "-alpha", "-alpha.1", "-beta", "-rc.1", "-rc.2", "-0"};
+    static const char *const builds[] = {"", "", "+a", "+b", "+build.1"};
+
+    const uint64_t r = next_random(state);
+    sprintf(version, "%d.%d.%d%s%s", (int)(r % 4), (int)((r >> 8) % 10), (int)((r >> 16) % 30),
+            pre_releases[(r >> 24) % COUNT_OF(pre_releases)], builds[(r >> 32) % COUNT_OF(builds)]);
+}
+
+TEST(set, sorted)
+{
+    semy_set_t set;
+    int32_t inserted = -1;
+    ASSERT_EQ((int)SEMY_NO_ERROR, semy_set_init(&set));
+    check_members(&set, NULL, 0);
+
+    // Insert the versions in a scrambled order.
+    for (size_t i = 0; i < COUNT_OF(sorted); i++)
+    {
+        const size_t position = (i * 7) % COUNT_OF(sorted);
+        ASSERT_EQ((int)SEMY_NO_ERROR, semy_set_insert(&set, sorted[position], &inserted));
+        ASSERT_EQ(1, inserted);
+    }
+    check_members(&set, sorted, COUNT_OF(sorted));
+
+    // Identical versions are inserted once.
+    ASSERT_EQ((int)SEMY_NO_ERROR, semy_set_insert(&set, "1.0.0+build.1", &inserted));
+    ASSERT_EQ(0, inserted);
+    ASSERT_EQ((int)SEMY_NO_ERROR, semy_set_insert(&set, "1.0.0", NULL));
+    ASSERT_EQ(COUNT_OF(sorted), semy_set_count(&set));
+
+    semy_set_free(&set);
+    ASSERT_EQ(0, semy_set_count(&set));
+}
+
+TEST(set, find)
+{
+    semy_set_t set;
+    const char *member = NULL;
+    ASSERT_EQ((int)SEMY_NO_ERROR, semy_set_init(&set));
+    ASSERT_EQ((int)SEMY_NO_ERROR, semy_set_find(&set, "1.0.0", &member));
+    ASSERT_NULL(member);
+
+    for (size_t i = 0; i < COUNT_OF(sorted); i++)
+    {
+        ASSERT_EQ((int)SEMY_NO_ERROR, semy_set_insert(&set, sorted[i], NULL));
+    }
+
+    // The first member equal in precedence is found regardless of build metadata.
+    ASSERT_EQ((int)SEMY_NO_ERROR, semy_set_find(&set, "1.0.0+build.2", &member));
+    ASSERT_STR_EQ("1.0.0", member);
+    ASSERT_EQ((int)SEMY_NO_ERROR, semy_set_find(&set, "1.0.0-x.7.z.92", &member));
+    ASSERT_STR_EQ("1.0.0-x.7.z.92+exp.sha.5114f85.20130313144700", member);
+    ASSERT_EQ((int)SEMY_NO_ERROR, semy_set_find(&set, "0.10.9", &member));
+    ASSERT_STR_EQ("0.10.9", member);
+
+    // Versions without a member equal in precedence aren't found.
+    ASSERT_EQ((int)SEMY_NO_ERROR, semy_set_find(&set, "1.0.0-alph", &member));
+    ASSERT_NULL(member);
+    ASSERT_EQ((int)SEMY_NO_ERROR, semy_set_find(&set, "1.0.0-beta.3", &member));
+    ASSERT_NULL(member);
+    ASSERT_EQ((int)SEMY_NO_ERROR, semy_set_find(&set, "3.0.0", &member));
+    ASSERT_NULL(member);
+
+    // Neighbors of versions that aren't members.
+    ASSERT_EQ((int)SEMY_NO_ERROR, semy_set_successor(&set, "1.0.0-beta.3", &member));
+    ASSERT_STR_EQ("1.0.0-beta.11", member);
+    ASSERT_EQ((int)SEMY_NO_ERROR, semy_set_predecessor(&set, "1.0.0-beta.3", &member));
+    ASSERT_STR_EQ("1.0.0-beta.2", member);
+    ASSERT_EQ((int)SEMY_NO_ERROR, semy_set_successor(&set, "1.0.0+build", &member));
+    ASSERT_STR_EQ("1.0.0+build.1", member);
+    ASSERT_EQ((int)SEMY_NO_ERROR, semy_set_predecessor(&set, "0.0.1", &member));
+    ASSERT_NULL(member);
+    ASSERT_EQ((int)SEMY_NO_ERROR, semy_set_successor(&set, "2147483647.2147483647.2147483647+z", &member));
+    ASSERT_NULL(member);
+
+    semy_set_free(&set);
+}
+
+TEST(set, erase)
+{
+    semy_set_t set;
+    int32_t erased = -1;
+    ASSERT_EQ((int)SEMY_NO_ERROR, semy_set_init(&set));
+    ASSERT_EQ((int)SEMY_NO_ERROR, semy_set_erase(&set, "1.0.0", &erased));
+    ASSERT_EQ(0, erased);
+
+    for (size_t i = 0; i < COUNT_OF(sorted); i++)
+    {
+        ASSERT_EQ((int)SEMY_NO_ERROR, semy_set_insert(&set, sorted[i], NULL));
+    }
+
+    // Only the identical member is erased.
+    ASSERT_EQ((int)SEMY_NO_ERROR, semy_set_erase(&set, "1.0.0+build.3", &erased));
+    ASSERT_EQ(0, erased);
+    ASSERT_EQ((int)SEMY_NO_ERROR, semy_set_erase(&set, "1.0.0+build.1", &erased));
+    ASSERT_EQ(1, erased);
+    ASSERT_EQ((int)SEMY_NO_ERROR, semy_set_erase(&set, "1.0.0+build.1", NULL));
+    ASSERT_EQ(COUNT_OF(sorted) - 1, semy_set_count(&set));
+
+    for (size_t i = 0; i < COUNT_OF(sorted); i++)
+    {
+        ASSERT_EQ((int)SEMY_NO_ERROR, semy_set_erase(&set, sorted[i], NULL));
+    }
+    check_members(&set, NULL, 0);
+
+    // The set is usable after it's emptied.
+    ASSERT_EQ((int)SEMY_NO_ERROR, semy_set_insert(&set, "1.0.0", NULL));
+    check_members(&set, (const char *[]){"1.0.0"}, 1);
+    semy_set_free(&set);
+}
+
+// Inserts and erases random versions, including many equal in precedence, so the tree grows
+// several levels and its nodes split, borrow, and merge, checking it against a sorted array.
+TEST(set, agrees_with_compare, .iterations=3)
+{
+    static char versions[RANDOM_VERSIONS][64];
+    static const char *expected[RANDOM_VERSIONS];
+    static bool present[RANDOM_VERSIONS];
+    static bool removed[RANDOM_VERSIONS];
+    uint64_t state = 0x9E3779B97F4A7C15 + (uint64_t)TEST_ITERATION;
+    semy_set_t set;
+
+    ASSERT_EQ((int)SEMY_NO_ERROR, semy_set_init(&set));
+    memset(present, 0, sizeof(present));
+    memset(removed, 0, sizeof(removed));
+
+    for (size_t i = 0; i < RANDOM_VERSIONS; i++)
+    {
+        int32_t inserted = -1;
+        random_version(&state, versions[i]);
+        ASSERT_EQ((int)SEMY_NO_ERROR, semy_set_insert(&set, versions[i], &inserted));
+        present[i] = (inserted == 1);
+    }
+
+    // Erase most of the versions in a random order, checking the set along the way.
+    for (int round = 0; round < 4; round++)
+    {
+        size_t count = 0;
+        for (size_t i = 0; i < RANDOM_VERSIONS; i++)
+        {
+            if (present[i])
+            {
+                expected[count++] = versions[i];
+            }
+        }
+        qsort(expected, count, sizeof(expected[0]), compare_members);
+        check_members(&set, expected, count);
+
+        for (size_t i = 0; i < RANDOM_VERSIONS; i++)
+        {
+            if (present[i] && (next_random(&state) % 2) == 0)
+            {
+                int32_t erased = -1;
+                ASSERT_EQ((int)SEMY_NO_ERROR, semy_set_erase(&set, versions[i], &erased));
+                ASSERT_EQ(1, erased);
+                present[i] = false;
+                removed[i] = true;
+            }
+            else if (removed[i])
+            {
+                int32_t erased = -1;
+                ASSERT_EQ((int)SEMY_NO_ERROR, semy_set_erase(&set, versions[i], &erased));
+                ASSERT_EQ(0, erased);
+            }
+        }
+    }
+
+    // The last iteration frees the set while it's still several levels deep.
+    if (TEST_ITERATION == 2)
+    {
+        semy_set_free(&set);
+        return;
+    }
+
+    // Erasing in ascending and descending order drains the tree from either side.
+    size_t count = 0;
+    for (size_t i = 0; i < RANDOM_VERSIONS; i++)
+    {
+        if (present[i])
+        {
+            expected[count++] = versions[i];
+        }
+    }
+    qsort(expected, count, sizeof(expected[0]), compare_members);
+    for (size_t i = 0; i < count; i++)
+    {
+        const size_t position = (TEST_ITERATION == 0) ? i : count - i - 1;
+        ASSERT_EQ((int)SEMY_NO_ERROR, semy_set_erase(&set, expected[position], NULL));
+    }
+    check_members(&set, NULL, 0);
+    semy_set_free(&set);
+}
+
+TEST(set, invalid_versions)
+{
+    semy_set_t set;
+    const char *member = "unchanged";
+    ASSERT_EQ((int)SEMY_NO_ERROR, semy_set_init(&set));
+
+    ASSERT_EQ((int)SEMY_BAD_SYNTAX, semy_set_insert(&set, "1.0", NULL));
+    ASSERT_EQ((int)SEMY_LIMITS_EXCEEDED, semy_set_insert(&set, "2147483648.0.0", NULL));
+    ASSERT_EQ(0, semy_set_count(&set));
+    ASSERT_EQ((int)SEMY_BAD_SYNTAX, semy_set_erase(&set, "1.0", NULL));
+    ASSERT_EQ((int)SEMY_BAD_SYNTAX, semy_set_find(&set, "1.0", &member));
+    ASSERT_NULL(member);
+    ASSERT_EQ((int)SEMY_BAD_SYNTAX, semy_set_predecessor(&set, "1.0", &member));
+    ASSERT_EQ((int)SEMY_BAD_SYNTAX, semy_set_successor(&set, "1.0", &member));
+
+    semy_set_free(&set);
+}
+
+TEST(set, illegal_arguments)
+{
+    semy_set_t set;
+    const char *member;
+
+    ASSERT_EQ((int)SEMY_INVALID_OPERATION, semy_set_init(NULL));
+    ASSERT_EQ((int)SEMY_NO_ERROR, semy_set_init(&set));
+
+    ASSERT_EQ((int)SEMY_INVALID_OPERATION, semy_set_insert(NULL, "1.0.0", NULL));
+    ASSERT_EQ((int)SEMY_INVALID_OPERATION, semy_set_insert(&set, NULL, NULL));
+    ASSERT_EQ((int)SEMY_INVALID_OPERATION, semy_set_erase(NULL, "1.0.0", NULL));
+    ASSERT_EQ((int)SEMY_INVALID_OPERATION, semy_set_erase(&set, NULL, NULL));
+    ASSERT_EQ(0, semy_set_count(NULL));
+
+    ASSERT_EQ((int)SEMY_INVALID_OPERATION, semy_set_find(NULL, "1.0.0", &member));
+    ASSERT_EQ((int)SEMY_INVALID_OPERATION, semy_set_find(&set, NULL, &member));
+    ASSERT_EQ((int)SEMY_INVALID_OPERATION, semy_set_find(&set, "1.0.0", NULL));
+    ASSERT_EQ((int)SEMY_INVALID_OPERATION, semy_set_predecessor(NULL, "1.0.0", &member));
+    ASSERT_EQ((int)SEMY_INVALID_OPERATION, semy_set_predecessor(&set, "1.0.0", NULL));
+    ASSERT_EQ((int)SEMY_INVALID_OPERATION, semy_set_successor(NULL, "1.0.0", &member));
+    ASSERT_EQ((int)SEMY_INVALID_OPERATION, semy_set_successor(&set, "1.0.0", NULL));
+
+    semy_set_free(NULL);
+    semy_set_free(&set);
+}
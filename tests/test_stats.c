@@ -0,0 +1,120 @@
+// SPDX-License-Identifier: MIT
+/*
+ * Semy - a Semantic Versioning 2.0.0 processor.
+ * See https://semver.org/.
+ *
+ * Copyright (c) 2025-2026 Henry G. Stratmann III
+ * Copyright (c) 2025-2026 Semy Contributors
+ *
+ * This file is part of Semy, distributed under the MIT License.
+ * For full terms see the included LICENSE file.
+ */
+
+#include "semy.h"
+#include "test_utils.h"
+#include <string.h>
+
+#if defined(SEMY_STATS)
+
+TEST(stats, parse)
+{
+    semy_t semver;
+    semy_compact32_t compact;
+    semy_stats_t stats;
+    semy_stats_reset();
+
+    ASSERT_EQ(semy_parse(&semver, sizeof(semver), "1.0.0-alpha"), SEMY_NO_ERROR);
+    ASSERT_EQ(semy_parse((semy_t *)&compact, sizeof(compact), "2.0.0"), SEMY_NO_ERROR);
+    ASSERT_EQ(semy_parse(&semver, sizeof(semver), "1.0"), SEMY_BAD_SYNTAX);
+    ASSERT_EQ(semy_parse(&semver, sizeof(semver), "1.0.99999999999"), SEMY_LIMITS_EXCEEDED);
+    ASSERT_EQ(semy_parse(&semver, sizeof(semver), NULL), SEMY_INVALID_OPERATION);
+
+    ASSERT_EQ(semy_stats_get(&stats), SEMY_NO_ERROR);
+    ASSERT_EQ(stats.parses, 5);
+    ASSERT_EQ(stats.parse_results[SEMY_NO_ERROR], 2);
+    ASSERT_EQ(stats.parse_results[SEMY_INVALID_OPERATION], 1);
+    ASSERT_EQ(stats.parse_results[SEMY_BAD_SYNTAX], 1);
+    ASSERT_EQ(stats.parse_results[SEMY_LIMITS_EXCEEDED], 1);
+    ASSERT_EQ(stats.parse_results[SEMY_OUT_OF_MEMORY], 0);
+
+    // Malformed versions count the bytes read up to the error: all of "1.0" and "1.0." of the other.
+    ASSERT_EQ(stats.parsed_bytes, strlen("1.0.0-alpha") + strlen("2.0.0") + strlen("1.0") + strlen("1.0."));
+}
+
+TEST(stats, compare)
+{
+    static const struct
+    {
+        const char *v1;
+        const char *v2;
+    } test_cases[] = {
+        {"1.0.0", "2.0.0"},
+        {"1.2.3", "1.2.4"},
+        {"1.0.0-alpha", "1.0.0-beta"},
+        {"1.0.0-alpha", "1.0.0"},
+        {"1.0.0+build", "1.0.0"},
+    };
+
+    semy_t v1, v2;
+    semy_compact64_t compact;
+    semy_stats_t stats;
+    semy_stats_reset();
+
+    for (size_t i = 0; i < COUNT_OF(test_cases); i++)
+    {
+        int32_t result = 0;
+        ASSERT_EQ(semy_parse(&v1, sizeof(v1), test_cases[i].v1), SEMY_NO_ERROR);
+        ASSERT_EQ(semy_parse(&v2, sizeof(v2), test_cases[i].v2), SEMY_NO_ERROR);
+        ASSERT_EQ(semy_compare(&v1, &v2, &result), SEMY_NO_ERROR);
+    }
+
+    // Compact layouts are counted the same way.
+    int32_t result = 0;
+    ASSERT_EQ(semy_parse((semy_t *)&compact, sizeof(compact), "1.0.0-alpha"), SEMY_NO_ERROR);
+    ASSERT_EQ(semy_compare((const semy_t *)&compact, &v2, &result), SEMY_NO_ERROR);
+    ASSERT_EQ(semy_compare(&v1, &v2, NULL), SEMY_INVALID_OPERATION);
+
+    ASSERT_EQ(semy_stats_get(&stats), SEMY_NO_ERROR);
+    ASSERT_EQ(stats.parses, 11);
+    ASSERT_EQ(stats.compares, 6);
+    ASSERT_EQ(stats.core_decided, 2);
+    ASSERT_EQ(stats.pre_release_decided, 3);
+}
+
+TEST(stats, reset)
+{
+    semy_t semver;
+    semy_stats_t stats;
+    ASSERT_EQ(semy_parse(&semver, sizeof(semver), "1.0.0"), SEMY_NO_ERROR);
+    semy_stats_reset();
+
+    ASSERT_EQ(semy_stats_get(&stats), SEMY_NO_ERROR);
+    ASSERT_EQ(stats.parses, 0);
+    ASSERT_EQ(stats.parse_results[SEMY_NO_ERROR], 0);
+    ASSERT_EQ(stats.parsed_bytes, 0);
+    ASSERT_EQ(stats.compares, 0);
+}
+
+#else
+
+TEST(stats, disabled)
+{
+    semy_t semver;
+    semy_stats_t stats;
+    memset(&stats, 0xFF, sizeof(stats));
+    ASSERT_EQ(semy_parse(&semver, sizeof(semver), "1.0.0"), SEMY_NO_ERROR);
+    semy_stats_reset();
+
+    // Without statistics nothing is counted.
+    ASSERT_EQ(semy_stats_get(&stats), SEMY_INVALID_OPERATION);
+    ASSERT_EQ(stats.parses, 0);
+    ASSERT_EQ(stats.parsed_bytes, 0);
+    ASSERT_EQ(stats.compares, 0);
+}
+
+#endif
+
+TEST(stats, illegal_arguments)
+{
+    ASSERT_EQ(semy_stats_get(NULL), SEMY_INVALID_OPERATION);
+}
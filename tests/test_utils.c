@@ -0,0 +1,33 @@
+// SPDX-License-Identifier: MIT
+/*
+ * Semy - a Semantic Versioning 2.0.0 processor.
+ * See https://semver.org/.
+ *
+ * Copyright (c) 2025-2026 Henry G. Stratmann III
+ * Copyright (c) 2025-2026 Semy Contributors
+ *
+ * This file is part of Semy, distributed under the MIT License.
+ * For full terms see the included LICENSE file.
+ */
+
+#include "semy.h"
+#include "test_utils.h"
+#include <stdio.h>
+#include <string.h>
+
+void format_version(const semy_t *semver, char *output)
+{
+    sprintf(output, "%d.%d.%d", semy_get_major(semver), semy_get_minor(semver), semy_get_patch(semver));
+
+    for (int32_t i = 0; i < semy_get_pre_release_count(semver); i++)
+    {
+        strcat(output, (i == 0) ? "-" : ".");
+        strcat(output, semy_get_pre_release(semver, i));
+    }
+
+    for (int32_t i = 0; i < semy_get_build_count(semver); i++)
+    {
+        strcat(output, (i == 0) ? "+" : ".");
+        strcat(output, semy_get_build(semver, i));
+    }
+}
@@ -10,7 +10,9 @@
  * For full terms see the included LICENSE file.
  */
 
+#include "semy.h"
 #include <audition.h>
+#include <stddef.h>
 
 #define COUNT_OF(ARRAY) (sizeof(ARRAY)/sizeof((ARRAY)[0]))
 
@@ -20,6 +22,20 @@ struct CommandLineTestCase
     int exit_code;
     const char *out;
     const char *err;
+    const char *in; // Content of stdin (optional).
 };
 
 void run_cli_test(const struct CommandLineTestCase *test_case);
+
+// Writes 'content', a null-terminated string, to the file at 'path', replacing the file.
+void write_file(const char *path, const char *content);
+
+// Writes the first 'size' bytes of 'content' to the file at 'path', replacing the file.
+void write_binary_file(const char *path, const void *content, size_t size);
+
+// Runs the command-line interface and returns its exit code along with its
+// output, which unlike run_cli_test() may contain binary data.
+int run_cli_capture(const struct CommandLineTestCase *test_case, const char **out, size_t *length);
+
+// Formats the parsed version from its components which should reproduce the original string.
+void format_version(const semy_t *semver, char *output);